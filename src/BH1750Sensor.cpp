@@ -0,0 +1,26 @@
+#include "BH1750Sensor.h"
+
+#ifdef SENSORS_INCLUDE_BH1750
+
+// ===========  BH1750Sensor  ==================
+
+bool BH1750Sensor::init() {
+  status = lightMeter.begin(BH1750::CONTINUOUS_HIGH_RES_MODE, 0x23, bus);
+  if(!status) {
+    setError(ErrorInit);
+  }
+  return status;
+}
+
+bool BH1750Sensor::readValues() {
+  lightIntensity = lightMeter.readLightLevel();;
+  status = false;
+  if(lightIntensity < 0) {
+    setError(ErrorRead);
+    return false;
+  }
+  status = true;
+  return true;
+}
+
+#endif //SENSORS_INCLUDE_BH1750
@@ -0,0 +1,21 @@
+#ifndef BH1750_SENSOR_H
+#define BH1750_SENSOR_H
+
+#include "SensorBase.h"
+
+#ifdef SENSORS_INCLUDE_BH1750
+#include <Wire.h>
+#include <BH1750.h>
+
+class BH1750Sensor : public IlluminationSensor {
+  public:
+    BH1750 lightMeter;
+  public:
+    BH1750Sensor(TwoWire &wire = Wire):IlluminationSensor("BH1750") { bus = &wire; };
+    virtual bool init() override;
+    virtual bool readValues() override;
+};
+
+#endif //SENSORS_INCLUDE_BH1750
+
+#endif //BH1750_SENSOR_H
@@ -0,0 +1,89 @@
+#include "BME280Sensor.h"
+
+#ifdef SENSORS_INCLUDE_BME280
+
+// ===========  BME280Sensor  ==================
+
+bool BME280Sensor::init() {
+  status = bme.begin(address, bus);
+  if(!status) {
+    setError(ErrorInit);
+  } else {
+    conversionTime = getProfileConversionTime(profile);
+    if(profile == ProfilePrecise) {
+      //indoor navigation oversampling and filter (BME datasheet, ch3.5) in forced mode
+      bme.setSampling(Adafruit_BME280::MODE_FORCED,
+                      Adafruit_BME280::SAMPLING_X2, // temperature
+                      Adafruit_BME280::SAMPLING_X16, // pressure
+                      Adafruit_BME280::SAMPLING_X1, // humidity
+                      Adafruit_BME280::FILTER_X16);
+    } else {
+      //set weather station mode (BME datasheet, ch3.5)
+      bme.setSampling(Adafruit_BME280::MODE_FORCED,
+                      Adafruit_BME280::SAMPLING_X1, // temperature
+                      Adafruit_BME280::SAMPLING_X1, // pressure
+                      Adafruit_BME280::SAMPLING_X1, // humidity
+                      Adafruit_BME280::FILTER_OFF);
+    }
+  }
+  return status;
+}
+
+// Max conversion times of the oversampling settings (BME280 datasheet, ch9.1). Forced mode is always single shot
+uint32_t BME280Sensor::getProfileConversionTime(SensorProfile profile) {
+  return profile == ProfilePrecise?47:10;
+}
+
+bool BME280Sensor::readValues() {
+  bme.takeForcedMeasurement();
+  return finishMeasurement();
+}
+
+bool BME280Sensor::startMeasurement() {
+  bme.triggerForcedMeasurement();
+  conversionStart = sensorsMillis();
+  return true;
+}
+
+bool BME280Sensor::measurementReady() {
+  return sensorsMillis()-conversionStart >= conversionTime && !bme.isMeasuring();
+}
+
+bool BME280Sensor::finishMeasurement() {
+  temp = bme.readTemperature();
+  setError(ErrorNone);
+  status = false;
+  if(isnan(temp)) {
+    setError(ErrorTemperature);
+    return false;
+  }
+  hum = bme.readHumidity();
+  if(isnan(hum)) {
+    setError(ErrorHumidity);
+    return false;
+  }
+  pressRaw = bme.readPressure();
+  if(isnan(pressRaw)) {
+    setError(ErrorPressure);
+    return false;
+  } else {
+    pressSeaLevel = bme.seaLevelForAltitude(altitude, pressRaw)/100.0;
+    pressRaw /= 100.0;
+  }
+  status = true;
+  return status;
+}
+
+static constexpr FieldDescriptor BME280Fields[] PROGMEM = {
+  temperatureField(),
+  humidityField(),
+  pressureField<BME280Sensor>(),
+  rawPressureField<BME280Sensor>()
+};
+
+const FieldDescriptor *BME280Sensor::getFields(uint8_t &count) {
+  count = SENSOR_FIELDS_COUNT(BME280Fields);
+  return BME280Fields;
+}
+
+#endif //SENSORS_INCLUDE_BME280
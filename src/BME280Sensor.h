@@ -0,0 +1,38 @@
+#ifndef BME280_SENSOR_H
+#define BME280_SENSOR_H
+
+#include "SensorBase.h"
+
+#ifdef SENSORS_INCLUDE_BME280
+#include <Wire.h>
+#include <Adafruit_BME280.h>
+
+// Exposes forced measurement trigger and status, which Adafruit_BME280 handles only in blocking takeForcedMeasurement()
+class BME280Device : public Adafruit_BME280 {
+  public:
+    void triggerForcedMeasurement() { write8(BME280_REGISTER_CONTROL, _measReg.get()); }
+    bool isMeasuring() { return read8(BME280_REGISTER_STATUS) & 0x08; }
+};
+
+class BME280Sensor : public TemperatureHumiditySensor, public PressureSensor {
+  protected:
+    uint8_t address;
+    BME280Device bme;
+    uint32_t conversionStart = 0;
+    uint8_t conversionTime = 10;
+  public:
+    BME280Sensor(float altitude, uint8_t address = BME280_ADDRESS_ALTERNATE, TwoWire &wire = Wire):
+      TemperatureHumiditySensor("BME280"),PressureSensor(altitude),address(address) { bus = &wire; }
+    virtual bool init() override;
+    virtual bool readValues() override;
+    virtual bool startMeasurement() override;
+    virtual bool measurementReady() override;
+    virtual bool finishMeasurement() override;
+    virtual const FieldDescriptor *getFields(uint8_t &count) override;
+    virtual bool supportsProfile(SensorProfile) override { return true; }
+    virtual uint32_t getProfileConversionTime(SensorProfile profile) override;
+};
+
+#endif //SENSORS_INCLUDE_BME280
+
+#endif //BME280_SENSOR_H
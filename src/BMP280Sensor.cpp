@@ -0,0 +1,46 @@
+#include "BMP280Sensor.h"
+
+#ifdef SENSORS_INCLUDE_BMP280
+
+// ===========  BMP280Sensor  ==================
+
+bool BMP280Sensor::init() {
+  status = bmp.begin(BMP280_ADDRESS_ALT);
+  if(!status) {
+    setError(ErrorInit);
+  }
+  return status;
+}
+
+bool BMP280Sensor::readValues() {
+  temp = bmp.readTemperature();
+  setError(ErrorNone);
+  status = false;
+  if(isnan(temp)) {
+    setError(ErrorTemperature);
+    return false;
+  }
+  pressRaw = bmp.readPressure();
+  if(isnan(pressRaw)) {
+    setError(ErrorPressure);
+    return false;
+  } else {
+    pressSeaLevel = bmp.seaLevelForAltitude(altitude, pressRaw)/100.0;
+    pressRaw /= 100.0;
+  }
+  status = true;
+  return true;
+}
+
+static constexpr FieldDescriptor BMP280Fields[] PROGMEM = {
+  temperatureField(),
+  pressureField<BMP280Sensor>(),
+  rawPressureField<BMP280Sensor>()
+};
+
+const FieldDescriptor *BMP280Sensor::getFields(uint8_t &count) {
+  count = SENSOR_FIELDS_COUNT(BMP280Fields);
+  return BMP280Fields;
+}
+
+#endif //SENSORS_INCLUDE_BMP280
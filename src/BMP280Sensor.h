@@ -0,0 +1,22 @@
+#ifndef BMP280_SENSOR_H
+#define BMP280_SENSOR_H
+
+#include "SensorBase.h"
+
+#ifdef SENSORS_INCLUDE_BMP280
+#include <Wire.h>
+#include <Adafruit_BMP280.h>
+
+class BMP280Sensor : public TemperatureSensor, public PressureSensor {
+  protected:
+    Adafruit_BMP280 bmp;
+  public:
+    BMP280Sensor(float altitude, TwoWire &wire = Wire):TemperatureSensor("BMP280"),PressureSensor(altitude),bmp(&wire) { bus = &wire; }
+    virtual bool init() override;
+    virtual bool readValues() override;
+    virtual const FieldDescriptor *getFields(uint8_t &count) override;
+};
+
+#endif //SENSORS_INCLUDE_BMP280
+
+#endif //BMP280_SENSOR_H
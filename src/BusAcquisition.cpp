@@ -0,0 +1,144 @@
+#include "BusAcquisition.h"
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#elif defined(SENSORS_BUS_THREADS)
+#include <thread>
+#endif
+
+#if defined(ESP32) || defined(SENSORS_BUS_THREADS)
+
+// Sensors of a bus, read by one task
+struct BusGroup {
+  Sensor **sensors;
+  uint32_t *finishTimes;
+  uint8_t count;
+  uint8_t ok;
+  uint32_t timeout;
+#if defined(ESP32)
+  TaskHandle_t caller;
+#endif
+  void read() { ok = Sensor::readAll(sensors, count, timeout, finishTimes); }
+};
+
+#if defined(ESP32)
+static void busTask(void *param) {
+  BusGroup *group = (BusGroup *)param;
+  group->read();
+  xTaskNotifyGive(group->caller);
+  vTaskDelete(nullptr);
+}
+#endif
+
+uint8_t readAllByBus(Sensor *sensors[], uint8_t count, uint32_t timeout, uint32_t *finishTimes) {
+  if(count > BUS_ACQUISITION_MAX_SENSORS) {
+    return Sensor::readAll(sensors, count, timeout, finishTimes);
+  }
+  // group 0 is read by the calling task, group i+1 by the task of buses[i]
+  TwoWire *buses[BUS_ACQUISITION_MAX_BUSES];
+  uint8_t busCount = 0;
+  uint8_t groupOf[BUS_ACQUISITION_MAX_SENSORS];
+  uint8_t sizes[BUS_ACQUISITION_MAX_BUSES + 1] = {0};
+  for(uint8_t i=0;i<count;i++) {
+    TwoWire *bus = sensors[i]->getBus();
+    uint8_t g = 0;
+    if(bus) {
+      uint8_t b = 0;
+      while(b<busCount && buses[b] != bus) {
+        b++;
+      }
+      if(b == busCount && busCount < BUS_ACQUISITION_MAX_BUSES) {
+        buses[busCount++] = bus;
+      }
+      if(b < busCount) {
+        g = b+1;
+      }
+    }
+    groupOf[i] = g;
+    sizes[g]++;
+  }
+  uint8_t groupsCount = 0;
+  for(uint8_t g=0;g<=busCount;g++) {
+    if(sizes[g]) {
+      groupsCount++;
+    }
+  }
+  if(groupsCount < 2) {
+    return Sensor::readAll(sensors, count, timeout, finishTimes);
+  }
+  // sensors ordered by groups, so each group gets a continuous part of the arrays
+  Sensor *ordered[BUS_ACQUISITION_MAX_SENSORS];
+  uint32_t times[BUS_ACQUISITION_MAX_SENSORS];
+  uint8_t index[BUS_ACQUISITION_MAX_SENSORS];
+  BusGroup groups[BUS_ACQUISITION_MAX_BUSES + 1];
+  uint8_t start = 0;
+  for(uint8_t g=0;g<=busCount;g++) {
+    groups[g].sensors = ordered + start;
+    groups[g].finishTimes = times + start;
+    groups[g].count = 0;
+    groups[g].ok = 0;
+    groups[g].timeout = timeout;
+    start += sizes[g];
+  }
+  for(uint8_t i=0;i<count;i++) {
+    BusGroup &group = groups[groupOf[i]];
+    index[group.sensors - ordered + group.count] = i;
+    group.sensors[group.count++] = sensors[i];
+    // callbacks are called only by the calling task
+    if(groupOf[i]) {
+      sensors[i]->holdHealthCallbacks();
+    }
+  }
+#if defined(ESP32)
+  uint8_t started = 0;
+  for(uint8_t g=1;g<=busCount;g++) {
+    groups[g].caller = xTaskGetCurrentTaskHandle();
+    if(xTaskCreate(busTask, "sensors", BUS_ACQUISITION_TASK_STACK, &groups[g], uxTaskPriorityGet(nullptr), nullptr) == pdPASS) {
+      started++;
+    } else {
+      groups[g].read();
+    }
+  }
+  if(sizes[0]) {
+    groups[0].read();
+  }
+  while(started--) {
+    ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+  }
+#else
+  std::thread threads[BUS_ACQUISITION_MAX_BUSES];
+  for(uint8_t g=1;g<=busCount;g++) {
+    threads[g-1] = std::thread(&BusGroup::read, &groups[g]);
+  }
+  if(sizes[0]) {
+    groups[0].read();
+  }
+  for(uint8_t b=0;b<busCount;b++) {
+    threads[b].join();
+  }
+#endif
+  for(uint8_t i=0;i<count;i++) {
+    if(groupOf[i]) {
+      sensors[i]->releaseHealthCallbacks();
+    }
+  }
+  uint8_t ok = 0;
+  for(uint8_t g=0;g<=busCount;g++) {
+    ok += groups[g].ok;
+  }
+  if(finishTimes) {
+    for(uint8_t i=0;i<count;i++) {
+      finishTimes[index[i]] = times[i];
+    }
+  }
+  return ok;
+}
+
+#else
+
+uint8_t readAllByBus(Sensor *sensors[], uint8_t count, uint32_t timeout, uint32_t *finishTimes) {
+  return Sensor::readAll(sensors, count, timeout, finishTimes);
+}
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef BUS_ACQUISITION_H
+#define BUS_ACQUISITION_H
+
+#include "SensorBase.h"
+
+#ifndef BUS_ACQUISITION_MAX_SENSORS
+#define BUS_ACQUISITION_MAX_SENSORS 16
+#endif
+
+#ifndef BUS_ACQUISITION_MAX_BUSES
+#define BUS_ACQUISITION_MAX_BUSES 4
+#endif
+
+#ifndef BUS_ACQUISITION_TASK_STACK
+#define BUS_ACQUISITION_TASK_STACK 4096
+#endif
+
+// Reads sensors as Sensor::readAll(), but sensors of each I2C bus (Sensor::getBus()) are read by their own FreeRTOS task on ESP32,
+// or thread when SENSORS_BUS_THREADS is defined (e.g. on host with simulated buses), so buses are read in parallel.
+// Sensors not on I2C, on more than BUS_ACQUISITION_MAX_BUSES buses or over BUS_ACQUISITION_MAX_SENSORS are read by the calling task.
+// Elsewhere it just calls Sensor::readAll().
+// Health callbacks of sensors read by the bus tasks are held and called by the calling task after all buses are read, a single call
+// per sensor with health before the read as previous. The sensorsMillis() clock is called from the bus tasks, see setSensorsClock()
+uint8_t readAllByBus(Sensor *sensors[], uint8_t count, uint32_t timeout = 2000, uint32_t *finishTimes = nullptr);
+
+#endif //BUS_ACQUISITION_H
@@ -0,0 +1,81 @@
+#include "CCS811Sensor.h"
+#include "SensorsFormat.h"
+
+#ifdef SENSORS_INCLUDE_CCS811
+
+// ===========  CCS811Sensor  ==================
+
+bool CCS811Sensor::init() {
+  ccs811.set_i2cdelay(50); // Needed for ESP8266 because it doesn't handle I2C clock stretch correctly
+  status = ccs811.begin();
+  if(!status) {
+    setError(ErrorInit);
+  } else {
+    switch(profile) {
+      case ProfileFastest:
+        status = ccs811.start(CCS811_MODE_1SEC);
+        break;
+      case ProfileLowPower:
+        status = ccs811.start(CCS811_MODE_60SEC);
+        break;
+      default:
+        status = ccs811.start(CCS811_MODE_10SEC);
+    }
+    if(!status) {
+      setError(ErrorStart);
+    }
+  }
+  return status;
+}
+
+bool CCS811Sensor::readValues() {
+  uint16_t errstat;
+  ccs811.read(&co2,&vocIndex,&errstat,&vocRaw); 
+  status = false;
+  if( errstat != CCS811_ERRSTAT_OK ) { 
+    if( errstat == CCS811_ERRSTAT_OK_NODATA ) {
+      setError(ErrorNoData);
+    } else if( errstat & CCS811_ERRSTAT_I2CFAIL ) { 
+      setError(ErrorBus);
+    } else {
+      setError(ErrorRead, errstat);
+    }
+    return false;
+  }
+  status = true;
+  return true;
+}
+
+// Sampling period of the drive mode
+uint32_t CCS811Sensor::getProfileConversionTime(SensorProfile profile) {
+  switch(profile) {
+    case ProfileFastest:
+      return 1000;
+    case ProfileLowPower:
+      return 60000;
+    default:
+      return 10000;
+  }
+}
+
+void CCS811Sensor::formatErrorDetail(Print &out) {
+  out.print(ccs811.errstat_str(errorDetail));
+}
+
+static constexpr FieldDescriptor CCS811Fields[] PROGMEM = {
+  co2Field<CCS811Sensor>(),
+  vocIndexField(),
+  vocRawField()
+};
+
+const FieldDescriptor *CCS811Sensor::getFields(uint8_t &count) {
+  count = SENSOR_FIELDS_COUNT(CCS811Fields);
+  return CCS811Fields;
+}
+
+void CCS811Sensor::printValues(Print &out) {
+  printCo2(out);
+  VOCSensor::printValues(out);
+}
+
+#endif //SENSORS_INCLUDE_CCS811
@@ -0,0 +1,28 @@
+#ifndef CCS811_SENSOR_H
+#define CCS811_SENSOR_H
+
+#include "SensorBase.h"
+
+#ifdef SENSORS_INCLUDE_CCS811
+#include <Wire.h>
+#include <ccs811.h>
+
+class CCS811Sensor : public VOCSensor, public CO2Sensor {
+  protected:
+    CCS811 ccs811;
+  public:
+    // ccs811 library always uses the global Wire
+    CCS811Sensor():VOCSensor("CCS811") { bus = &Wire; }
+    virtual bool init() override;
+    virtual bool readValues() override;
+    virtual const FieldDescriptor *getFields(uint8_t &count) override;
+    virtual bool supportsProfile(SensorProfile profile) override { return profile <= ProfileLowPower; }
+    virtual uint32_t getProfileConversionTime(SensorProfile profile) override;
+  protected:
+    virtual void formatErrorDetail(Print &out) override;
+    virtual void printValues(Print &out) override;
+};
+
+#endif //SENSORS_INCLUDE_CCS811
+
+#endif //CCS811_SENSOR_H
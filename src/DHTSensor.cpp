@@ -0,0 +1,31 @@
+#include "DHTSensor.h"
+
+#ifdef SENSORS_INCLUDE_DHT
+
+// ===========  DHTSensor  ==================
+bool DHTSensor::init() {
+  dht.setup(pin, DHTesp::AM2302);
+  temp = dht.getTemperature();
+  if (isnan(temp)) {
+    setError(ErrorRead);
+    status = false;
+  } else {
+    status = true;
+  }
+  return status;
+}
+
+bool DHTSensor::readValues() {
+  temp = dht.getTemperature();
+  hum = dht.getHumidity();
+  if (isnan(temp) || isnan(hum)) {
+    setError(ErrorRead);
+    status = false;
+  } else {
+    setError(ErrorNone);
+    status = true;
+  }
+  return status;
+}
+
+#endif //SENSORS_INCLUDE_DHT
@@ -0,0 +1,21 @@
+#ifndef DHT_SENSOR_H
+#define DHT_SENSOR_H
+
+#include "SensorBase.h"
+
+#ifdef SENSORS_INCLUDE_DHT
+#include <DHTesp.h>
+
+class DHTSensor : public TemperatureHumiditySensor {
+  protected:
+    DHTesp dht;
+    uint8_t pin;
+  public:
+    DHTSensor(uint8_t pin):TemperatureHumiditySensor("DHT22"),pin(pin) {}
+    virtual bool init() override;
+    virtual bool readValues() override;
+};
+
+#endif //SENSORS_INCLUDE_DHT
+
+#endif //DHT_SENSOR_H
@@ -0,0 +1,147 @@
+#include "DS18B20Sensor.h"
+#include "SensorsFormat.h"
+
+#ifdef SENSORS_INCLUDE_ONEWIRE
+
+// ===========  DS18B20Sensor  ==================
+
+DS18B20Sensor::DS18B20Sensor(uint8_t pin, uint8_t maxProbes):
+  TemperatureSensor("DS18B20"),oneWire(pin),sensor(&oneWire),maxProbes(maxProbes?maxProbes:1) {
+  addresses = new DeviceAddress[this->maxProbes];
+  resolutions = new uint8_t[this->maxProbes];
+  temps = new float[this->maxProbes];
+  // temp_NN with digits of the highest index and terminating zero
+  uint8_t tempLen = strlen(Temp);
+  fieldNameSize = tempLen + 3;
+  for(uint8_t n=(this->maxProbes-1)/10;n;n/=10) {
+    fieldNameSize++;
+  }
+  fieldNames = new char[this->maxProbes*fieldNameSize];
+  for(uint8_t i=0;i<this->maxProbes;i++) {
+    resolutions[i] = 12;
+    temps[i] = NAN;
+    char *fieldName = fieldNames + i*fieldNameSize;
+    strcpy(fieldName, Temp);
+    if(i) {
+      snprintf_P(fieldName + tempLen, fieldNameSize - tempLen, PSTR("_%d"), i);
+    }
+  }
+}
+
+DS18B20Sensor::~DS18B20Sensor() {
+  delete [] addresses;
+  delete [] resolutions;
+  delete [] temps;
+  delete [] fieldNames;
+}
+
+void DS18B20Sensor::setResolution(uint8_t bits) {
+  for(uint8_t i=0;i<maxProbes;i++) {
+    resolutions[i] = bits;
+  }
+}
+
+void DS18B20Sensor::setResolution(uint8_t index, uint8_t bits) {
+  if(index < maxProbes) {
+    resolutions[index] = bits;
+  }
+}
+
+bool DS18B20Sensor::init() {
+  sensor.begin();
+  probesCount = 0;
+  uint8_t maxResolution = 9;
+  // search bus only once, probes are then addressed directly
+  uint8_t count = sensor.getDeviceCount();
+  for(uint8_t i=0;i<count && probesCount<maxProbes;i++) {
+    if(!sensor.getAddress(addresses[probesCount], i)) {
+      continue;
+    }
+    sensor.setResolution(addresses[probesCount], resolutions[probesCount], true);
+    if(resolutions[probesCount] > maxResolution) {
+      maxResolution = resolutions[probesCount];
+    }
+    temps[probesCount++] = NAN;
+  }
+  conversionTime = sensor.millisToWaitForConversion(maxResolution);
+  status = probesCount > 0;
+  if(!status) {
+    setError(ErrorNoDevice);
+  }
+  return status;
+}
+
+bool DS18B20Sensor::readValues() {
+  if(!startMeasurement()) {
+    return false;
+  }
+  delay(conversionTime);
+  return finishMeasurement();
+}
+
+// A single broadcast conversion of all probes
+bool DS18B20Sensor::startMeasurement() {
+  sensor.setWaitForConversion(false);
+  sensor.requestTemperatures();
+  sensor.setWaitForConversion(true);
+  conversionStart = sensorsMillis();
+  return true;
+}
+
+bool DS18B20Sensor::measurementReady() {
+  return sensorsMillis()-conversionStart > conversionTime;
+}
+
+bool DS18B20Sensor::finishMeasurement() {
+  uint8_t failed = 0;
+  for(uint8_t i=0;i<probesCount;i++) {
+    temps[i] = sensor.getTempC(addresses[i]);
+    if(temps[i] == DEVICE_DISCONNECTED_C) {
+      temps[i] = NAN;
+      failed++;
+    }
+  }
+  temp = temps[0];
+  status = probesCount && failed < probesCount;
+  // partial failure keeps status, the error reports number of failed probes
+  if(failed) {
+    setError(ErrorRead, failed);
+  } else {
+    setError(ErrorNone);
+  }
+  return status;
+}
+
+void DS18B20Sensor::writeFields(FieldSink &sink) {
+  for(uint8_t i=0;i<probesCount;i++) {
+    if(!isnan(temps[i])) {
+      sink.addField(fieldNames + i*fieldNameSize, temps[i]);
+    }
+  }
+}
+
+bool DS18B20Sensor::setField(const char *key, float value) {
+  for(uint8_t i=0;i<probesCount;i++) {
+    const char *fieldName = fieldNames + i*fieldNameSize;
+    if(fieldName == key || !strcmp(fieldName, key)) {
+      temps[i] = value;
+      if(!i) {
+        temp = value;
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+void DS18B20Sensor::printValues(Print &out) {
+  for(uint8_t i=0;i<probesCount;i++) {
+    if(i) {
+      out.print(F("  "));
+    }
+    printFixed(out, temps[i], 3, 1);
+    out.print(F("°C"));
+  }
+}
+
+#endif //SENSORS_INCLUDE_ONEWIRE
@@ -0,0 +1,55 @@
+#ifndef DS18B20_SENSOR_H
+#define DS18B20_SENSOR_H
+
+#include "SensorBase.h"
+
+#ifdef SENSORS_INCLUDE_ONEWIRE
+#include <OneWire.h>
+#include <DallasTemperature.h>
+
+// All DS18B20 probes on a single 1-Wire bus. Addresses are found once in init() and all probes convert at once.
+// First probe is written as the temp field, others as temp_1, temp_2, ... in 1-Wire search order, which is not ascending
+// by ROM address and changes when a probe is added or removed. getProbeAddress() tells which probe has the index.
+// Resolutions set by index apply in the same order
+// When some probes fail, the read still succeeds with the others (status is true, failed probes are NAN and not written)
+// and the error is ErrorRead with number of failed probes as detail. The read fails only when all probes fail
+class DS18B20Sensor : public TemperatureSensor {
+  protected:
+    OneWire oneWire;
+    DallasTemperature sensor;
+    uint32_t conversionStart = 0;
+    uint8_t maxProbes;
+    uint8_t probesCount = 0;
+    DeviceAddress *addresses;
+    uint8_t *resolutions;
+    float *temps;
+    char *fieldNames;
+    uint8_t fieldNameSize;
+    uint16_t conversionTime = 750;
+  public:
+    DS18B20Sensor(uint8_t pin, uint8_t maxProbes = 1);
+    // Owns arrays of probes
+    DS18B20Sensor(const DS18B20Sensor &) = delete;
+    DS18B20Sensor &operator=(const DS18B20Sensor &) = delete;
+    virtual ~DS18B20Sensor();
+    virtual bool init() override;
+    virtual bool readValues() override;
+    virtual bool startMeasurement() override;
+    virtual bool measurementReady() override;
+    virtual bool finishMeasurement() override;
+    virtual void writeFields(FieldSink &sink) override;
+    virtual bool setField(const char *key, float value) override;
+    // Sets resolution (9-12 bits) of all probes or a single probe, applied by init(). Lower resolution has shorter conversion
+    void setResolution(uint8_t bits);
+    void setResolution(uint8_t index, uint8_t bits);
+    uint8_t getProbesCount() const { return probesCount; }
+    const uint8_t *getProbeAddress(uint8_t index) const { return addresses[index]; }
+    // Returns temperature of the probe, NAN if it failed
+    float getProbeTemp(uint8_t index) const { return index < probesCount?temps[index]:NAN; }
+  protected:
+    virtual void printValues(Print &out) override;
+};
+
+#endif //SENSORS_INCLUDE_ONEWIRE
+
+#endif //DS18B20_SENSOR_H
@@ -0,0 +1,99 @@
+#include "DeadbandFilter.h"
+
+DeadbandFilter::DeadbandFilter(uint32_t heartbeat, float defaultDeadband, bool percent):
+  rulesCount(0),fieldsCount(0),defaultDeadband(defaultDeadband),defaultPercent(percent),heartbeat(heartbeat),
+  sensor(nullptr),sink(nullptr),cycleEmitted(0),emitted(0),suppressed(0) {
+}
+
+bool DeadbandFilter::setDeadband(const char *key, float deadband, bool percent) {
+  uint8_t i = 0;
+  while(i < rulesCount && strcmp(rules[i].key, key)) {
+    i++;
+  }
+  if(i == DEADBAND_FILTER_MAX_RULES) {
+    return false;
+  }
+  if(i == rulesCount) {
+    rulesCount++;
+  }
+  rules[i].key = key;
+  rules[i].deadband = deadband;
+  rules[i].percent = percent;
+  return true;
+}
+
+uint16_t DeadbandFilter::writeFields(Sensor &sensor, FieldSink &sink) {
+  cycleEmitted = 0;
+  if(!sensor.getStatus()) {
+    return 0;
+  }
+  this->sensor = &sensor;
+  this->sink = &sink;
+  sensor.writeFields(*this);
+  this->sink = nullptr;
+  return cycleEmitted;
+}
+
+uint16_t DeadbandFilter::storeValues(Sensor &sensor, Point &point) {
+  PointFieldSink sink(point);
+  return writeFields(sensor, sink);
+}
+
+void DeadbandFilter::addField(const char *key, float value) {
+  if(shouldReport(key, value)) {
+    sink->addField(key, value);
+  }
+}
+
+void DeadbandFilter::addField(const char *key, int32_t value) {
+  if(shouldReport(key, value)) {
+    sink->addField(key, value);
+  }
+}
+
+bool DeadbandFilter::shouldReport(const char *key, float value) {
+  uint32_t now = sensorsMillis();
+  FieldState *state = nullptr;
+  for(uint8_t i=0;i<fieldsCount;i++) {
+    if(fields[i].sensor == sensor && (fields[i].key == key || !strcmp(fields[i].key, key))) {
+      state = &fields[i];
+      break;
+    }
+  }
+  bool report = true;
+  if(state) {
+    float deadband = defaultDeadband;
+    bool percent = defaultPercent;
+    for(uint8_t i=0;i<rulesCount;i++) {
+      if(!strcmp(rules[i].key, key)) {
+        deadband = rules[i].deadband;
+        percent = rules[i].percent;
+        break;
+      }
+    }
+    if(percent) {
+      deadband = fabsf(state->lastValue) * deadband / 100;
+    }
+    float delta = fabsf(value - state->lastValue);
+    // nan delta means one of values is nan, report only a change
+    report = isnan(delta)?isnan(value) != isnan(state->lastValue):delta > deadband;
+    if(!report && heartbeat && now - state->lastTime >= heartbeat) {
+      report = true;
+    }
+  } else if(fieldsCount < DEADBAND_FILTER_MAX_FIELDS) {
+    state = &fields[fieldsCount++];
+    state->sensor = sensor;
+    state->key = key;
+  }
+  if(!report) {
+    suppressed++;
+    return false;
+  }
+  if(state) {
+    state->lastValue = value;
+    state->lastTime = now;
+  }
+  emitted++;
+  cycleEmitted++;
+  return true;
+}
@@ -0,0 +1,64 @@
+#ifndef DEADBAND_FILTER_H
+#define DEADBAND_FILTER_H
+
+#include "SensorBase.h"
+
+#ifndef DEADBAND_FILTER_MAX_RULES
+#define DEADBAND_FILTER_MAX_RULES 8
+#endif
+#ifndef DEADBAND_FILTER_MAX_FIELDS
+#define DEADBAND_FILTER_MAX_FIELDS 24
+#endif
+
+// Suppresses fields, which haven't changed more than their deadband since they were last reported,
+// unless heartbeat interval has elapsed. Works with fields of any sensor, last reported values are kept per sensor and field.
+// Fields over DEADBAND_FILTER_MAX_FIELDS are always passed.
+class DeadbandFilter : public FieldSink {
+  protected:
+    struct Rule {
+      // passed to setDeadband(), matched to field keys by strcmp()
+      const char *key;
+      float deadband;
+      bool percent;
+    };
+    struct FieldState {
+      const Sensor *sensor;
+      const char *key;
+      float lastValue;
+      uint32_t lastTime;
+    };
+    Rule rules[DEADBAND_FILTER_MAX_RULES];
+    uint8_t rulesCount;
+    FieldState fields[DEADBAND_FILTER_MAX_FIELDS];
+    uint8_t fieldsCount;
+    float defaultDeadband;
+    bool defaultPercent;
+    uint32_t heartbeat;
+    const Sensor *sensor;
+    FieldSink *sink;
+    uint16_t cycleEmitted;
+    uint32_t emitted;
+    uint32_t suppressed;
+  public:
+    // heartbeat is max interval in ms without reporting a field, 0 disables it.
+    // Default deadband applies to fields without a rule, 0 reports any change
+    DeadbandFilter(uint32_t heartbeat, float defaultDeadband = 0, bool percent = false);
+    // Sets deadband of fields with the key, absolute or percent of the last reported value.
+    // Key is not copied, it must remain valid, e.g. a literal or a field key constant like Temp
+    bool setDeadband(const char *key, float deadband, bool percent = false);
+    // Passes fields of successfully read sensor, which should be reported, to sink. Returns number of passed fields
+    uint16_t writeFields(Sensor &sensor, FieldSink &sink);
+    // Adds fields to point, returns number of added fields. Don't write point without fields
+    uint16_t storeValues(Sensor &sensor, Point &point);
+    virtual void addField(const char *key, float value) override;
+    virtual void addField(const char *key, int32_t value) override;
+    // Forgets reported values, so all fields are reported next time
+    void reset() { fieldsCount = 0; }
+    uint32_t getEmittedCount() const { return emitted; }
+    uint32_t getSuppressedCount() const { return suppressed; }
+    void resetCounters() { emitted = 0; suppressed = 0; }
+  protected:
+    bool shouldReport(const char *key, float value);
+};
+
+#endif //DEADBAND_FILTER_H
@@ -0,0 +1,96 @@
+#include "FieldAggregator.h"
+
+FieldAggregator::FieldAggregator(uint32_t windowLength):currentSensor(nullptr),windowLength(windowLength) {
+  reset();
+}
+
+void FieldAggregator::reset() {
+  fieldsCount = 0;
+  windowStart = 0;
+  samples = 0;
+  overflow = false;
+}
+
+void FieldAggregator::add(Sensor &sensor) {
+  if(!sensor.getStatus()) {
+    return;
+  }
+  if(!samples) {
+    windowStart = sensorsMillis();
+  }
+  samples++;
+  currentSensor = &sensor;
+  sensor.writeFields(*this);
+  currentSensor = nullptr;
+}
+
+const FieldStats *FieldAggregator::getStats(const Sensor *sensor, const char *key) const {
+  for(uint8_t i=0;i<fieldsCount;i++) {
+    if(fields[i].sensor == sensor && (fields[i].key == key || !strcmp(fields[i].key, key))) {
+      return &fields[i];
+    }
+  }
+  return nullptr;
+}
+
+void FieldAggregator::addField(const char *key, float value) {
+  if(isnan(value)) {
+    return;
+  }
+  FieldStats *stats = const_cast<FieldStats *>(getStats(currentSensor, key));
+  if(!stats) {
+    if(fieldsCount == FIELD_AGGREGATOR_MAX_FIELDS) {
+      overflow = true;
+      return;
+    }
+    stats = &fields[fieldsCount++];
+    stats->sensor = currentSensor;
+    stats->key = key;
+    stats->count = 0;
+    stats->min = value;
+    stats->max = value;
+    stats->mean = 0;
+    stats->m2 = 0;
+  }
+  stats->count++;
+  if(value < stats->min) {
+    stats->min = value;
+  }
+  if(value > stats->max) {
+    stats->max = value;
+  }
+  float delta = value - stats->mean;
+  stats->mean += delta / stats->count;
+  stats->m2 += delta * (value - stats->mean);
+}
+
+// Longest key with suffix
+static const uint8_t AggregateKeyLen = 40;
+
+static const char *aggregateKey(char *buff, const char *key, const char *suffix) {
+  strncpy(buff, key, AggregateKeyLen - 8);
+  buff[AggregateKeyLen - 8] = 0;
+  strcat_P(buff, suffix);
+  return buff;
+}
+
+void FieldAggregator::writeFields(const Sensor &sensor, FieldSink &sink) {
+  char key[AggregateKeyLen];
+  for(uint8_t i=0;i<fieldsCount;i++) {
+    FieldStats &s = fields[i];
+    if(s.sensor != &sensor) {
+      continue;
+    }
+    sink.addField(aggregateKey(key, s.key, PSTR("_count")), (int32_t)s.count);
+    sink.addField(aggregateKey(key, s.key, PSTR("_min")), s.min);
+    sink.addField(aggregateKey(key, s.key, PSTR("_max")), s.max);
+    sink.addField(aggregateKey(key, s.key, PSTR("_mean")), s.mean);
+    // sample standard deviation
+    sink.addField(aggregateKey(key, s.key, PSTR("_stddev")), s.count > 1?sqrtf(s.m2/(s.count - 1)):0.0f);
+  }
+}
+
+void FieldAggregator::storeValues(const Sensor &sensor, Point &point) {
+  PointFieldSink sink(point);
+  writeFields(sensor, sink);
+}
@@ -0,0 +1,55 @@
+#ifndef FIELD_AGGREGATOR_H
+#define FIELD_AGGREGATOR_H
+
+#include "SensorBase.h"
+
+#ifndef FIELD_AGGREGATOR_MAX_FIELDS
+#define FIELD_AGGREGATOR_MAX_FIELDS 16
+#endif
+
+// Streaming statistics of a single field of a sensor (Welford's algorithm)
+struct FieldStats {
+  const Sensor *sensor;
+  const char *key;
+  uint32_t count;
+  float min;
+  float max;
+  float mean;
+  float m2;
+};
+
+// Aggregates fields of sensors over a time window, keeping constant memory per field.
+// Each (sensor, field) pair has its own stats, so sensors with the same field keys don't mix.
+// Feed it with add() after each reading and when isWindowComplete() write the aggregates of each sensor,
+// e.g. into a point tagged by the sensor name, each field as <key>_count, <key>_min, <key>_max, <key>_mean and <key>_stddev.
+// Field keys must remain valid, which is true for all sensors.
+class FieldAggregator : public FieldSink {
+  protected:
+    FieldStats fields[FIELD_AGGREGATOR_MAX_FIELDS];
+    uint8_t fieldsCount;
+    const Sensor *currentSensor;
+    uint32_t windowLength;
+    uint32_t windowStart;
+    uint32_t samples;
+    bool overflow;
+  public:
+    // windowLength is in ms
+    FieldAggregator(uint32_t windowLength);
+    // Accumulates fields of successfully read sensor
+    void add(Sensor &sensor);
+    virtual void addField(const char *key, float value) override;
+    virtual void addField(const char *key, int32_t value) override { addField(key, (float)value); }
+    // Returns true when the window has elapsed since the first sample
+    bool isWindowComplete() const { return samples && sensorsMillis() - windowStart >= windowLength; }
+    // Passes aggregated fields of the sensor to the sink
+    void writeFields(const Sensor &sensor, FieldSink &sink);
+    void storeValues(const Sensor &sensor, Point &point);
+    // Starts a new window
+    void reset();
+    uint32_t getSamplesCount() const { return samples; }
+    // True when some fields didn't fit into FIELD_AGGREGATOR_MAX_FIELDS
+    bool isOverflow() const { return overflow; }
+    const FieldStats *getStats(const Sensor *sensor, const char *key) const;
+};
+
+#endif //FIELD_AGGREGATOR_H
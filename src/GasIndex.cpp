@@ -0,0 +1,348 @@
+#include "GasIndex.h"
+
+// Q16.16 fixed point helpers
+#define F16(x) ((int32_t)(((x) >= 0)?((x) * 65536.0 + 0.5):((x) * 65536.0 - 0.5)))
+static const int32_t Fix16One = 0x00010000;
+static const int32_t Fix16Max = 0x7FFFFFFF;
+static const int32_t Fix16Min = -0x7FFFFFFF;
+
+static float fix16ToFloat(int32_t x) {
+  return x / 65536.0f;
+}
+
+static int32_t fix16Saturate(int64_t x) {
+  return x > Fix16Max?Fix16Max:(x < Fix16Min?Fix16Min:(int32_t)x);
+}
+
+static int32_t fix16Add(int32_t a, int32_t b) {
+  return fix16Saturate((int64_t)a + b);
+}
+
+static int32_t fix16Mul(int32_t a, int32_t b) {
+  int64_t product = (int64_t)a * b;
+  return fix16Saturate((product + 0x8000) >> 16);
+}
+
+static int32_t fix16Div(int32_t a, int32_t b) {
+  if(b == 0) {
+    return a < 0?Fix16Min:Fix16Max;
+  }
+  int64_t n = (int64_t)a * 65536;
+  // round half away from zero
+  int64_t half = (b < 0?-(int64_t)b:b)/2;
+  n += (n < 0) != (b < 0)?-half:half;
+  return fix16Saturate(n / b);
+}
+
+static int32_t fix16Sqrt(int32_t x) {
+  if(x <= 0) {
+    return 0;
+  }
+  uint64_t num = (uint64_t)x << 16;
+  uint64_t result = 0;
+  uint64_t bit = (uint64_t)1 << 62;
+  while(bit > num) {
+    bit >>= 2;
+  }
+  while(bit) {
+    if(num >= result + bit) {
+      num -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  // round to nearest, truncation biases slowly adapting std estimate
+  if(num > result) {
+    result++;
+  }
+  return (int32_t)result;
+}
+
+// e^1, e^(1/8), e^(1/64), e^(1/512) and their inverses
+static const int32_t ExpPos[] = { F16(2.7182818), F16(1.1331485), F16(1.0157477), F16(1.0019550) };
+static const int32_t ExpNeg[] = { F16(0.3678794), F16(0.8824969), F16(0.9844964), F16(0.9980488) };
+
+static int32_t fix16Exp(int32_t x) {
+  if(x >= F16(10.3972)) {
+    return Fix16Max;
+  }
+  if(x <= F16(-11.7835)) {
+    return 0;
+  }
+  const int32_t *values = ExpPos;
+  if(x < 0) {
+    x = -x;
+    values = ExpNeg;
+  }
+  int32_t res = Fix16One;
+  int32_t arg = Fix16One;
+  for(uint8_t i=0;i<4;i++) {
+    while(x >= arg) {
+      res = fix16Mul(res, values[i]);
+      x -= arg;
+    }
+    arg >>= 3;
+  }
+  return res;
+}
+
+// Algorithm tuning (Sensirion gas index algorithm)
+static const int32_t InitialBlackout = F16(45);
+static const int32_t IndexGain = F16(230);
+static const int32_t SrawStdInitial = F16(50);
+static const int32_t SrawStdBonusVoc = F16(220);
+static const int32_t SrawStdNox = F16(2000);
+static const float TauMeanHours = 12;
+static const float TauVarianceHours = 12;
+static const float TauInitialMeanVoc = 20;
+static const float TauInitialMeanNox = 1200;
+static const float InitDurationMeanVoc = 3600 * 0.75;
+static const float InitDurationMeanNox = 3600 * 4.75;
+static const int32_t InitTransitionMean = F16(0.01);
+static const float TauInitialVariance = 2500;
+static const float InitDurationVarianceVoc = 3600 * 1.45;
+static const float InitDurationVarianceNox = 3600 * 5.70;
+static const int32_t InitTransitionVariance = F16(0.01);
+static const float GatingThresholdVoc = 340;
+static const float GatingThresholdNox = 30;
+static const int32_t GatingThresholdInitial = F16(510);
+static const int32_t GatingThresholdTransition = F16(0.09);
+static const float GatingVocMaxDurationMinutes = 60 * 3;
+static const float GatingNoxMaxDurationMinutes = 60 * 12;
+static const int32_t GatingMaxRatio = F16(0.3);
+static const int32_t SigmoidL = F16(500);
+static const int32_t SigmoidKVoc = F16(-0.0065);
+static const int32_t SigmoidX0Voc = F16(213);
+static const int32_t SigmoidKNox = F16(-0.0101);
+static const int32_t SigmoidX0Nox = F16(614);
+static const int32_t VocIndexOffsetDefault = F16(100);
+static const int32_t NoxIndexOffsetDefault = F16(1);
+static const int32_t LpTauFast = F16(20);
+static const int32_t LpTauSlow = F16(500);
+static const int32_t LpAlpha = F16(-0.2);
+static const int32_t VocSrawMinimum = 20000;
+static const int32_t NoxSrawMinimum = 10000;
+static const int32_t PersistenceUptimeGamma = F16(3 * 3600);
+static const int32_t GammaScaling = F16(64);
+static const int32_t AdditionalGammaMeanScaling = F16(8);
+static const int32_t UptimeMax = F16(32767);
+
+GasIndexAlgorithm::GasIndexAlgorithm(GasIndexType type, float samplingInterval):type(type) {
+  this->samplingInterval = F16(samplingInterval);
+  bool nox = type == GasIndexNox;
+  indexOffset = nox?NoxIndexOffsetDefault:VocIndexOffsetDefault;
+  srawMinimum = nox?NoxSrawMinimum:VocSrawMinimum;
+  gatingMaxDurationMinutes = F16(nox?GatingNoxMaxDurationMinutes:GatingVocMaxDurationMinutes);
+  initDurationMean = F16(nox?InitDurationMeanNox:InitDurationMeanVoc);
+  initDurationVariance = F16(nox?InitDurationVarianceNox:InitDurationVarianceVoc);
+  gatingThreshold = F16(nox?GatingThresholdNox:GatingThresholdVoc);
+  // gammas depend only on sampling interval, they are computed once
+  float hours = samplingInterval / 3600;
+  float gammaScaling = fix16ToFloat(GammaScaling);
+  float gammaMeanScaling = fix16ToFloat(AdditionalGammaMeanScaling) * gammaScaling;
+  mveGammaMean = F16(gammaMeanScaling * hours / (TauMeanHours + hours));
+  mveGammaVariance = F16(gammaScaling * hours / (TauVarianceHours + hours));
+  mveGammaInitialMean = F16(gammaMeanScaling * samplingInterval / ((nox?TauInitialMeanNox:TauInitialMeanVoc) + samplingInterval));
+  mveGammaInitialVariance = F16(gammaScaling * samplingInterval / (TauInitialVariance + samplingInterval));
+  lpA1 = F16(samplingInterval / (fix16ToFloat(LpTauFast) + samplingInterval));
+  lpA2 = F16(samplingInterval / (fix16ToFloat(LpTauSlow) + samplingInterval));
+  reset();
+}
+
+void GasIndexAlgorithm::reset() {
+  uptime = 0;
+  sraw = 0;
+  gasIndex = 0;
+  initInstances();
+}
+
+void GasIndexAlgorithm::initInstances() {
+  mveSetParameters();
+  moxSrawStd = mveStd;
+  moxSrawMean = mveGetMean();
+  lpInitialized = false;
+}
+
+void GasIndexAlgorithm::getState(int32_t &mean, int32_t &std) const {
+  mean = mveGetMean();
+  std = mveStd;
+}
+
+void GasIndexAlgorithm::setState(int32_t mean, int32_t std) {
+  mveMean = mean;
+  mveStd = std;
+  mveUptimeGamma = PersistenceUptimeGamma;
+  mveInitialized = true;
+  moxSrawStd = mveStd;
+  moxSrawMean = mveGetMean();
+  sraw = mean;
+  // blackout only waits for the first samples to learn from
+  uptime = InitialBlackout + samplingInterval;
+}
+
+int32_t GasIndexAlgorithm::process(int32_t sraw) {
+  if(uptime <= InitialBlackout) {
+    uptime += samplingInterval;
+  } else {
+    if(sraw > 0 && sraw < 65000) {
+      if(sraw < srawMinimum + 1) {
+        sraw = srawMinimum + 1;
+      } else if(sraw > srawMinimum + 32767) {
+        sraw = srawMinimum + 32767;
+      }
+      this->sraw = (sraw - srawMinimum) << 16;
+    }
+    if(type == GasIndexVoc || mveInitialized) {
+      gasIndex = sigmoidScaledProcess(moxProcess(this->sraw));
+    } else {
+      gasIndex = indexOffset;
+    }
+    gasIndex = lowpassProcess(gasIndex);
+    if(gasIndex < F16(0.5)) {
+      gasIndex = F16(0.5);
+    }
+    if(this->sraw > 0) {
+      mveProcess(this->sraw);
+      moxSrawStd = mveStd;
+      moxSrawMean = mveGetMean();
+    }
+  }
+  return (gasIndex + F16(0.5)) >> 16;
+}
+
+void GasIndexAlgorithm::mveSetParameters() {
+  mveInitialized = false;
+  mveMean = 0;
+  mveSrawOffset = 0;
+  mveStd = SrawStdInitial;
+  mveCurrentGammaMean = 0;
+  mveCurrentGammaVariance = 0;
+  mveUptimeGamma = 0;
+  mveUptimeGating = 0;
+  mveGatingDurationMinutes = 0;
+}
+
+int32_t GasIndexAlgorithm::sigmoidProcess(int32_t sample) const {
+  int32_t x = fix16Mul(sigmoidK, sample - sigmoidX0);
+  if(x < F16(-50)) {
+    return Fix16One;
+  } else if(x > F16(50)) {
+    return 0;
+  }
+  return fix16Div(Fix16One, fix16Add(Fix16One, fix16Exp(x)));
+}
+
+void GasIndexAlgorithm::mveCalculateGamma() {
+  int32_t uptimeLimit = UptimeMax - samplingInterval;
+  if(mveUptimeGamma < uptimeLimit) {
+    mveUptimeGamma += samplingInterval;
+  }
+  if(mveUptimeGating < uptimeLimit) {
+    mveUptimeGating += samplingInterval;
+  }
+  sigmoidX0 = initDurationMean;
+  sigmoidK = InitTransitionMean;
+  int32_t sigmoidGammaMean = sigmoidProcess(mveUptimeGamma);
+  int32_t gammaMean = mveGammaMean + fix16Mul(mveGammaInitialMean - mveGammaMean, sigmoidGammaMean);
+  int32_t gatingThresholdMean = gatingThreshold + fix16Mul(GatingThresholdInitial - gatingThreshold, sigmoidProcess(mveUptimeGating));
+  sigmoidX0 = gatingThresholdMean;
+  sigmoidK = GatingThresholdTransition;
+  int32_t sigmoidGatingMean = sigmoidProcess(gasIndex);
+  mveCurrentGammaMean = fix16Mul(sigmoidGatingMean, gammaMean);
+
+  sigmoidX0 = initDurationVariance;
+  sigmoidK = InitTransitionVariance;
+  int32_t sigmoidGammaVariance = sigmoidProcess(mveUptimeGamma);
+  int32_t gammaVariance = mveGammaVariance + fix16Mul(mveGammaInitialVariance - mveGammaVariance, sigmoidGammaVariance - sigmoidGammaMean);
+  int32_t gatingThresholdVariance = gatingThreshold + fix16Mul(GatingThresholdInitial - gatingThreshold, sigmoidProcess(mveUptimeGating));
+  sigmoidX0 = gatingThresholdVariance;
+  sigmoidK = GatingThresholdTransition;
+  int32_t sigmoidGatingVariance = sigmoidProcess(gasIndex);
+  mveCurrentGammaVariance = fix16Mul(sigmoidGatingVariance, gammaVariance);
+
+  mveGatingDurationMinutes += fix16Mul(fix16Div(samplingInterval, F16(60)),
+    fix16Mul(Fix16One - sigmoidGatingMean, Fix16One + GatingMaxRatio) - GatingMaxRatio);
+  if(mveGatingDurationMinutes < 0) {
+    mveGatingDurationMinutes = 0;
+  }
+  if(mveGatingDurationMinutes > gatingMaxDurationMinutes) {
+    mveUptimeGating = 0;
+  }
+}
+
+void GasIndexAlgorithm::mveProcess(int32_t sraw) {
+  if(!mveInitialized) {
+    mveInitialized = true;
+    mveSrawOffset = sraw;
+    mveMean = 0;
+    return;
+  }
+  if(mveMean >= F16(100) || mveMean <= F16(-100)) {
+    mveSrawOffset += mveMean;
+    mveMean = 0;
+  }
+  sraw -= mveSrawOffset;
+  mveCalculateGamma();
+  int32_t delta = fix16Div(sraw - mveMean, GammaScaling);
+  int32_t c = delta < 0?mveStd - delta:mveStd + delta;
+  int32_t additionalScaling = Fix16One;
+  if(c > F16(1440)) {
+    int32_t r = fix16Div(c, F16(1440));
+    additionalScaling = fix16Mul(r, r);
+  }
+  mveStd = fix16Mul(fix16Sqrt(fix16Mul(additionalScaling, GammaScaling - mveCurrentGammaVariance)),
+    fix16Sqrt(fix16Mul(mveStd, fix16Div(mveStd, fix16Mul(GammaScaling, additionalScaling)))
+      + fix16Mul(fix16Div(fix16Mul(mveCurrentGammaVariance, delta), additionalScaling), delta)));
+  mveMean += fix16Div(fix16Mul(mveCurrentGammaMean, delta), AdditionalGammaMeanScaling);
+}
+
+int32_t GasIndexAlgorithm::moxProcess(int32_t sraw) const {
+  if(type == GasIndexNox) {
+    return fix16Mul(fix16Div(sraw - moxSrawMean, SrawStdNox), IndexGain);
+  }
+  return fix16Mul(fix16Div(sraw - moxSrawMean, -(moxSrawStd + SrawStdBonusVoc)), IndexGain);
+}
+
+int32_t GasIndexAlgorithm::sigmoidScaledProcess(int32_t sample) const {
+  bool nox = type == GasIndexNox;
+  int32_t x = fix16Mul(nox?SigmoidKNox:SigmoidKVoc, sample - (nox?SigmoidX0Nox:SigmoidX0Voc));
+  if(x < F16(-50)) {
+    return SigmoidL;
+  } else if(x > F16(50)) {
+    return 0;
+  }
+  // exp saturates for large x, sum must not overflow
+  int32_t e = fix16Add(Fix16One, fix16Exp(x));
+  if(sample >= 0) {
+    int32_t shift;
+    if(nox) {
+      shift = fix16Mul(F16(500.0 / 499.0), Fix16One - indexOffset);
+    } else {
+      shift = fix16Div(SigmoidL - fix16Mul(F16(5), indexOffset), F16(4));
+    }
+    return fix16Div(SigmoidL + shift, e) - shift;
+  }
+  return fix16Mul(fix16Div(indexOffset, nox?NoxIndexOffsetDefault:VocIndexOffsetDefault), fix16Div(SigmoidL, e));
+}
+
+int32_t GasIndexAlgorithm::lowpassProcess(int32_t sample) {
+  if(!lpInitialized) {
+    lpX1 = sample;
+    lpX2 = sample;
+    lpX3 = sample;
+    lpInitialized = true;
+  }
+  lpX1 = fix16Mul(Fix16One - lpA1, lpX1) + fix16Mul(lpA1, sample);
+  lpX2 = fix16Mul(Fix16One - lpA2, lpX2) + fix16Mul(lpA2, sample);
+  int32_t absDelta = lpX1 - lpX2;
+  if(absDelta < 0) {
+    absDelta = -absDelta;
+  }
+  int32_t f1 = fix16Exp(fix16Mul(LpAlpha, absDelta));
+  int32_t tauA = fix16Mul(LpTauSlow - LpTauFast, f1) + LpTauFast;
+  int32_t a3 = fix16Div(samplingInterval, samplingInterval + tauA);
+  lpX3 = fix16Mul(Fix16One - a3, lpX3) + fix16Mul(a3, sample);
+  return lpX3;
+}
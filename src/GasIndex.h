@@ -0,0 +1,79 @@
+#ifndef GAS_INDEX_H
+#define GAS_INDEX_H
+
+#include <Arduino.h>
+
+enum GasIndexType : uint8_t {
+  GasIndexVoc = 0,
+  GasIndexNox
+};
+
+// Sensirion gas index algorithm (adaptive mean/variance estimator with sigmoid scaling and adaptive lowpass)
+// computed in Q16.16 fixed point. Converts raw SGP40/SGP41 signal into VOC index (1-500, 100 is average)
+// or NOx index (1-500, 1 is average). Each sample costs constant time without floating point math.
+// Call process() in regular intervals given by samplingInterval (seconds).
+class GasIndexAlgorithm {
+  public:
+    GasIndexAlgorithm(GasIndexType type, float samplingInterval = 1);
+    // Starts learning again
+    void reset();
+    // Processes raw signal, returns index, 0 during initial blackout (45s)
+    int32_t process(int32_t sraw);
+    // Gets learned state (fixed point mean and std), which can be restored after restart to skip the learning period.
+    // State is learned after the first sample past the initial blackout
+    void getState(int32_t &mean, int32_t &std) const;
+    bool isLearned() const { return mveInitialized; }
+    // Restores learned state, the first sample after it gives an index without the initial blackout
+    void setState(int32_t mean, int32_t std);
+    GasIndexType getType() const { return type; }
+  protected:
+    GasIndexType type;
+    int32_t samplingInterval;
+    int32_t indexOffset;
+    int32_t srawMinimum;
+    int32_t gatingMaxDurationMinutes;
+    int32_t initDurationMean;
+    int32_t initDurationVariance;
+    int32_t gatingThreshold;
+    int32_t uptime;
+    int32_t sraw;
+    int32_t gasIndex;
+    // mean variance estimator
+    bool mveInitialized;
+    int32_t mveMean;
+    int32_t mveSrawOffset;
+    int32_t mveStd;
+    int32_t mveGammaMean;
+    int32_t mveGammaVariance;
+    int32_t mveGammaInitialMean;
+    int32_t mveGammaInitialVariance;
+    int32_t mveCurrentGammaMean;
+    int32_t mveCurrentGammaVariance;
+    int32_t mveUptimeGamma;
+    int32_t mveUptimeGating;
+    int32_t mveGatingDurationMinutes;
+    int32_t sigmoidK;
+    int32_t sigmoidX0;
+    // mox model
+    int32_t moxSrawStd;
+    int32_t moxSrawMean;
+    // adaptive lowpass
+    int32_t lpA1;
+    int32_t lpA2;
+    bool lpInitialized;
+    int32_t lpX1;
+    int32_t lpX2;
+    int32_t lpX3;
+  protected:
+    void initInstances();
+    void mveSetParameters();
+    void mveCalculateGamma();
+    void mveProcess(int32_t sraw);
+    int32_t mveGetMean() const { return mveMean + mveSrawOffset; }
+    int32_t sigmoidProcess(int32_t sample) const;
+    int32_t moxProcess(int32_t sraw) const;
+    int32_t sigmoidScaledProcess(int32_t sample) const;
+    int32_t lowpassProcess(int32_t sample);
+};
+
+#endif //GAS_INDEX_H
@@ -0,0 +1,62 @@
+#include "SCD30Sensor.h"
+
+#ifdef SENSORS_INCLUDE_SCD30
+
+// ===========  SCD30Sensor  ==================
+
+bool SCD30Sensor::init() {
+  status = scd30.begin(*bus);
+  if(!status) {
+    setError(ErrorInit);
+  }
+  return status;
+}
+
+bool SCD30Sensor::readValues() {
+  if (!scd30.dataAvailable()) {
+    status = false;
+    // the library reads not ready also from a device which doesn't respond, so tell a missing device from no new sample
+    bus->beginTransmission(SCD30_ADDRESS);
+    uint8_t err = bus->endTransmission();
+    countBusTransfer(0);
+    if(err) {
+      setError(ErrorBus, err);
+    } else {
+      setError(ErrorNoData);
+    }
+    return false;
+  }
+  return finishMeasurement();
+}
+
+bool SCD30Sensor::finishMeasurement() {
+  status = false;
+  co2 = scd30.getCO2();
+  temp = scd30.getTemperature();
+  hum = scd30.getHumidity();
+  if(!co2) {
+    setError(ErrorInvalidSample);
+    return false;
+  }
+  status = true;
+  return true;
+}
+
+static constexpr FieldDescriptor SCD30Fields[] PROGMEM = {
+  temperatureField(),
+  humidityField(),
+  co2Field<SCD30Sensor>()
+};
+
+const FieldDescriptor *SCD30Sensor::getFields(uint8_t &count) {
+  count = SENSOR_FIELDS_COUNT(SCD30Fields);
+  return SCD30Fields;
+}
+
+void SCD30Sensor::printValues(Print &out) {
+  printCo2(out);
+  out.print(' ');
+  printTemperatureHumidity(out);
+}
+
+#endif //SENSORS_INCLUDE_SCD30
@@ -0,0 +1,29 @@
+#ifndef SCD30_SENSOR_H
+#define SCD30_SENSOR_H
+
+#include "SensorBase.h"
+
+#ifdef SENSORS_INCLUDE_SCD30
+#include <Wire.h>
+#include <SparkFun_SCD30_Arduino_Library.h>
+
+class SCD30Sensor : public TemperatureHumiditySensor, public CO2Sensor {
+  protected:
+    SCD30 scd30;
+  public:
+    SCD30Sensor(TwoWire &wire = Wire):TemperatureHumiditySensor("SCD30") { bus = &wire; }
+    virtual bool init() override;
+    virtual bool readValues() override;
+    virtual bool measurementReady() override { return scd30.dataAvailable(); }
+    virtual bool finishMeasurement() override;
+    virtual const FieldDescriptor *getFields(uint8_t &count) override;
+    // Default measurement interval
+    virtual uint32_t getProfileConversionTime(SensorProfile) override { return 2000; }
+    virtual bool isPeriodic() override { return true; }
+  protected:
+    virtual void printValues(Print &out) override;
+};
+
+#endif //SENSORS_INCLUDE_SCD30
+
+#endif //SCD30_SENSOR_H
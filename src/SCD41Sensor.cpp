@@ -0,0 +1,148 @@
+#include "SCD41Sensor.h"
+#include "SensirionCommon.h"
+#include <Wire.h>
+
+#ifdef SENSORS_INCLUDE_SCD41
+
+// ===========  SCD41Sensor  ==================
+
+bool SCD41Sensor::init() {
+  scd4x.begin(*bus);
+  status = true;
+   // stop potentially previously started measurement
+  uint16_t err = scd4x.stopPeriodicMeasurement(); 
+  if(err) {
+    setError(ErrorInit, err);
+    status = false;
+  } else if(profile != ProfileSingleShot) {
+    err = startPeriodic();
+    if (err) {
+      setError(ErrorStart, err);
+      status = false;
+    }
+  }
+  return status;
+}
+
+uint16_t SCD41Sensor::startPeriodic() {
+  return profile == ProfileLowPower?scd4x.startLowPowerPeriodicMeasurement():scd4x.startPeriodicMeasurement();
+}
+
+// Sampling period of periodic modes, single shot takes 5s (SCD4x datasheet, ch3.5, 3.9)
+uint32_t SCD41Sensor::getProfileConversionTime(SensorProfile profile) {
+  return profile == ProfileLowPower?30000:5000;
+}
+
+bool SCD41Sensor::saveState(SensorState &state) {
+  sealState(state, status?SensorStateRunning:0, 0);
+  return true;
+}
+
+// Periodic measurement survives MCU deep sleep, so the stop command with its 500ms wait isn't needed.
+// Start is rejected when measurement is running, otherwise device lost state and start restarts it.
+// In single shot profile device is idle between measurements, it only must respond
+bool SCD41Sensor::resumeState(const SensorState &state) {
+  if(!(state.flags & SensorStateRunning)) {
+    return false;
+  }
+  scd4x.begin(*bus);
+  if(profile == ProfileSingleShot || startPeriodic()) {
+    uint16_t dataReady;
+    if(scd4x.getDataReadyStatus(dataReady)) {
+      return false;
+    }
+  }
+  setError(ErrorNone);
+  status = true;
+  return true;
+}
+
+static const uint8_t SCD41Address = 0x62;
+static const uint16_t SCD41MeasureSingleShot = 0x219D;
+
+bool SCD41Sensor::startMeasurement() {
+  if(profile != ProfileSingleShot) {
+    return true;
+  }
+  // driver's measureSingleShot() blocks until the measurement is done
+  bus->beginTransmission(SCD41Address);
+  bus->write(SCD41MeasureSingleShot >> 8);
+  bus->write(SCD41MeasureSingleShot & 0xFF);
+  uint8_t err = bus->endTransmission();
+  countBusTransfer(2);
+  if(err) {
+    setError(ErrorStart, err);
+    status = false;
+    return false;
+  }
+  conversionStart = sensorsMillis();
+  return true;
+}
+
+bool SCD41Sensor::readValues() {
+  if(profile == ProfileSingleShot) {
+    uint16_t err = scd4x.measureSingleShot();
+    if(err) {
+      setError(ErrorStart, err);
+      status = false;
+      return false;
+    }
+  }
+  return fetchValues();
+}
+
+// Single shot was started by startMeasurement(), so only the result is read
+bool SCD41Sensor::finishMeasurement() {
+  return fetchValues();
+}
+
+bool SCD41Sensor::fetchValues() {
+  uint16_t err = scd4x.readMeasurement(co2, temp, hum); 
+  status = false;
+  if (err) {
+      setError(ErrorRead, err);
+      return false;
+  }
+  if(!co2) {
+    setError(ErrorInvalidSample);
+    return false;
+  }
+  status = true;
+  return true;
+}
+
+bool SCD41Sensor::measurementReady() {
+  // device doesn't acknowledge anything during single shot, so the data ready status can't be polled
+  if(profile == ProfileSingleShot) {
+    return sensorsMillis()-conversionStart > getConversionTime();
+  }
+  uint16_t dataReady;
+  // on error report ready, so readValues() sets error
+  if(scd4x.getDataReadyStatus(dataReady)) {
+    return true;
+  }
+  return (dataReady & 0x07FF) != 0;
+}
+
+void SCD41Sensor::formatErrorDetail(Print &out) {
+  formatSensirionError(out, errorDetail);
+}
+
+static constexpr FieldDescriptor SCD41Fields[] PROGMEM = {
+  temperatureField(),
+  humidityField(),
+  co2Field<SCD41Sensor>()
+};
+
+const FieldDescriptor *SCD41Sensor::getFields(uint8_t &count) {
+  count = SENSOR_FIELDS_COUNT(SCD41Fields);
+  return SCD41Fields;
+}
+
+void SCD41Sensor::printValues(Print &out) {
+  printCo2(out);
+  out.print(' ');
+  printTemperatureHumidity(out);
+}
+
+#endif //SENSORS_INCLUDE_SCD41
@@ -0,0 +1,37 @@
+#ifndef SCD41_SENSOR_H
+#define SCD41_SENSOR_H
+
+#include "SensorBase.h"
+
+#ifdef SENSORS_INCLUDE_SCD41
+#include <Wire.h>
+#include <SensirionI2CScd4x.h>
+
+class SCD41Sensor : public TemperatureHumiditySensor, public CO2Sensor {
+  protected:
+    SensirionI2CScd4x scd4x;
+    uint32_t conversionStart = 0;
+  public:
+    SCD41Sensor(TwoWire &wire = Wire):TemperatureHumiditySensor("SCD41") { bus = &wire; }
+    virtual bool init() override;
+    virtual bool saveState(SensorState &state) override;
+    virtual bool readValues() override;
+    virtual bool startMeasurement() override;
+    virtual bool measurementReady() override;
+    virtual bool finishMeasurement() override;
+    virtual const FieldDescriptor *getFields(uint8_t &count) override;
+    virtual bool supportsProfile(SensorProfile profile) override { return profile != ProfilePrecise; }
+    virtual uint32_t getProfileConversionTime(SensorProfile profile) override;
+    virtual bool isPeriodic() override { return profile != ProfileSingleShot; }
+  protected:
+    uint16_t startPeriodic();
+    // Reads measured values and validates them
+    bool fetchValues();
+    virtual bool resumeState(const SensorState &state) override;
+    virtual void formatErrorDetail(Print &out) override;
+    virtual void printValues(Print &out) override;
+};
+
+#endif //SENSORS_INCLUDE_SCD41
+
+#endif //SCD41_SENSOR_H
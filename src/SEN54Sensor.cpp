@@ -0,0 +1,119 @@
+#include "SEN54Sensor.h"
+#include "SensorsFormat.h"
+#include "SensirionCommon.h"
+#include <Wire.h>
+
+#ifdef SENSORS_INCLUDE_SEN54
+
+static const char Pm1p0[] = "pm1.0";
+static const char Pm2p5[] = "pm2.5";
+static const char Pm4p0[] = "pm4.0";
+static const char Pm10p0[] = "pm10.0";
+
+// ===========  SEN54Sensor  ==================
+
+bool SEN54Sensor::init() {
+  sen5x.begin(*bus);
+  status = true;
+   // stop potentially previously started measurement
+  uint16_t err = sen5x.deviceReset();
+  if(err) {
+    setError(ErrorReset, err);
+    status = false;
+  } else {
+    err = sen5x.startMeasurement();
+    if (err) {
+      setError(ErrorStart, err);
+      status = false;
+    }
+  }
+  return status;
+}
+
+bool SEN54Sensor::saveState(SensorState &state) {
+  if(!status || sen5x.getVocAlgorithmState(state.data, 8)) {
+    state.marker = 0;
+    return false;
+  }
+  sealState(state, SensorStateRunning, 8);
+  return true;
+}
+
+// Without reset. VOC algorithm state can be set only in idle mode, so success means device lost state and measurement
+// is restarted with the saved algorithm state. Otherwise measurement must be still running
+bool SEN54Sensor::resumeState(const SensorState &state) {
+  if(!(state.flags & SensorStateRunning) || state.length != 8) {
+    return false;
+  }
+  sen5x.begin(*bus);
+  if(!sen5x.setVocAlgorithmState(state.data, 8)) {
+    if(sen5x.startMeasurement()) {
+      return false;
+    }
+  } else {
+    bool dataReady;
+    if(sen5x.readDataReady(dataReady)) {
+      return false;
+    }
+  }
+  setError(ErrorNone);
+  status = true;
+  return true;
+}
+
+bool SEN54Sensor::readValues() {
+  float noxIndex;
+  uint16_t err = sen5x.readMeasuredValues(pm1p0, pm2p5, pm4p0,pm10p0, hum, temp, vocIndex, noxIndex);
+  status = false;
+  if (err) {
+      setError(ErrorRead, err);
+      return false;
+  }
+  status = true;
+  return true;
+}
+
+bool SEN54Sensor::measurementReady() {
+  bool dataReady;
+  // on error report ready, so readValues() sets error
+  if(sen5x.readDataReady(dataReady)) {
+    return true;
+  }
+  return dataReady;
+}
+
+void SEN54Sensor::formatErrorDetail(Print &out) {
+  formatSensirionError(out, errorDetail);
+}
+
+static constexpr FieldDescriptor SEN54Fields[] PROGMEM = {
+  temperatureField(),
+  humidityField(),
+  { Voc, UnitVoc, fieldValue<SEN54Sensor, float SEN54Sensor::*, &SEN54Sensor::vocIndex>, CapVoc, FieldFloat, 3, 0, 0 },
+  { Pm1p0, nullptr, fieldValue<SEN54Sensor, float SEN54Sensor::*, &SEN54Sensor::pm1p0>, 0, FieldFloat, 2, 1, 0 },
+  { Pm2p5, nullptr, fieldValue<SEN54Sensor, float SEN54Sensor::*, &SEN54Sensor::pm2p5>, CapDustPPM, FieldFloat, 2, 1, 0 },
+  { Pm4p0, nullptr, fieldValue<SEN54Sensor, float SEN54Sensor::*, &SEN54Sensor::pm4p0>, 0, FieldFloat, 2, 1, 0 },
+  { Pm10p0, nullptr, fieldValue<SEN54Sensor, float SEN54Sensor::*, &SEN54Sensor::pm10p0>, 0, FieldFloat, 2, 1, 0 }
+};
+
+const FieldDescriptor *SEN54Sensor::getFields(uint8_t &count) {
+  count = SENSOR_FIELDS_COUNT(SEN54Fields);
+  return SEN54Fields;
+}
+
+void SEN54Sensor::printValues(Print &out) {
+  out.print(' ');
+  printFixed(out, vocIndex, 3, 0);
+  out.print(F("voc, pm1 "));
+  printFixed(out, pm1p0, 2, 1);
+  out.print(F(", pm2.5 "));
+  printFixed(out, pm2p5, 2, 1);
+  out.print(F(",pm4 "));
+  printFixed(out, pm4p0, 2, 1);
+  out.print(F(",pm10 "));
+  printFixed(out, pm10p0, 2, 1);
+  out.print(' ');
+  printTemperatureHumidity(out);
+}
+
+#endif //SENSORS_INCLUDE_SEN54
@@ -0,0 +1,37 @@
+#ifndef SEN54_SENSOR_H
+#define SEN54_SENSOR_H
+
+#include "SensorBase.h"
+
+#ifdef SENSORS_INCLUDE_SEN54
+#include <Wire.h>
+#include <SensirionI2CSen5x.h>
+
+class SEN54Sensor : public TemperatureHumiditySensor {
+  protected:
+    SensirionI2CSen5x sen5x;
+  public:
+    float pm1p0;
+    float pm2p5;
+    float pm4p0;
+    float pm10p0;
+    float vocIndex;
+  public:
+    SEN54Sensor(TwoWire &wire = Wire):TemperatureHumiditySensor("SEN54") { bus = &wire; }
+    virtual bool init() override;
+    // Keeps also VOC algorithm state, so VOC index doesn't start learning again when device was reset
+    virtual bool saveState(SensorState &state) override;
+    virtual bool readValues() override;
+    virtual bool measurementReady() override;
+    virtual const FieldDescriptor *getFields(uint8_t &count) override;
+    virtual uint32_t getProfileConversionTime(SensorProfile) override { return 1000; }
+    virtual bool isPeriodic() override { return true; }
+  protected:
+    virtual bool resumeState(const SensorState &state) override;
+    virtual void formatErrorDetail(Print &out) override;
+    virtual void printValues(Print &out) override;
+};
+
+#endif //SENSORS_INCLUDE_SEN54
+
+#endif //SEN54_SENSOR_H
@@ -0,0 +1,44 @@
+#include "SGP40Sensor.h"
+#include "SensirionCommon.h"
+
+#ifdef SENSORS_INCLUDE_SGP40
+
+// ===========  SGP40Sensor  ==================
+
+bool SGP40Sensor::init() {
+  status = sgp.begin(bus);
+  if(!status) {
+    setError(ErrorInit);
+  }
+  return status;
+}
+
+bool SGP40Sensor::readValues(float temp, float hum) {
+  uint16_t raw = sgp.measureRaw(temp, hum);
+  // library returns 0 on I2C or CRC failure, it's never a valid signal. Algorithm must not learn it
+  if(!raw) {
+    setError(ErrorRead);
+    status = false;
+    return false;
+  }
+  vocRaw = raw;
+  vocIndex = vocAlgorithm.process(vocRaw);
+  status = true;
+  return true;
+}
+
+bool SGP40Sensor::saveState(SensorState &state) {
+  saveGasIndexState(vocAlgorithm, state, 0);
+  sealState(state, 0, 8);
+  return true;
+}
+
+// Device has no runtime state, only the algorithm is restored and init() follows
+bool SGP40Sensor::resumeState(const SensorState &state) {
+  if(state.length == 8) {
+    restoreGasIndexState(vocAlgorithm, state, 0);
+  }
+  return false;
+}
+
+#endif //SENSORS_INCLUDE_SGP40
@@ -0,0 +1,33 @@
+#ifndef SGP40_SENSOR_H
+#define SGP40_SENSOR_H
+
+#include "SensorBase.h"
+
+#ifdef SENSORS_INCLUDE_SGP40
+#include <Wire.h>
+#include <Adafruit_SGP40.h>
+#include "GasIndex.h"
+
+// VOC index is computed by GasIndexAlgorithm, so readValues() must be called in the sampling interval (seconds)
+class SGP40Sensor : public VOCSensor {
+  protected:
+    Adafruit_SGP40 sgp;
+    GasIndexAlgorithm vocAlgorithm;
+    float compTemp = 25;
+    float compHum = 50;
+  public:
+    SGP40Sensor(float samplingInterval = 1, TwoWire &wire = Wire):VOCSensor("SGP40"),vocAlgorithm(GasIndexVoc, samplingInterval) { bus = &wire; }
+    virtual bool init() override;
+    // Keeps VOC algorithm state, so index doesn't start learning again
+    virtual bool saveState(SensorState &state) override;
+    // Reads values compensated by temperature and humidity set by setCompensation()
+    virtual bool readValues() override { return readValues(compTemp, compHum); }
+    bool readValues(float temp, float hum);
+    void setCompensation(float temp, float hum) { compTemp = temp; compHum = hum; }
+  protected:
+    virtual bool resumeState(const SensorState &state) override;
+};
+
+#endif //SENSORS_INCLUDE_SGP40
+
+#endif //SGP40_SENSOR_H
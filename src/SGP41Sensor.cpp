@@ -0,0 +1,145 @@
+#include "SGP41Sensor.h"
+#include "SensorsFormat.h"
+#include "SensirionCommon.h"
+#include <Wire.h>
+
+#ifdef SENSORS_INCLUDE_SGP41
+
+static const char Nox[] = "nox";
+static const char NoxGasResistance[] = "nox_gas_resistance";
+static const char UnitNox[] = "nox";
+
+// ===========  SGP41Sensor  ==================
+
+static const uint16_t DefaultRh = 0x8000;
+static const uint16_t DefaultT = 0x6666; 
+
+bool SGP41Sensor::init() {
+  uint16_t testResult;
+  _sgp41.begin(*bus);
+  uint16_t err = _sgp41.executeSelfTest(testResult); 
+  status = false;
+  if (err) {
+      setError(ErrorInit, err);
+    } else if (testResult != 0xD400) {
+      setError(ErrorSelfTest, testResult);
+    } else {
+      status = true;
+    }
+  return status;
+}
+
+bool SGP41Sensor::saveState(SensorState &state) {
+  saveGasIndexState(vocAlgorithm, state, 0);
+  saveGasIndexState(noxAlgorithm, state, 8);
+  sealState(state, conditioned?SensorStateRunning:0, 16);
+  return true;
+}
+
+// Heater stays on during MCU deep sleep, so conditioning and self test are skipped when device still responds
+bool SGP41Sensor::resumeState(const SensorState &state) {
+  if(state.length == 16) {
+    restoreGasIndexState(vocAlgorithm, state, 0);
+    restoreGasIndexState(noxAlgorithm, state, 8);
+  }
+  if(!(state.flags & SensorStateRunning)) {
+    return false;
+  }
+  uint16_t serial[3];
+  _sgp41.begin(*bus);
+  if(_sgp41.getSerialNumber(serial, 3)) {
+    return false;
+  }
+  conditioned = true;
+  setError(ErrorNone);
+  status = true;
+  return true;
+}
+
+void SGP41Sensor::formatErrorDetail(Print &out) {
+  if(errorCode == ErrorSelfTest) {
+    out.print(errorDetail, HEX);
+  } else {
+    formatSensirionError(out, errorDetail);
+  }
+}
+
+// Missing compensation (NAN, e.g. from a failed sensor) is replaced by the default one
+uint16_t SGP41Sensor::temperatureTicks(float temp) {
+  if(isnan(temp)) {
+    return DefaultT;
+  }
+  return constrain((temp + 45) * 65535 / 175, 0, 65535);
+}
+
+uint16_t SGP41Sensor::humidityTicks(float hum) {
+  if(isnan(hum)) {
+    return DefaultRh;
+  }
+  return constrain(hum * 65535 / 100, 0, 65535);
+}
+
+// NAN doesn't equal itself, so repeated missing compensation is compared by isnan()
+static bool sameCompensation(float value, float last) {
+  return value == last || (isnan(value) && isnan(last));
+}
+
+bool SGP41Sensor::readValues(float temp, float hum) {
+  // compensation usually repeats between samples, e.g. when it comes from a slower sensor
+  if(!sameCompensation(temp, lastTemp)) {
+    lastTemp = temp;
+    lastTempTicks = temperatureTicks(temp);
+  }
+  if(!sameCompensation(hum, lastHum)) {
+    lastHum = hum;
+    lastHumTicks = humidityTicks(hum);
+  }
+  return readTicks(lastHumTicks, lastTempTicks);
+}
+
+bool SGP41Sensor::readTicks(uint16_t humTicks, uint16_t tempTicks) {
+  uint16_t err;
+  bool measured = false;
+  if(!conditioned && (!_timer || ((sensorsMillis()-_timer)/1000)<_conditioning_s)) {
+    if(!_timer) {
+      _timer = sensorsMillis();
+    }
+    err = _sgp41.executeConditioning(DefaultRh, DefaultT, vocRaw); 
+  } else {
+    conditioned = true;
+    err = _sgp41.measureRawSignals(humTicks, tempTicks, vocRaw, noxRaw);
+    measured = true;
+  }
+  status = true;
+  if(err) {
+    setError(ErrorRead, err);
+    status = false;
+  } else if(measured) {
+    vocIndex = vocAlgorithm.process(vocRaw);
+    noxIndex = noxAlgorithm.process(noxRaw);
+  }
+  return status;
+}
+
+static constexpr FieldDescriptor SGP41Fields[] PROGMEM = {
+  vocIndexField(),
+  vocRawField(),
+  { Nox, UnitNox, fieldValue<SGP41Sensor, uint16_t SGP41Sensor::*, &SGP41Sensor::noxIndex>, 0, FieldFloat, 3, 0, 0 },
+  { NoxGasResistance, UnitRaw, fieldValue<SGP41Sensor, uint16_t SGP41Sensor::*, &SGP41Sensor::noxRaw>, 0, FieldFloat, 6, 0, 0 }
+};
+
+const FieldDescriptor *SGP41Sensor::getFields(uint8_t &count) {
+  count = SENSOR_FIELDS_COUNT(SGP41Fields);
+  return SGP41Fields;
+}
+
+void SGP41Sensor::printValues(Print &out) {
+  VOCSensor::printValues(out);
+  out.print(F(" nox: "));
+  printInt(out, noxRaw, 6);
+  out.print(F("r "));
+  printInt(out, noxIndex, 3);
+  out.print('v');
+}
+
+#endif //SENSORS_INCLUDE_SGP41
@@ -0,0 +1,54 @@
+#ifndef SGP41_SENSOR_H
+#define SGP41_SENSOR_H
+
+#include "SensorBase.h"
+
+#ifdef SENSORS_INCLUDE_SGP41
+#include <Wire.h>
+#include <SensirionI2CSgp41.h>
+#include "GasIndex.h"
+
+// VOC and NOx indexes are computed by GasIndexAlgorithm, so readValues() must be called in the sampling interval (seconds)
+class SGP41Sensor : public VOCSensor {
+  protected:
+    SensirionI2CSgp41 _sgp41;
+    uint16_t _conditioning_s = 10;
+    uint32_t _timer = 0;
+    bool conditioned = false;
+    // compensation in sensor ticks
+    uint16_t compTempTicks = 0x6666;
+    uint16_t compHumTicks = 0x8000;
+    // last values passed to readValues(temp, hum) and their ticks, converted only when they change. NAN has default ticks
+    float lastTemp = NAN;
+    float lastHum = NAN;
+    uint16_t lastTempTicks = 0x6666;
+    uint16_t lastHumTicks = 0x8000;
+    GasIndexAlgorithm vocAlgorithm;
+    GasIndexAlgorithm noxAlgorithm;
+  public:
+    uint16_t noxRaw = 0;
+    uint16_t noxIndex = 0;
+  public:
+    SGP41Sensor(float samplingInterval = 1, TwoWire &wire = Wire):VOCSensor("SGP41"),
+      vocAlgorithm(GasIndexVoc, samplingInterval),noxAlgorithm(GasIndexNox, samplingInterval) { bus = &wire; }
+    virtual bool init() override;
+    // Keeps also VOC and NOx algorithm states, so indexes don't start learning again
+    virtual bool saveState(SensorState &state) override;
+    virtual const FieldDescriptor *getFields(uint8_t &count) override;
+    // Reads values compensated by temperature and humidity set by setCompensation()
+    virtual bool readValues() override { return readTicks(compHumTicks, compTempTicks); }
+    bool readValues(float temp, float hum);
+    void setCompensation(float temp, float hum) { compTempTicks = temperatureTicks(temp); compHumTicks = humidityTicks(hum); }
+    using Sensor::formatValues;
+  protected:
+    bool readTicks(uint16_t humTicks, uint16_t tempTicks);
+    static uint16_t temperatureTicks(float temp);
+    static uint16_t humidityTicks(float hum);
+    virtual bool resumeState(const SensorState &state) override;
+    virtual void formatErrorDetail(Print &out) override;
+    virtual void printValues(Print &out) override;
+};
+
+#endif //SENSORS_INCLUDE_SGP41
+
+#endif //SGP41_SENSOR_H
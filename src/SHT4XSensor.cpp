@@ -0,0 +1,107 @@
+#include "SHT4XSensor.h"
+#include <Wire.h>
+
+#ifdef SENSORS_INCLUDE_SHT4X
+
+// ===========  SHT4XSensor  ==================
+
+bool SHT4XSensor::init() {
+  status = true;
+  sht4x.begin(*bus);
+  uint32_t serialNumber;
+  uint16_t err =sht4x.serialNumber(serialNumber);
+  if(err) {
+    setError(ErrorInit, err);
+    status = false;
+  } 
+  return status;
+}
+
+bool SHT4XSensor::readValues() {
+  status = false;
+  float t;
+  float h;
+  uint16_t err;
+  switch(profile) {
+    case ProfileFastest:
+    case ProfileLowPower:
+      err = sht4x.measureLowestPrecision(t,h);
+      break;
+    default:
+      err = sht4x.measureHighPrecision(t,h);
+  }
+  if(!err) {
+    if (!isnan(t)) {  // check if 'is not a number'
+      temp = t;
+    } else { 
+      setError(ErrorTemperature);
+      return false;
+    }
+    
+    if (!isnan(h)) {  // check if 'is not a number'
+      hum = h; 
+    } else { 
+      setError(ErrorHumidity);
+      return false;
+    }
+  } else {
+    setError(ErrorRead, err);
+    return false;
+  }
+  setError(ErrorNone);
+  status = true;
+  return true;
+}
+
+static const uint8_t SHT4XAddress = 0x44;
+static const uint8_t SHT4XMeasureHighPrecision = 0xFD;
+static const uint8_t SHT4XMeasureLowestPrecision = 0xE0;
+
+// Max duration of high and lowest precision measurement (SHT4x datasheet, ch3.1). Every measurement is single shot
+uint32_t SHT4XSensor::getProfileConversionTime(SensorProfile profile) {
+  return profile == ProfileFastest || profile == ProfileLowPower?2:9;
+}
+
+bool SHT4XSensor::startMeasurement() {
+  bus->beginTransmission(SHT4XAddress);
+  bus->write(profile == ProfileFastest || profile == ProfileLowPower?SHT4XMeasureLowestPrecision:SHT4XMeasureHighPrecision);
+  uint8_t err = bus->endTransmission();
+  countBusTransfer(1);
+  if(err) {
+    setError(ErrorRead, err);
+    status = false;
+    return false;
+  }
+  conversionStart = sensorsMillis();
+  return true;
+}
+
+bool SHT4XSensor::measurementReady() {
+  return sensorsMillis()-conversionStart > getConversionTime();
+}
+
+bool SHT4XSensor::finishMeasurement() {
+  uint8_t buff[6];
+  status = false;
+  uint8_t received = bus->requestFrom(SHT4XAddress, (uint8_t)6);
+  countBusTransfer(received);
+  if(received != 6) {
+    // no byte means device didn't acknowledge its address
+    setError(received?ErrorRead:ErrorBus, received);
+    return false;
+  }
+  for(uint8_t i=0;i<6;i++) {
+    buff[i] = bus->read();
+  }
+  if(sensorsCrc8(buff, 2, 0xFF) != buff[2] || sensorsCrc8(buff+3, 2, 0xFF) != buff[5]) {
+    setError(ErrorCrc);
+    return false;
+  }
+  temp = ((buff[0] << 8) | buff[1]) * 175.0 / 65535.0 - 45.0;
+  hum = ((buff[3] << 8) | buff[4]) * 125.0 / 65535.0 - 6.0;
+  setError(ErrorNone);
+  status = true;
+  return true;
+}
+
+#endif //SENSORS_INCLUDE_SHT4X
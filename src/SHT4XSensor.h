@@ -0,0 +1,27 @@
+#ifndef SHT4X_SENSOR_H
+#define SHT4X_SENSOR_H
+
+#include "SensorBase.h"
+
+#ifdef SENSORS_INCLUDE_SHT4X
+#include <Wire.h>
+#include <SensirionI2CSht4x.h>
+
+class SHT4XSensor : public TemperatureHumiditySensor {
+  protected:
+   SensirionI2CSht4x sht4x;
+   uint32_t conversionStart = 0;
+  public:
+    SHT4XSensor(TwoWire &wire = Wire):TemperatureHumiditySensor("SHT4X") { bus = &wire; }
+    virtual bool init() override;
+    virtual bool readValues() override;
+    virtual bool startMeasurement() override;
+    virtual bool measurementReady() override;
+    virtual bool finishMeasurement() override;
+    virtual bool supportsProfile(SensorProfile) override { return true; }
+    virtual uint32_t getProfileConversionTime(SensorProfile profile) override;
+};
+
+#endif //SENSORS_INCLUDE_SHT4X
+
+#endif //SHT4X_SENSOR_H
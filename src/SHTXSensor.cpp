@@ -0,0 +1,54 @@
+#include "SHTXSensor.h"
+
+#ifdef SENSORS_INCLUDE_SHTX
+
+// ===========  SHTXSensor  ==================
+
+bool SHTXSensor::init() {
+  status = true;
+  // arduino-sht returns true on success
+  if(!sht.init(*bus)) {
+    // detail must be non zero to be printed, type AUTO_DETECT is 0
+    setError(ErrorInit, sht.mSensorType + 1);
+    status = false;
+  } 
+  return status;
+}
+
+void SHTXSensor::formatErrorDetail(Print &out) {
+  if(errorCode == ErrorInit) {
+    out.print(F("type: "));
+    out.print(errorDetail - 1);
+    return;
+  }
+  Sensor::formatErrorDetail(out);
+}
+
+bool SHTXSensor::readValues() {
+  status = false;
+  if(sht.readSample()) {
+    float t = sht.getTemperature();
+    float h = sht.getHumidity();
+    if (!isnan(t)) {  // check if 'is not a number'
+      temp = t;
+    } else { 
+      setError(ErrorTemperature);
+      return false;
+    }
+    
+    if (!isnan(h)) {  // check if 'is not a number'
+      hum = h; 
+    } else { 
+      setError(ErrorHumidity);
+      return false;
+    }
+  } else {
+    setError(ErrorRead);
+    return false;
+  }
+  setError(ErrorNone);
+  status = true;
+  return true;
+}
+
+#endif //SENSORS_INCLUDE_SHTX
@@ -0,0 +1,33 @@
+#ifndef SHTX_SENSOR_H
+#define SHTX_SENSOR_H
+
+#include "SensorBase.h"
+
+#ifdef SENSORS_INCLUDE_SHTX
+#include <Wire.h>
+#include <SHTSensor.h>
+
+class SHTXSensor : public TemperatureHumiditySensor {
+  protected:
+    SHTSensor sht;
+  public:
+    SHTXSensor(const char *name, SHTSensor::SHTSensorType typ, TwoWire &wire = Wire):TemperatureHumiditySensor(name),sht(typ) { bus = &wire; }
+    virtual bool init() override;
+    virtual bool readValues() override;
+  protected:
+    virtual void formatErrorDetail(Print &out) override;
+};
+
+class SHT31Sensor : public SHTXSensor {
+  public:
+    SHT31Sensor(TwoWire &wire = Wire):SHTXSensor("SHT31", SHTSensor::SHT3X, wire) {}
+};
+
+class SHTC3Sensor : public SHTXSensor {
+  public:
+    SHTC3Sensor(TwoWire &wire = Wire):SHTXSensor("SHTC3", SHTSensor::SHTC3, wire) {}
+};
+
+#endif //SENSORS_INCLUDE_SHTX
+
+#endif //SHTX_SENSOR_H
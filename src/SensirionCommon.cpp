@@ -0,0 +1,30 @@
+#include "SensirionCommon.h"
+
+#if defined(SENSORS_INCLUDE_SCD41) || defined(SENSORS_INCLUDE_SEN54) || defined(SENSORS_INCLUDE_SGP41)
+#include <SensirionCore.h>
+
+void formatSensirionError(Print &out, uint16_t err) {
+  char buff[64];
+  errorToString(err, buff, sizeof(buff));
+  out.print(buff);
+}
+#endif
+
+#if defined(SENSORS_INCLUDE_SGP40) || defined(SENSORS_INCLUDE_SGP41)
+// Std of a learned state is never 0, zero marks state not learned yet, which is not restored
+void saveGasIndexState(const GasIndexAlgorithm &algorithm, SensorState &state, uint8_t offset) {
+  int32_t values[2] = { 0, 0 };
+  if(algorithm.isLearned()) {
+    algorithm.getState(values[0], values[1]);
+  }
+  memcpy(state.data + offset, values, sizeof(values));
+}
+
+void restoreGasIndexState(GasIndexAlgorithm &algorithm, const SensorState &state, uint8_t offset) {
+  int32_t values[2];
+  memcpy(values, state.data + offset, sizeof(values));
+  if(values[1]) {
+    algorithm.setState(values[0], values[1]);
+  }
+}
+#endif
@@ -0,0 +1,19 @@
+#ifndef SENSIRION_COMMON_H
+#define SENSIRION_COMMON_H
+
+#include "SensorBase.h"
+
+#if defined(SENSORS_INCLUDE_SCD41) || defined(SENSORS_INCLUDE_SEN54) || defined(SENSORS_INCLUDE_SGP41)
+// Appends description of error code returned by Sensirion drivers
+void formatSensirionError(Print &out, uint16_t err);
+#endif
+
+#if defined(SENSORS_INCLUDE_SGP40) || defined(SENSORS_INCLUDE_SGP41)
+#include "GasIndex.h"
+
+// Stores state of a gas index algorithm at the offset of state data
+void saveGasIndexState(const GasIndexAlgorithm &algorithm, SensorState &state, uint8_t offset);
+void restoreGasIndexState(GasIndexAlgorithm &algorithm, const SensorState &state, uint8_t offset);
+#endif
+
+#endif //SENSIRION_COMMON_H
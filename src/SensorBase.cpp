@@ -0,0 +1,968 @@
+#include "SensorBase.h"
+#include "SensorsFormat.h"
+
+// Keys are arrays, so their addresses can be used in constant field tables
+const char Temp[] = "temp";
+const char Hum[] = "hum";
+const char Press[] = "press";
+const char PressRaw[] = "press_raw";
+const char Co2[] = "co2";
+const char Moist[] = "moist";
+const char Voc[] = "voc";
+const char GasResistance[] = "gas_resistance";
+const char Light[] = "light";
+
+const char UnitCelsius[] = "°C";
+const char UnitPercent[] = "%";
+const char UnitHectoPascal[] = "hPa";
+const char UnitPpm[] = "ppm";
+static const char UnitLux[] = "lux";
+const char UnitVoc[] = "voc";
+const char UnitRaw[] = "raw";
+
+static uint32_t defaultClock() {
+  return millis();
+}
+
+static SensorsClock sensorsClock = defaultClock;
+
+void setSensorsClock(SensorsClock clock) {
+  sensorsClock = clock?clock:defaultClock;
+}
+
+uint32_t sensorsMillis() {
+  return sensorsClock();
+}
+
+static SensorHealthCallback healthCallback = nullptr;
+
+void setSensorHealthCallback(SensorHealthCallback callback) {
+  healthCallback = callback;
+}
+
+uint8_t sensorsCrc8(const uint8_t *data, uint8_t len, uint8_t init) {
+  uint8_t crc = init;
+  for(uint8_t i=0;i<len;i++) {
+    crc ^= data[i];
+    for(uint8_t b=0;b<8;b++) {
+      crc = crc & 0x80?(crc << 1) ^ 0x31:crc << 1;
+    }
+  }
+  return crc;
+}
+
+String Sensor::toString() {
+  String ret;
+  ret.reserve(30);
+  StringPrint out(ret);
+  printTo(out);
+  return ret;
+}
+
+void Sensor::printTo(Print &out) {
+  out.print(name.c_str());
+  out.print(F(": "));
+  if(status) {
+    printValues(out);
+  } else {
+    out.print(F("ERR: "));
+    printError(out);
+  }
+}
+
+size_t Sensor::toString(char *buffer, size_t size) {
+  BufferPrint out(buffer, size);
+  printTo(out);
+  return out.length();
+}
+
+String Sensor::formatValues() {
+  String ret;
+  StringPrint out(ret);
+  printValues(out);
+  return ret;
+}
+
+static const char ErrorMessage0[] PROGMEM = "";
+static const char ErrorMessage1[] PROGMEM = "init err";
+static const char ErrorMessage2[] PROGMEM = "start err";
+static const char ErrorMessage3[] PROGMEM = "reset err";
+static const char ErrorMessage4[] PROGMEM = "read err";
+static const char ErrorMessage5[] PROGMEM = "temp error";
+static const char ErrorMessage6[] PROGMEM = "hum error";
+static const char ErrorMessage7[] PROGMEM = "press error";
+static const char ErrorMessage8[] PROGMEM = "read err: invalid sample detected";
+static const char ErrorMessage9[] PROGMEM = "waiting for (new) data";
+static const char ErrorMessage10[] PROGMEM = "read err: crc";
+static const char ErrorMessage11[] PROGMEM = "no device found";
+static const char ErrorMessage12[] PROGMEM = "self test err";
+static const char ErrorMessage13[] PROGMEM = "I2C error";
+static const char ErrorMessage14[] PROGMEM = "measurement timeout";
+
+static const char *const ErrorMessages[] PROGMEM = {
+  ErrorMessage0, ErrorMessage1, ErrorMessage2, ErrorMessage3, ErrorMessage4, ErrorMessage5, ErrorMessage6, ErrorMessage7,
+  ErrorMessage8, ErrorMessage9, ErrorMessage10, ErrorMessage11, ErrorMessage12, ErrorMessage13, ErrorMessage14
+};
+
+String Sensor::getError() {
+  String ret;
+  if(errorCode == ErrorNone) {
+    return ret;
+  }
+  ret.reserve(40);
+  StringPrint out(ret);
+  printError(out);
+  return ret;
+}
+
+void Sensor::printError(Print &out) {
+  if(errorCode == ErrorNone) {
+    return;
+  }
+  out.print(name.c_str());
+  out.print(' ');
+  out.print(FPSTR(pgm_read_ptr(&ErrorMessages[errorCode < ErrorCount?errorCode:ErrorRead])));
+  if(errorDetail) {
+    out.print(F(": "));
+    formatErrorDetail(out);
+  }
+}
+
+void Sensor::formatErrorDetail(Print &out) {
+  out.print(errorDetail);
+}
+
+bool Sensor::setProfile(SensorProfile profile) {
+  if(!supportsProfile(profile)) {
+    return false;
+  }
+  this->profile = profile;
+  return true;
+}
+
+// Marks valid saved state
+static const uint8_t SensorStateMarker = 0x5A;
+
+bool Sensor::saveState(SensorState &state) {
+  state.marker = 0;
+  return false;
+}
+
+void Sensor::sealState(SensorState &state, uint8_t flags, uint8_t length) {
+  state.flags = flags;
+  state.length = length;
+  state.marker = SensorStateMarker;
+  state.crc = sensorsCrc8(&state.flags, length + 2, 0xFF);
+}
+
+bool Sensor::resume(const SensorState &state) {
+  uint32_t start = micros();
+  if(state.marker == SensorStateMarker && state.length <= SENSOR_STATE_DATA_SIZE
+    && state.crc == sensorsCrc8(&state.flags, state.length + 2, 0xFF) && resumeState(state)) {
+    // resuming replaces init() of this boot, so it's recorded as one
+    return recordInit(status, start);
+  }
+  return begin();
+}
+
+bool Sensor::begin() {
+  uint32_t start = micros();
+  return recordInit(init(), start);
+}
+
+bool Sensor::read() {
+  if(!checkHealth()) {
+    return false;
+  }
+  uint32_t start = micros();
+  return recordRead(readValues(), start);
+}
+
+void Sensor::storeValues(Point &point) {
+  PointFieldSink sink(point);
+  writeFields(sink);
+}
+
+// ===========  Field tables  ==================
+
+void Sensor::writeFields(FieldSink &sink) {
+  uint8_t count;
+  const FieldDescriptor *fields = getFields(count);
+  FieldDescriptor field;
+  for(uint8_t i=0;i<count;i++) {
+    readFieldDescriptor(fields, i, field);
+    float value = field.access(*this, nullptr);
+    if(field.type == FieldInt) {
+      sink.addField(field.key, (int32_t)lroundf(value));
+    } else {
+      sink.addField(field.key, value);
+    }
+  }
+}
+
+void Sensor::printValues(Print &out) {
+  uint8_t count;
+  const FieldDescriptor *fields = getFields(count);
+  printFields(out, fields, count);
+}
+
+void Sensor::printFields(Print &out, const FieldDescriptor *fields, uint8_t count) {
+  FieldDescriptor field;
+  bool first = true;
+  for(uint8_t i=0;i<count;i++) {
+    readFieldDescriptor(fields, i, field);
+    if(field.flags & FieldHidden) {
+      continue;
+    }
+    if(!first) {
+      out.print(F("  "));
+    }
+    first = false;
+    printFixed(out, field.access(*this, nullptr), field.width, field.precision);
+    if(field.unit) {
+      out.print(field.unit);
+    }
+  }
+}
+
+uint16_t Sensor::getCapabilities() {
+  uint8_t count;
+  const FieldDescriptor *fields = getFields(count);
+  uint16_t caps = 0;
+  for(uint8_t i=0;i<count;i++) {
+    caps |= pgm_read_word(&fields[i].capability);
+  }
+  return caps;
+}
+
+bool Sensor::setField(const char *key, float value) {
+  uint8_t count;
+  const FieldDescriptor *fields = getFields(count);
+  FieldDescriptor field;
+  for(uint8_t i=0;i<count;i++) {
+    readFieldDescriptor(fields, i, field);
+    // keys are interned, so compare pointers first
+    if(field.key == key || !strcmp(key, field.key)) {
+      field.access(*this, &value);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Sensor::getValue(SensorCapability capability, float &value) {
+  uint8_t count;
+  const FieldDescriptor *fields = getFields(count);
+  for(uint8_t i=0;i<count;i++) {
+    if(pgm_read_word(&fields[i].capability) & capability) {
+      FieldDescriptor field;
+      readFieldDescriptor(fields, i, field);
+      value = field.access(*this, nullptr);
+      return true;
+    }
+  }
+  return false;
+}
+
+uint8_t Sensor::readAll(Sensor *sensors[], uint8_t count, uint32_t timeout, uint32_t *finishTimes) {
+  uint8_t pending = 0;
+  for(uint8_t i=0;i<count;i++) {
+    Sensor *s = sensors[i];
+    if(!s->checkHealth()) {
+      s->measuring = false;
+    } else {
+      s->measureStart = micros();
+      s->measuring = s->startMeasurement();
+      s->startPolling(timeout);
+      if(!s->measuring) {
+        s->recordRead(false, s->measureStart);
+      }
+    }
+    if(s->measuring) {
+      pending++;
+    } else if(finishTimes) {
+      finishTimes[i] = sensorsMillis();
+    }
+  }
+  uint8_t ok = 0;
+  while(pending) {
+    uint32_t now = sensorsMillis();
+    uint32_t wait = SENSOR_POLL_INTERVAL;
+    for(uint8_t i=0;i<count;i++) {
+      Sensor *s = sensors[i];
+      if(!s->measuring || !s->pollDue(now, wait)) {
+        continue;
+      }
+      if(s->measurementReady()) {
+        if(s->recordRead(s->finishMeasurement(), s->measureStart)) {
+          ok++;
+        }
+      } else if(s->pollTimedOut(now)) {
+        s->setError(ErrorTimeout);
+        s->status = false;
+        s->recordRead(false, s->measureStart);
+      } else {
+        s->schedulePoll(now, wait);
+        continue;
+      }
+      s->measuring = false;
+      pending--;
+      if(finishTimes) {
+        finishTimes[i] = sensorsMillis();
+      }
+    }
+    if(pending) {
+      waitForPoll(wait);
+    }
+  }
+  return ok;
+}
+
+void Sensor::startPolling(uint32_t timeout) {
+  uint32_t conversionTime = getConversionTime();
+  if(conversionTime && conversionTime + SENSOR_TIMEOUT_MARGIN > timeout) {
+    timeout = conversionTime + SENSOR_TIMEOUT_MARGIN;
+  }
+  nextPoll = sensorsMillis();
+  pollDeadline = nextPoll + timeout;
+}
+
+bool Sensor::pollDue(uint32_t now, uint32_t &wait) const {
+  int32_t left = (int32_t)(nextPoll-now);
+  int32_t timeoutLeft = (int32_t)(pollDeadline-now);
+  if(timeoutLeft < left) {
+    left = timeoutLeft;
+  }
+  if(left <= 0) {
+    return true;
+  }
+  if((uint32_t)left < wait) {
+    wait = left;
+  }
+  return false;
+}
+
+void Sensor::schedulePoll(uint32_t now, uint32_t &wait) {
+  uint32_t conversionTime = getConversionTime();
+  uint32_t interval = conversionTime && conversionTime < SENSOR_POLL_INTERVAL?conversionTime+1:SENSOR_POLL_INTERVAL;
+  nextPoll = now+interval;
+  if(interval < wait) {
+    wait = interval;
+  }
+}
+
+void Sensor::waitForPoll(uint32_t wait) {
+  if(wait) {
+    delay(wait);
+  } else {
+    yield();
+  }
+}
+
+// ===========  Stats  ==================
+
+void LatencyHistogram::add(uint32_t us) {
+  uint8_t bucket = us?32-__builtin_clz(us):0;
+  if(bucket >= SENSOR_STATS_BUCKETS) {
+    bucket = SENSOR_STATS_BUCKETS-1;
+  }
+  // saturate, so a long running counter does not wrap to a small number
+  if(buckets[bucket] != UINT16_MAX) {
+    buckets[bucket]++;
+  }
+  count++;
+  sum += us;
+  if(us > max) {
+    max = us;
+  }
+}
+
+uint32_t LatencyHistogram::quantile(float q) const {
+  // buckets may be saturated, so rank is computed from them rather than from count
+  uint32_t total = 0;
+  for(uint8_t i=0;i<SENSOR_STATS_BUCKETS;i++) {
+    total += buckets[i];
+  }
+  if(!total) {
+    return 0;
+  }
+  uint32_t rank = (uint32_t)ceilf(q*total);
+  if(rank < 1) {
+    rank = 1;
+  }
+  uint32_t seen = 0;
+  for(uint8_t i=0;i<SENSOR_STATS_BUCKETS-1;i++) {
+    seen += buckets[i];
+    if(seen >= rank) {
+      uint32_t upper = i?(1UL << i)-1:0;
+      return upper < max?upper:max;
+    }
+  }
+  return max;
+}
+
+bool Sensor::recordInit(bool ok, uint32_t startMicros) {
+  stats.init.add(micros()-startMicros);
+  if(!ok) {
+    stats.errors[errorCode < ErrorCount && errorCode != ErrorNone?errorCode:ErrorInit]++;
+    quarantine();
+  } else if(health == HealthQuarantined) {
+    // backoff is kept until a successful read, so a single failed read quarantines the sensor again with a longer backoff
+    failures = SENSOR_QUARANTINE_FAILURES-1;
+    setHealth(HealthDegraded);
+  } else {
+    // periodic device delivers the first sample after its interval, re-init after quarantine doesn't renew the grace
+    lastSampleTime = sensorsMillis();
+  }
+  return ok;
+}
+
+// Only successful reads enter the histogram, so timeouts do not hide latency of the device
+bool Sensor::recordRead(bool ok, uint32_t startMicros) {
+  if(ok) {
+    stats.read.add(micros()-startMicros);
+    stats.readOk++;
+    if(processor) {
+      processor->process(*this);
+    }
+    publishSnapshot();
+    lastSampleTime = sensorsMillis();
+    failures = 0;
+    backoff = 0;
+    setHealth(HealthOk);
+  } else {
+    stats.readFailed++;
+    stats.errors[errorCode < ErrorCount && errorCode != ErrorNone?errorCode:ErrorRead]++;
+    // not ready data is not a fault of the device, neither is a missed sample of a periodic device which delivered one recently.
+    // Periodic device which has no data for longer than the grace doesn't measure anymore
+    bool excused;
+    if(isPeriodic()) {
+      excused = (errorCode == ErrorTimeout || errorCode == ErrorNoData) && sensorsMillis()-lastSampleTime < SENSOR_PERIODIC_GRACE;
+    } else {
+      excused = errorCode == ErrorNoData;
+    }
+    if(!excused) {
+      if(failures < UINT8_MAX) {
+        failures++;
+      }
+      if(failures >= SENSOR_QUARANTINE_FAILURES) {
+        quarantine();
+      } else {
+        setHealth(HealthDegraded);
+      }
+    }
+  }
+  return ok;
+}
+
+bool Sensor::checkHealth() {
+  if(health != HealthQuarantined) {
+    return true;
+  }
+  if((int32_t)(sensorsMillis()-retryAt) < 0) {
+    status = false;
+    stats.readSkipped++;
+    return false;
+  }
+  stats.reinits++;
+  return begin();
+}
+
+void Sensor::quarantine() {
+  backoff = backoff?backoff*2:SENSOR_BACKOFF_MIN;
+  if(backoff > SENSOR_BACKOFF_MAX) {
+    backoff = SENSOR_BACKOFF_MAX;
+  }
+  retryAt = sensorsMillis()+backoff;
+  status = false;
+  setHealth(HealthQuarantined);
+}
+
+void Sensor::setHealth(SensorHealth health) {
+  if(this->health == health) {
+    return;
+  }
+  SensorHealth previous = this->health;
+  this->health = health;
+  if(healthCallback && !healthHeld) {
+    healthCallback(*this, previous);
+  }
+}
+
+void Sensor::releaseHealthCallbacks() {
+  healthHeld = false;
+  if(healthCallback && health != heldHealth) {
+    healthCallback(*this, heldHealth);
+  }
+}
+
+static const char StatReadOk[] = "read_ok";
+static const char StatReadFailed[] = "read_failed";
+static const char StatReadMean[] = "read_mean_us";
+static const char StatReadP50[] = "read_p50_us";
+static const char StatReadP99[] = "read_p99_us";
+static const char StatReadMax[] = "read_max_us";
+static const char StatInitCount[] = "init_count";
+static const char StatInitMax[] = "init_max_us";
+static const char StatReadSkipped[] = "read_skipped";
+static const char StatReinits[] = "reinits";
+static const char StatBusTransactions[] = "bus_transactions";
+static const char StatBusBytes[] = "bus_bytes";
+
+// Indexed by SensorError
+static const char *const StatErrorKeys[] = {
+  nullptr, "err_init", "err_start", "err_reset", "err_read", "err_temp", "err_hum", "err_press",
+  "err_invalid_sample", "err_no_data", "err_crc", "err_no_device", "err_self_test", "err_bus", "err_timeout"
+};
+
+void Sensor::writeStats(FieldSink &sink) {
+  sink.addField(StatReadOk, (int32_t)stats.readOk);
+  sink.addField(StatReadFailed, (int32_t)stats.readFailed);
+  if(stats.read.count) {
+    sink.addField(StatReadMean, (int32_t)stats.read.mean());
+    sink.addField(StatReadP50, (int32_t)stats.read.quantile(0.5f));
+    sink.addField(StatReadP99, (int32_t)stats.read.quantile(0.99f));
+    sink.addField(StatReadMax, (int32_t)stats.read.max);
+  }
+  sink.addField(StatInitCount, (int32_t)stats.init.count);
+  if(stats.init.count) {
+    sink.addField(StatInitMax, (int32_t)stats.init.max);
+  }
+  for(uint8_t i=1;i<ErrorCount;i++) {
+    if(stats.errors[i]) {
+      sink.addField(StatErrorKeys[i], (int32_t)stats.errors[i]);
+    }
+  }
+  if(stats.readSkipped || stats.reinits) {
+    sink.addField(StatReadSkipped, (int32_t)stats.readSkipped);
+    sink.addField(StatReinits, (int32_t)stats.reinits);
+  }
+  if(stats.busTransactions) {
+    sink.addField(StatBusTransactions, (int32_t)stats.busTransactions);
+    sink.addField(StatBusBytes, (int32_t)stats.busBytes);
+  }
+}
+
+void Sensor::storeStats(Point &point) {
+  PointFieldSink sink(point);
+  writeStats(sink);
+}
+
+// ===========  Snapshot  ==================
+
+bool SensorSnapshot::getValue(const char *key, float &value) const {
+  for(uint8_t i=0;i<count;i++) {
+    if(!strcmp(keys[i], key)) {
+      value = values[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+// Collects fields into a snapshot
+class SnapshotFieldSink : public FieldSink {
+  public:
+    SensorSnapshot &snapshot;
+    SnapshotFieldSink(SensorSnapshot &snapshot):snapshot(snapshot) { snapshot.count = 0; snapshot.dropped = 0; }
+    virtual void addField(const char *key, float value) override {
+      if(snapshot.count < SENSOR_SNAPSHOT_FIELDS) {
+        snapshot.keys[snapshot.count] = key;
+        snapshot.values[snapshot.count++] = value;
+      } else if(snapshot.dropped < UINT8_MAX) {
+        snapshot.dropped++;
+      }
+    }
+    virtual void addField(const char *key, int32_t value) override { addField(key, (float)value); }
+};
+
+// Snapshot is copied by words with atomic accesses, so a reader racing with the writer gets a torn copy, which it detects and discards
+typedef uint32_t __attribute__((__may_alias__)) SnapshotWord;
+static_assert(sizeof(SensorSnapshot) % sizeof(SnapshotWord) == 0, "snapshot must be copied by words");
+
+void Sensor::publishSnapshot() {
+  SensorSnapshot next;
+  SnapshotFieldSink sink(next);
+  writeFields(sink);
+  next.timestamp = sensorsMillis();
+  uint32_t seq = __atomic_load_n(&snapshotSeq, __ATOMIC_RELAXED);
+  __atomic_store_n(&snapshotSeq, seq+1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  const SnapshotWord *src = (const SnapshotWord *)&next;
+  SnapshotWord *dst = (SnapshotWord *)&snapshot;
+  for(uint8_t i=0;i<sizeof(SensorSnapshot)/sizeof(SnapshotWord);i++) {
+    __atomic_store_n(dst+i, src[i], __ATOMIC_RELAXED);
+  }
+  __atomic_store_n(&snapshotSeq, seq+2, __ATOMIC_RELEASE);
+}
+
+bool Sensor::getSnapshot(SensorSnapshot &out) const {
+  const SnapshotWord *src = (const SnapshotWord *)&snapshot;
+  SnapshotWord *dst = (SnapshotWord *)&out;
+  uint32_t seq;
+  do {
+    seq = __atomic_load_n(&snapshotSeq, __ATOMIC_ACQUIRE);
+    if(seq & 1) {
+      yield();
+      continue;
+    }
+    for(uint8_t i=0;i<sizeof(SensorSnapshot)/sizeof(SnapshotWord);i++) {
+      dst[i] = __atomic_load_n(src+i, __ATOMIC_RELAXED);
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  } while((seq & 1) || seq != __atomic_load_n(&snapshotSeq, __ATOMIC_RELAXED));
+  return seq != 0;
+}
+
+// ===========  LineProtocolWriter  ==================
+
+LineProtocolWriter::LineProtocolWriter(char *buffer, size_t size):buffer(buffer),size(size) {
+  clear();
+}
+
+void LineProtocolWriter::clear() {
+  len = 0;
+  lineEnd = 0;
+  lineStart = 0;
+  hasFields = false;
+  overflow = false;
+  if(size) {
+    buffer[0] = 0;
+  }
+}
+
+void LineProtocolWriter::append(const char *str, size_t strLen) {
+  // keep space for terminating zero
+  if(overflow || len + strLen >= size) {
+    overflow = true;
+    return;
+  }
+  memcpy(buffer+len, str, strLen);
+  len += strLen;
+  buffer[len] = 0;
+}
+
+void LineProtocolWriter::appendEscaped(const char *str, const char *escapeChars) {
+  const char *start = str;
+  char c;
+  while((c = *str)) {
+    if(strchr(escapeChars, c)) {
+      append(start, str-start);
+      append("\\", 1);
+      start = str;
+    }
+    str++;
+  }
+  append(start, str-start);
+}
+
+void LineProtocolWriter::beginLine(const char *measurement) {
+  // separator may not fit, so the line is dropped up to the end of the previous one, not to its own start
+  lineEnd = len;
+  if(len) {
+    append("\n", 1);
+  }
+  lineStart = len;
+  hasFields = false;
+  appendEscaped(measurement, ", ");
+}
+
+void LineProtocolWriter::addTag(const char *key, const char *value) {
+  append(",", 1);
+  appendEscaped(key, ",= ");
+  append("=", 1);
+  appendEscaped(value, ",= ");
+}
+
+void LineProtocolWriter::beginField(const char *key) {
+  // fields are separated from measurement and tags by space, unless only fields are written
+  if(hasFields || len > lineStart) {
+    append(hasFields?",":" ", 1);
+  }
+  hasFields = true;
+  appendEscaped(key, ",= ");
+  append("=", 1);
+}
+
+void LineProtocolWriter::addField(const char *key, float value) {
+  if(isnan(value)) {
+    return;
+  }
+  char buff[SENSORS_NUMBER_MAX_LEN];
+  beginField(key);
+  append(buff, formatFixed(buff, value, 2));
+}
+
+void LineProtocolWriter::addField(const char *key, int32_t value) {
+  char buff[SENSORS_NUMBER_MAX_LEN+1];
+  beginField(key);
+  uint8_t l = formatInt(buff, value);
+  buff[l++] = 'i';
+  append(buff, l);
+}
+
+void LineProtocolWriter::endLine(uint64_t timestamp) {
+  if(timestamp) {
+    char buff[21];
+    uint8_t i = sizeof(buff);
+    do {
+      buff[--i] = '0' + timestamp % 10;
+      timestamp /= 10;
+    } while(timestamp);
+    append(" ", 1);
+    append(buff+i, sizeof(buff)-i);
+  }
+  // drop line without fields, as line protocol requires at least one, or which didn't fit
+  if(!hasFields || overflow) {
+    len = lineEnd;
+    if(size) {
+      buffer[len] = 0;
+    }
+  }
+}
+
+// ===========  TemperatureSensor  ==================
+
+static constexpr FieldDescriptor TemperatureFields[] PROGMEM = {
+  temperatureField()
+};
+
+const FieldDescriptor *TemperatureSensor::getFields(uint8_t &count) {
+  count = SENSOR_FIELDS_COUNT(TemperatureFields);
+  return TemperatureFields;
+}
+
+// ===========  TemperatureHumiditySensor  ==================
+
+static constexpr FieldDescriptor TemperatureHumidityFields[] PROGMEM = {
+  temperatureField(),
+  humidityField()
+};
+
+const FieldDescriptor *TemperatureHumiditySensor::getFields(uint8_t &count) {
+  count = SENSOR_FIELDS_COUNT(TemperatureHumidityFields);
+  return TemperatureHumidityFields;
+}
+
+void TemperatureHumiditySensor::printTemperatureHumidity(Print &out) {
+  printFields(out, TemperatureHumidityFields, SENSOR_FIELDS_COUNT(TemperatureHumidityFields));
+}
+
+// =================== AnalogSensor ===================
+
+AnalogSensor::AnalogSensor(const char *name, const String& fieldName, uint8_t pin, uint16_t capability, float max):
+  Sensor(name),maxValue(max),fieldName(fieldName),rawFieldName(fieldName + "_raw"),pin(pin),capability(capability),
+  averagingWindowSize(0),pAveragingWindow(nullptr),averagingWindowPointer(0),averageWindowWasTop(false),averagingSum(0),
+  oversampling(10),samplingInterval(1),backgroundSampling(false),backgroundValueReady(false),
+  samplesSum(0),samplesCount(0),lastSampleTime(0) { 
+}
+AnalogSensor::~AnalogSensor() {
+  if(pAveragingWindow) {
+    delete [] pAveragingWindow;
+  }
+}
+
+bool AnalogSensor::init() {
+  status = true;
+  return true;
+}
+
+bool AnalogSensor::readValues() {
+  if(backgroundSampling) {
+    status = backgroundValueReady;
+    if(!status) {
+      setError(ErrorNoData);
+    }
+    return status;
+  }
+  uint32_t cum = 0;
+  for(uint8_t i=0;i<oversampling;i++) {
+    cum += analogRead(pin);
+    delay(samplingInterval);
+  }
+  updateValue((uint16_t)(cum/oversampling));
+  status = true;
+  return true;
+}
+
+bool AnalogSensor::startMeasurement() {
+  if(backgroundSampling) {
+    return true;
+  }
+  samplesSum = analogRead(pin);
+  samplesCount = 1;
+  lastSampleTime = sensorsMillis();
+  return true;
+}
+
+bool AnalogSensor::measurementReady() {
+  if(backgroundSampling) {
+    return true;
+  }
+  if(samplesCount < oversampling && sensorsMillis()-lastSampleTime >= samplingInterval) {
+    samplesSum += analogRead(pin);
+    samplesCount++;
+    lastSampleTime = sensorsMillis();
+  }
+  return samplesCount == oversampling;
+}
+
+bool AnalogSensor::finishMeasurement() {
+  if(backgroundSampling) {
+    return readValues();
+  }
+  updateValue((uint16_t)(samplesSum/samplesCount));
+  status = true;
+  return true;
+}
+
+void AnalogSensor::update() {
+  // samples keep the interval across batches, only the very first sample is taken immediately
+  if(!backgroundSampling || ((samplesCount || backgroundValueReady) && sensorsMillis()-lastSampleTime < samplingInterval)) {
+    return;
+  }
+  samplesSum += analogRead(pin);
+  lastSampleTime = sensorsMillis();
+  if(++samplesCount == oversampling) {
+    updateValue((uint16_t)(samplesSum/samplesCount));
+    samplesSum = 0;
+    samplesCount = 0;
+    backgroundValueReady = true;
+  }
+}
+
+void AnalogSensor::updateValue(uint16_t raw) {
+  rawValue = raw;
+  if(averagingWindowSize) {
+    // keep running sum of the window, so averaging costs O(1)
+    if(averageWindowWasTop) {
+      averagingSum -= pAveragingWindow[averagingWindowPointer];
+    }
+    averagingSum += raw;
+    pAveragingWindow[averagingWindowPointer++] = raw;
+    if(averagingWindowPointer == averagingWindowSize) {
+      averagingWindowPointer = 0;
+      averageWindowWasTop = true;
+    }
+    auto top = averageWindowWasTop?averagingWindowSize:averagingWindowPointer;
+    rawValue = (uint16_t)(averagingSum/top);
+  }
+  
+#ifdef ESP32  
+  value = (rawValue/4095.0)*maxValue;
+#elif defined(ESP8266)
+  value = (rawValue/1023.0)*maxValue;
+#else
+  value = (rawValue/255.0)*maxValue;
+#endif
+}
+
+void AnalogSensor::writeFields(FieldSink &sink) {
+  sink.addField(fieldName.c_str(), value);
+  sink.addField(rawFieldName.c_str(), (int32_t)rawValue);
+}
+
+bool AnalogSensor::setField(const char *key, float value) {
+  // keys written by writeFields() point into the names, so compare pointers first
+  if(fieldName.c_str() == key || !strcmp(key, fieldName.c_str())) {
+    this->value = value;
+  } else if(rawFieldName.c_str() == key || !strcmp(key, rawFieldName.c_str())) {
+    setFieldMember(rawValue, value);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool AnalogSensor::getValue(SensorCapability cap, float &value) {
+  if(!(capability & cap)) {
+    return false;
+  }
+  value = this->value;
+  return true;
+}
+
+void AnalogSensor::printValues(Print &out) {
+  out.print(' ');
+  printInt(out, rawValue, 4);
+  out.print(F("  "));
+  printFixed(out, value, 1, 3);
+  out.print('V');
+}
+
+void AnalogSensor::setAveragingWindowSize(uint8_t size) {
+  if(pAveragingWindow) {
+    delete [] pAveragingWindow;
+    pAveragingWindow = nullptr;
+  }
+  averagingWindowSize = size;
+  averagingWindowPointer = 0;
+  averageWindowWasTop = false;
+  averagingSum = 0;
+  if(size > 0) {
+    pAveragingWindow = new uint16_t[size];
+    for(auto i=0;i<size;i++) {
+      pAveragingWindow[i] = 0;
+    }
+  }
+}
+
+void AnalogSensor::setOversampling(uint8_t samples, uint16_t interval) {
+  oversampling = samples?samples:1;
+  samplingInterval = interval;
+  samplesSum = 0;
+  samplesCount = 0;
+}
+
+void AnalogSensor::setBackgroundSampling(bool enable) {
+  backgroundSampling = enable;
+  backgroundValueReady = false;
+  samplesSum = 0;
+  samplesCount = 0;
+}
+
+
+// ===========  VOCSensor  ==================
+
+static constexpr FieldDescriptor VOCFields[] PROGMEM = {
+  vocIndexField(),
+  vocRawField()
+};
+
+const FieldDescriptor *VOCSensor::getFields(uint8_t &count) {
+  count = SENSOR_FIELDS_COUNT(VOCFields);
+  return VOCFields;
+}
+
+void VOCSensor::printValues(Print &out) {
+  out.print(' ');
+  printInt(out, vocRaw, 6);
+  out.print(F("r "));
+  printInt(out, vocIndex, 3);
+  out.print('v');
+}
+
+// ===========  CO2Sensor  ==================
+
+void CO2Sensor::printCo2(Print &out) {
+  out.print(' ');
+  printInt(out, co2, 5);
+  out.print(F("ppm"));
+}
+
+// ===========  IlluminationSensor  ==================
+
+static constexpr FieldDescriptor IlluminationFields[] PROGMEM = {
+  { Light, UnitLux, fieldValue<IlluminationSensor, float IlluminationSensor::*, &IlluminationSensor::lightIntensity>, CapLightIntensity, FieldFloat, 3, 1, 0 }
+};
+
+const FieldDescriptor *IlluminationSensor::getFields(uint8_t &count) {
+  count = SENSOR_FIELDS_COUNT(IlluminationFields);
+  return IlluminationFields;
+}
+
+void IlluminationSensor::printValues(Print &out) {
+  out.print(' ');
+  printFixed(out, lightIntensity, 3, 1);
+  out.print(F("lux"));
+}
@@ -0,0 +1,594 @@
+#ifndef SENSOR_BASE_H
+#define SENSOR_BASE_H
+
+#include "SensorsConfig.h"
+#include <Arduino.h>
+#include <InfluxDbClient.h>
+
+extern const char Temp[];
+extern const char Hum[];
+extern const char Press[];
+extern const char PressRaw[];
+extern const char Co2[];
+extern const char Moist[];
+extern const char Voc[];
+extern const char GasResistance[];
+extern const char Light[];
+
+// Units printed by toString()
+extern const char UnitCelsius[];
+extern const char UnitPercent[];
+extern const char UnitHectoPascal[];
+extern const char UnitPpm[];
+extern const char UnitVoc[];
+extern const char UnitRaw[];
+
+typedef uint32_t (*SensorsClock)();
+
+// Replaces millis() as the time source of all library timing, e.g. by a simulated clock on host.
+// readAllByBus() calls it from several tasks at once, so it must be safe for that as millis() is
+void setSensorsClock(SensorsClock clock);
+uint32_t sensorsMillis();
+
+// CRC-8 with polynomial 0x31 used by Sensirion (init 0xFF) and Si702x/HTU21D (init 0x00) chips
+uint8_t sensorsCrc8(const uint8_t *data, uint8_t len, uint8_t init);
+
+// Receives sensor fields. Keys are zero terminated RAM strings, sinks compare (strcmp()) and read them directly,
+// so they must outlive the addField() call. Field keys of sensors are constants, FieldAggregator keeps them
+class FieldSink {
+  public:
+    virtual ~FieldSink() {}
+    virtual void addField(const char *key, float value) = 0;
+    virtual void addField(const char *key, int32_t value) = 0;
+};
+
+class Sensor;
+
+// Processes fields of each successful read before they are published, e.g. FilterPipeline replaces them by filtered values
+class ReadingProcessor {
+  public:
+    virtual ~ReadingProcessor() {}
+    virtual void process(Sensor &sensor) = 0;
+};
+
+// Adds fields to a Point
+class PointFieldSink : public FieldSink {
+  protected:
+    Point &point;
+  public:
+    PointFieldSink(Point &point):point(point) {}
+    virtual void addField(const char *key, float value) override { point.addField(String(key), value); }
+    virtual void addField(const char *key, int32_t value) override { point.addField(String(key), (int)value); }
+};
+
+// Writes InfluxDB line protocol directly into a caller supplied buffer, without heap allocations.
+// Fields are formatted byte-identical to Point. Lines are separated by a new line.
+class LineProtocolWriter : public FieldSink {
+  protected:
+    char *buffer;
+    size_t size;
+    size_t len;
+    // length of finished lines, without the separator of the current line
+    size_t lineEnd;
+    size_t lineStart;
+    bool hasFields;
+    bool overflow;
+  public:
+    LineProtocolWriter(char *buffer, size_t size);
+    // Starts a new line with the measurement name
+    void beginLine(const char *measurement);
+    void addTag(const char *key, const char *value);
+    virtual void addField(const char *key, float value) override;
+    virtual void addField(const char *key, int32_t value) override;
+    // Finishes line, timestamp 0 means no timestamp. Line without fields or which didn't fit is discarded
+    void endLine(uint64_t timestamp = 0);
+    void clear();
+    const char *getBuffer() const { return buffer; }
+    size_t length() const { return len; }
+    // Returns true if some data didn't fit into the buffer
+    bool isOverflow() const { return overflow; }
+  protected:
+    void append(const char *str, size_t strLen);
+    void appendEscaped(const char *str, const char *escapeChars);
+    void beginField(const char *key);
+};
+
+enum SensorCapability {
+  CapTemperature = 1<<0,
+  CapHumidity = 1<<1,
+  CapPressure = 1<<2,
+  CapCo2 = 1<<3,
+  CapVoc = 1<<4,
+  CapSoilMoisture = 1<<5,
+  CapLightIntensity = 1<<6,
+  CapDustPPM = 1<<7
+};
+
+// Number of SensorCapability bits
+#define SENSOR_CAPABILITIES_COUNT 8
+
+enum SensorError : uint8_t {
+  ErrorNone = 0,
+  ErrorInit,
+  ErrorStart,
+  ErrorReset,
+  ErrorRead,
+  ErrorTemperature,
+  ErrorHumidity,
+  ErrorPressure,
+  ErrorInvalidSample,
+  ErrorNoData,
+  ErrorCrc,
+  ErrorNoDevice,
+  ErrorSelfTest,
+  ErrorBus,
+  ErrorTimeout,
+  ErrorCount
+};
+
+// Measurement profiles, each driver maps them to its native settings. See README for the table
+enum SensorProfile : uint8_t {
+  ProfileDefault = 0,
+  ProfileFastest,
+  ProfileLowPower,
+  ProfilePrecise,
+  ProfileSingleShot
+};
+
+// Health of a sensor: degraded after a failed read, quarantined after SENSOR_QUARANTINE_FAILURES consecutive failed reads or a failed init.
+// Quarantined sensor is not read, it is re-initialized after a backoff doubling from SENSOR_BACKOFF_MIN to SENSOR_BACKOFF_MAX (ms).
+// ErrorNoData doesn't count as a failure. A periodically measuring sensor gets neither ErrorNoData nor ErrorTimeout counted only
+// within SENSOR_PERIODIC_GRACE since its last sample
+enum SensorHealth : uint8_t {
+  HealthOk = 0,
+  HealthDegraded,
+  HealthQuarantined
+};
+
+#ifndef SENSOR_QUARANTINE_FAILURES
+#define SENSOR_QUARANTINE_FAILURES 3
+#endif
+
+#ifndef SENSOR_BACKOFF_MIN
+#define SENSOR_BACKOFF_MIN 1000
+#endif
+
+#ifndef SENSOR_BACKOFF_MAX
+#define SENSOR_BACKOFF_MAX 300000
+#endif
+
+// Time (ms) since the last sample of a periodically measuring sensor, until which its timeouts and missing data don't count as failures.
+// Such timeout usually means only the device measures less often than it is read, e.g. with a longer interval set on it
+#ifndef SENSOR_PERIODIC_GRACE
+#define SENSOR_PERIODIC_GRACE 120000
+#endif
+
+// Max interval (ms) between measurementReady() polls of a sensor by readAll(). Sensors with shorter conversion are polled
+// once per conversion time, the first poll is right after the start, so already ready sensors don't wait
+#ifndef SENSOR_POLL_INTERVAL
+#define SENSOR_POLL_INTERVAL 10
+#endif
+
+// Time (ms) a sensor with known conversion time gets over it in readAll(), when it is longer than the passed timeout
+#ifndef SENSOR_TIMEOUT_MARGIN
+#define SENSOR_TIMEOUT_MARGIN 1000
+#endif
+
+#ifndef SENSOR_STATE_DATA_SIZE
+#define SENSOR_STATE_DATA_SIZE 20
+#endif
+
+// Runtime state of a sensor kept over deep sleep in memory retained by MCU,
+// e.g. RTC_DATA_ATTR variable on ESP32 or RTC user memory on ESP8266
+struct SensorState {
+  uint8_t marker;
+  uint8_t crc;
+  uint8_t flags;
+  uint8_t length;
+  uint8_t data[SENSOR_STATE_DATA_SIZE];
+};
+
+// Flag of a saved state of a sensor with running measurement
+static const uint8_t SensorStateRunning = 1<<0;
+
+#ifndef SENSOR_STATS_BUCKETS
+#define SENSOR_STATS_BUCKETS 21
+#endif
+
+// Histogram of latencies with power of two buckets: bucket 0 counts 0us, bucket i counts [2^(i-1), 2^i) us,
+// the last bucket counts also all longer latencies
+struct LatencyHistogram {
+  uint16_t buckets[SENSOR_STATS_BUCKETS];
+  uint32_t count;
+  uint32_t sum;
+  uint32_t max;
+  void add(uint32_t us);
+  // Returns upper bound in us of the bucket containing quantile q (0-1), 0 if empty
+  uint32_t quantile(float q) const;
+  uint32_t mean() const { return count?sum/count:0; }
+};
+
+// Counters of a sensor kept for its whole life
+struct SensorStats {
+  LatencyHistogram init;
+  LatencyHistogram read;
+  uint32_t readOk;
+  uint32_t readFailed;
+  // Failures by SensorError of init() and reads
+  uint16_t errors[ErrorCount];
+  // Transactions and bytes on the bus done by the driver itself. Traffic of third party device libraries is not counted
+  uint32_t busTransactions;
+  uint32_t busBytes;
+  // Reads skipped in quarantine and re-inits done after the backoff
+  uint32_t readSkipped;
+  uint16_t reinits;
+  void reset() { memset(this, 0, sizeof(SensorStats)); }
+};
+
+// Max fields kept in a snapshot, enough for every driver except DS18B20 with more than 8 probes.
+// Fields over the limit are not kept and are counted in SensorSnapshot::dropped
+#ifndef SENSOR_SNAPSHOT_FIELDS
+#define SENSOR_SNAPSHOT_FIELDS 8
+#endif
+
+// Copy of fields of the last successful read. Keys point to keys of the sensor fields, int fields are stored as float
+struct SensorSnapshot {
+  // sensorsMillis() of the read
+  uint32_t timestamp;
+  uint8_t count;
+  // Number of fields of the read which didn't fit, 0 if the snapshot is complete
+  uint8_t dropped;
+  const char *keys[SENSOR_SNAPSHOT_FIELDS];
+  float values[SENSOR_SNAPSHOT_FIELDS];
+  // Returns false if snapshot has no such field
+  bool getValue(const char *key, float &value) const;
+};
+
+class Sensor;
+
+// Called when health of a sensor changes
+typedef void (*SensorHealthCallback)(Sensor &sensor, SensorHealth previous);
+
+void setSensorHealthCallback(SensorHealthCallback callback);
+
+enum FieldType : uint8_t {
+  FieldFloat = 0,
+  FieldInt
+};
+
+enum FieldFlags : uint8_t {
+  // Field is written to sinks, but not printed by toString()
+  FieldHidden = 1<<0
+};
+
+// Describes a single field of a sensor. Tables of descriptors are constant and stored in flash (PROGMEM),
+// read them by readFieldDescriptor(). Strings they point to are ordinary constant arrays in RAM, because keys are passed
+// to sinks and compared as RAM strings
+struct FieldDescriptor {
+  // Field key
+  const char *key;
+  // Text printed after the value by toString(), nullptr if none
+  const char *unit;
+  // Returns value from the last reading, replaces it first when newValue is set
+  float (*access)(Sensor &sensor, const float *newValue);
+  // Capability provided by the field, 0 if none
+  uint16_t capability;
+  // Type in which field is written to sinks
+  FieldType type;
+  // Width and decimal places printed by toString()
+  uint8_t width;
+  uint8_t precision;
+  uint8_t flags;
+};
+
+inline void readFieldDescriptor(const FieldDescriptor *fields, uint8_t index, FieldDescriptor &field) {
+  memcpy_P(&field, fields + index, sizeof(FieldDescriptor));
+}
+
+template<uint8_t I, typename... T> struct StaticSensorNode;
+class TwoWire;
+
+class Sensor {
+  template<uint8_t I, typename... T> friend struct StaticSensorNode;
+  protected:
+    String name;
+    SensorError errorCode = ErrorNone;
+    // driver specific code of the last error, 0 if none
+    uint16_t errorDetail = 0;
+    bool status;
+    SensorProfile profile = ProfileDefault;
+    SensorStats stats;
+    // Snapshot published after each successful read, guarded by seqlock: odd snapshotSeq means write in progress
+    SensorSnapshot snapshot;
+    uint32_t snapshotSeq = 0;
+    // I2C bus of the device, nullptr if sensor is not on I2C
+    TwoWire *bus = nullptr;
+    ReadingProcessor *processor = nullptr;
+  protected:
+    Sensor(const char *name):name(name) { stats.reset(); snapshot.count = 0; snapshot.dropped = 0; }
+    Sensor() { stats.reset(); snapshot.count = 0; snapshot.dropped = 0; }
+  public:
+    virtual ~Sensor() {};
+    virtual bool init() = 0;
+    // Calls init() and records its latency and result in stats
+    bool begin();
+    // Saves runtime state before deep sleep, returns false if sensor has no state to keep
+    virtual bool saveState(SensorState &state);
+    // Continues with state saved before deep sleep. Does full init() if state is not valid or device has lost it.
+    // Either way it's recorded in stats as a single init
+    bool resume(const SensorState &state);
+    virtual bool readValues() = 0;
+    // Calls readValues() and records its latency and result in stats. Quarantined sensor is not read, or re-initialized when its backoff elapsed
+    bool read();
+    // Two phase measurement: startMeasurement() triggers a conversion and returns immediately,
+    // measurementReady() polls without blocking and finishMeasurement() fetches values as readValues() does.
+    // Drivers which cannot split a measurement do all the work in finishMeasurement().
+    // Time based drivers wait more than conversion time in sensorsMillis(), as a millisecond tick can come right after the start
+    virtual bool startMeasurement() { return true; }
+    virtual bool measurementReady() { return true; }
+    virtual bool finishMeasurement() { return readValues(); }
+    // Adds fields to the point, through writeFields()
+    virtual void storeValues(Point &point);
+    // Returns table of field descriptors and sets count of fields. Sensors with fields known only at runtime return nullptr
+    // and override writeFields(), printValues(), getCapabilities() and getValue()
+    virtual const FieldDescriptor *getFields(uint8_t &count) { count = 0; return nullptr; }
+    // Passes all fields to the sink, by default fields of getFields()
+    virtual void writeFields(FieldSink &sink);
+    virtual String toString();
+    // Prints the same text as toString() without heap allocations
+    void printTo(Print &out);
+    // Writes the same text as toString() into buffer, returns its length
+    size_t toString(char *buffer, size_t size);
+    // Returns capabilities of getFields() by default
+    virtual uint16_t getCapabilities();
+    // Selects measurement profile, it is applied by init(). Returns false if sensor doesn't support it
+    bool setProfile(SensorProfile profile);
+    SensorProfile getProfile() const { return profile; }
+    virtual bool supportsProfile(SensorProfile profile) { return profile == ProfileDefault; }
+    // Returns expected time in ms from start of measurement until values are ready in the profile,
+    // for continuously measuring sensors it is the sampling period
+    virtual uint32_t getProfileConversionTime(SensorProfile) { return 0; }
+    uint32_t getConversionTime() { return getProfileConversionTime(profile); }
+    // Returns true if device measures on its own schedule in the current profile, so a read can miss a new sample
+    virtual bool isPeriodic() { return false; }
+    // Sets value of a single capability from the last reading, returns false if sensor doesn't provide it.
+    // CapDustPPM is PM2.5 concentration. By default the first field of getFields() with the capability is used
+    virtual bool getValue(SensorCapability capability, float &value);
+    // Replaces value of a field of the last reading, e.g. by a filtered one. Returns false if sensor has no such field
+    virtual bool setField(const char *key, float value);
+    // Processor is called after each successful read, before its fields are published. nullptr removes it
+    void setReadingProcessor(ReadingProcessor *processor) { this->processor = processor; }
+    ReadingProcessor *getReadingProcessor() const { return processor; }
+    // Returns message of the last error, it is formatted only when called
+    String getError();
+    void printError(Print &out);
+    SensorError getErrorCode() const { return errorCode; }
+    uint16_t getErrorDetail() const { return errorDetail; }
+    bool getStatus() { return status; }
+    const String &getName() const { return name; }
+    TwoWire *getBus() const { return bus; }
+    // Reads all sensors with overlapping conversions, so a cycle takes as long as the slowest sensor.
+    // Sensors not finished within timeout (ms) fail, sensors with longer conversion time get it plus SENSOR_TIMEOUT_MARGIN instead.
+    // If finishTimes is set, it receives sensorsMillis() when each sensor finished.
+    // Returns number of successfully read sensors
+    // Latency of a read is measured from start of the measurement until its values are fetched. Quarantined sensors are skipped as by read()
+    static uint8_t readAll(Sensor *sensors[], uint8_t count, uint32_t timeout = 2000, uint32_t *finishTimes = nullptr);
+    const SensorStats &getStats() const { return stats; }
+    void resetStats() { stats.reset(); }
+    // Writes stats as fields, e.g. into a Point of internal metrics tagged by sensor name. Error counters are written only when non zero
+    void writeStats(FieldSink &sink);
+    void storeStats(Point &point);
+    // Copies fields of the last successful read by read(), readAll() or a sensor set, consistent even while another task reads the sensor.
+    // Never blocks the reading task, retries if it published a new snapshot during the copy. Returns false if there was no successful read yet
+    bool getSnapshot(SensorSnapshot &out) const;
+    SensorHealth getHealth() const { return health; }
+    uint8_t getConsecutiveFailures() const { return failures; }
+    // Returns sensorsMillis() of the next re-init of a quarantined sensor
+    uint32_t getRetryTime() const { return retryAt; }
+    // Holds health callbacks of the sensor until releaseHealthCallbacks(), which reports the change since the hold by a single call
+    // from the calling task. Used when another task reads the sensor, e.g. by readAllByBus()
+    void holdHealthCallbacks() { heldHealth = health; healthHeld = true; }
+    void releaseHealthCallbacks();
+  protected:
+    // Formats values through printValues()
+    virtual String formatValues();
+    // Prints visible fields of getFields() separated by two spaces, sensors with their own format override it
+    virtual void printValues(Print &out);
+    // Prints visible fields of the table separated by two spaces
+    void printFields(Print &out, const FieldDescriptor *fields, uint8_t count);
+    void setError(SensorError code, uint16_t detail = 0) { errorCode = code; errorDetail = detail; }
+    // Checks whether device kept the saved state and continues with it, returns false if init() is needed
+    virtual bool resumeState(const SensorState &) { return false; }
+    void sealState(SensorState &state, uint8_t flags, uint8_t length);
+    // Prints description of errorDetail
+    virtual void formatErrorDetail(Print &out);
+    // Records result of a read or init started at startMicros (micros()) in stats and health
+    bool recordRead(bool ok, uint32_t startMicros);
+    bool recordInit(bool ok, uint32_t startMicros);
+    // Returns false if sensor is quarantined and should not be read now. Re-initializes it when the backoff elapsed
+    bool checkHealth();
+    // Counts a bus transaction done by the driver itself
+    void countBusTransfer(uint8_t bytes) { stats.busTransactions++; stats.busBytes += bytes; }
+  private:
+    bool measuring = false;
+    uint32_t measureStart = 0;
+    // sensorsMillis() of the next measurementReady() poll by readAll() and of its timeout
+    uint32_t nextPoll = 0;
+    uint32_t pollDeadline = 0;
+    SensorHealth health = HealthOk;
+    SensorHealth heldHealth = HealthOk;
+    bool healthHeld = false;
+    uint8_t failures = 0;
+    uint32_t backoff = 0;
+    uint32_t retryAt = 0;
+    // sensorsMillis() of the last successful init or read
+    uint32_t lastSampleTime = 0;
+    // Starts polling of a started measurement, timeout is extended to the conversion time
+    void startPolling(uint32_t timeout);
+    // Returns true if the sensor should be polled now, otherwise shortens wait (ms) until the poll or timeout
+    bool pollDue(uint32_t now, uint32_t &wait) const;
+    bool pollTimedOut(uint32_t now) const { return (int32_t)(now-pollDeadline) >= 0; }
+    // Schedules next poll after a not ready one
+    void schedulePoll(uint32_t now, uint32_t &wait);
+    // Waits between polling passes without spinning
+    static void waitForPoll(uint32_t wait);
+    void quarantine();
+    void setHealth(SensorHealth health);
+    void publishSnapshot();
+};
+
+class TemperatureSensor : public Sensor {
+  public:
+    float temp;
+  public:
+    TemperatureSensor(const char *name):Sensor(name) {}
+    virtual const FieldDescriptor *getFields(uint8_t &count) override;
+};
+
+class PressureSensor {
+  public:
+    float pressRaw;
+    float pressSeaLevel;
+    float altitude;
+  protected:
+    PressureSensor(float altitude):altitude(altitude) {}
+};
+
+class TemperatureHumiditySensor : public TemperatureSensor {
+  public:
+    float hum;
+  public:
+    TemperatureHumiditySensor(const char *name):TemperatureSensor(name) {}
+    virtual const FieldDescriptor *getFields(uint8_t &count) override;
+  protected:
+    // Prints only temperature and humidity, for subclasses printing more fields
+    void printTemperatureHumidity(Print &out);
+};
+
+class AnalogSensor : public Sensor {
+  public:
+    uint16_t rawValue;
+    float value;
+    float maxValue;
+  protected:
+    String fieldName;
+    String rawFieldName;
+    uint8_t pin;
+    uint16_t capability;
+    uint8_t averagingWindowSize;
+    uint16_t *pAveragingWindow;
+    uint8_t averagingWindowPointer;
+    bool averageWindowWasTop;
+    uint32_t averagingSum;
+    uint8_t oversampling;
+    uint16_t samplingInterval;
+    bool backgroundSampling;
+    bool backgroundValueReady;
+    uint32_t samplesSum;
+    uint8_t samplesCount;
+    uint32_t lastSampleTime;
+  public:
+    AnalogSensor(const char *name, const String& fieldName, uint8_t pin, uint16_t capability, float max = 3.3);
+    virtual ~AnalogSensor();
+    virtual bool init() override;
+    virtual bool readValues() override;
+    virtual bool startMeasurement() override;
+    virtual bool measurementReady() override;
+    virtual bool finishMeasurement() override;
+    virtual void writeFields(FieldSink &sink) override;
+    virtual uint16_t getCapabilities() override { return capability; }
+    virtual bool getValue(SensorCapability cap, float &value) override;
+    virtual bool setField(const char *key, float value) override;
+    // Sets number of readings averaged in a moving window, 0 disables averaging
+    void setAveragingWindowSize(uint8_t size);
+    // Sets number of samples oversampled into a single reading and interval between samples in ms. Default is 10 samples 1ms apart
+    void setOversampling(uint8_t samples, uint16_t interval = 1);
+    // In background sampling samples are collected by update() and readValues() returns the latest filtered value instantly
+    void setBackgroundSampling(bool enable);
+    // Takes a sample if sampling interval elapsed. Call it from loop() or a timer (e.g. Ticker) in background sampling mode
+    void update();
+  protected:
+    virtual void printValues(Print &out) override;
+    void updateValue(uint16_t raw);
+};
+
+class IlluminationSensor : public Sensor {
+  public:
+    float lightIntensity;
+  public:
+    IlluminationSensor(const char *name):Sensor(name) {}
+    virtual const FieldDescriptor *getFields(uint8_t &count) override;
+  protected:
+    virtual void printValues(Print &out) override;
+};
+
+class VOCSensor : public Sensor {
+  public:
+    uint16_t vocRaw;
+    uint16_t vocIndex;
+  public:
+    VOCSensor():vocRaw(0), vocIndex(0) {}
+    VOCSensor(const char *name):Sensor(name),vocRaw(0), vocIndex(0) {}
+    virtual const FieldDescriptor *getFields(uint8_t &count) override;
+  protected:
+    // Prints raw signal before index
+    virtual void printValues(Print &out) override;
+};
+
+class CO2Sensor {
+  public:
+    uint16_t co2;
+  protected:
+    void printCo2(Print &out);
+};
+
+// Stores value into a field member, integer members are rounded and keep their value for NAN
+inline void setFieldMember(float &member, float value) { member = value; }
+template<typename T> void setFieldMember(T &member, float value) {
+  if(!isnan(value)) {
+    member = (T)lroundf(value);
+  }
+}
+
+// Accessor of a member of sensor class S for FieldDescriptor, e.g. fieldValue<SCD30Sensor, decltype(&SCD30Sensor::co2), &SCD30Sensor::co2>
+template<typename S, typename P, P member> float fieldValue(Sensor &sensor, const float *newValue) {
+  S &s = static_cast<S&>(sensor);
+  if(newValue) {
+    setFieldMember(s.*member, *newValue);
+  }
+  return s.*member;
+}
+
+// Descriptors of fields shared by several sensors, S is the sensor class
+constexpr FieldDescriptor temperatureField() {
+  return { Temp, UnitCelsius, fieldValue<TemperatureSensor, float TemperatureSensor::*, &TemperatureSensor::temp>, CapTemperature, FieldFloat, 3, 1, 0 };
+}
+
+constexpr FieldDescriptor humidityField() {
+  return { Hum, UnitPercent, fieldValue<TemperatureHumiditySensor, float TemperatureHumiditySensor::*, &TemperatureHumiditySensor::hum>, CapHumidity, FieldFloat, 2, 0, 0 };
+}
+
+template<typename S> constexpr FieldDescriptor pressureField() {
+  return { Press, UnitHectoPascal, fieldValue<S, float PressureSensor::*, &PressureSensor::pressSeaLevel>, CapPressure, FieldFloat, 4, 0, 0 };
+}
+
+template<typename S> constexpr FieldDescriptor rawPressureField() {
+  return { PressRaw, UnitHectoPascal, fieldValue<S, float PressureSensor::*, &PressureSensor::pressRaw>, 0, FieldFloat, 4, 0, FieldHidden };
+}
+
+constexpr FieldDescriptor vocIndexField() {
+  return { Voc, UnitVoc, fieldValue<VOCSensor, uint16_t VOCSensor::*, &VOCSensor::vocIndex>, CapVoc, FieldFloat, 3, 0, 0 };
+}
+
+constexpr FieldDescriptor vocRawField() {
+  return { GasResistance, UnitRaw, fieldValue<VOCSensor, uint16_t VOCSensor::*, &VOCSensor::vocRaw>, 0, FieldFloat, 6, 0, 0 };
+}
+
+template<typename S> constexpr FieldDescriptor co2Field() {
+  return { Co2, UnitPpm, fieldValue<S, uint16_t CO2Sensor::*, &CO2Sensor::co2>, CapCo2, FieldFloat, 5, 0, 0 };
+}
+
+// Number of descriptors in a table
+#define SENSOR_FIELDS_COUNT(fields) (sizeof(fields)/sizeof(FieldDescriptor))
+
+#endif //SENSOR_BASE_H
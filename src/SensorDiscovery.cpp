@@ -0,0 +1,360 @@
+#include "SensorDiscovery.h"
+#include <Wire.h>
+
+struct DiscoveryCandidate {
+  uint8_t address;
+  SensorType type;
+};
+
+// Addresses used by the drivers. Types of shared addresses and SHTC3 are resolved by reading IDs, other devices are verified
+// by a read only command. BH1750 has no readable ID, any device acknowledging 0x23 is taken for it
+static const DiscoveryCandidate Candidates[] PROGMEM = {
+  { 0x23, SensorTypeBH1750 },
+  { 0x40, SensorTypeNone },
+  { 0x44, SensorTypeNone },
+  { 0x59, SensorTypeNone },
+  { 0x5A, SensorTypeCCS811 },
+  { 0x61, SensorTypeSCD30 },
+  { 0x62, SensorTypeSCD41 },
+  { 0x69, SensorTypeSEN54 },
+  { 0x70, SensorTypeNone },
+  { 0x76, SensorTypeNone },
+  { 0x77, SensorTypeNone },
+};
+
+static const uint8_t BMxChipIdRegister = 0xD0;
+static const uint8_t BME280ChipId = 0x60;
+static const uint8_t BMP280ChipId = 0x58;
+static const uint8_t CCS811HwIdRegister = 0x20;
+static const uint8_t CCS811HwId = 0x81;
+// Read only commands of Sensirion devices with a single word response, accepted in idle and measurement modes
+static const uint16_t SCD30FirmwareVersion = 0xD100;
+static const uint16_t SCD4xDataReady = 0xE4B8;
+static const uint16_t SEN5xDataReady = 0x0202;
+static const uint16_t SHT3xStatus = 0xF32D;
+static const uint16_t SHTC3WakeUp = 0x3517;
+static const uint16_t SHTC3ReadId = 0xEFC8;
+static const uint16_t SGPSerialNumber = 0x3682;
+
+// Header of saved topology: magic, version
+static const uint8_t TopologyMagic = 0x53;
+static const uint8_t TopologyVersion = 1;
+
+uint8_t SensorDiscovery::scan() {
+  count = 0;
+  for(uint8_t i=0;i<sizeof(Candidates)/sizeof(Candidates[0]);i++) {
+    uint8_t address = pgm_read_byte(&Candidates[i].address);
+    SensorType type = (SensorType)pgm_read_byte(&Candidates[i].type);
+    if(!probe(address)) {
+      continue;
+    }
+    uint8_t id;
+    switch(address) {
+      case 0x40:
+        type = identify0x40();
+        break;
+      case 0x44:
+        type = identify0x44();
+        break;
+      case 0x59:
+        type = identify0x59();
+        break;
+      case 0x70:
+        type = identify0x70();
+        break;
+      case 0x61:
+        if(!readWord(address, SCD30FirmwareVersion, 3)) {
+          type = SensorTypeNone;
+        }
+        break;
+      case 0x62:
+        if(!readWord(address, SCD4xDataReady, 1)) {
+          type = SensorTypeNone;
+        }
+        break;
+      case 0x69:
+        if(!readWord(address, SEN5xDataReady, 20)) {
+          type = SensorTypeNone;
+        }
+        break;
+      case 0x5A:
+        if(!readRegister(address, CCS811HwIdRegister, id) || id != CCS811HwId) {
+          type = SensorTypeNone;
+        }
+        break;
+      case 0x76:
+      case 0x77:
+        if(!readRegister(address, BMxChipIdRegister, id)) {
+          break;
+        }
+        if(id == BME280ChipId) {
+          type = SensorTypeBME280;
+        } else if(id == BMP280ChipId && address == 0x76) {
+          // BMP280Sensor uses only the alternate address
+          type = SensorTypeBMP280;
+        }
+        break;
+    }
+    if(type != SensorTypeNone) {
+      add(type, address);
+    }
+  }
+  return count;
+}
+
+bool SensorDiscovery::add(SensorType type, uint8_t address) {
+  if(count == SENSOR_DISCOVERY_MAX || type == SensorTypeNone || type >= SensorTypeCount) {
+    return false;
+  }
+  found[count].type = type;
+  found[count++].address = address;
+  return true;
+}
+
+size_t SensorDiscovery::save(Print &out) const {
+  uint8_t buff[3 + SENSOR_DISCOVERY_MAX*2 + 1];
+  uint8_t len = 0;
+  buff[len++] = TopologyMagic;
+  buff[len++] = TopologyVersion;
+  buff[len++] = count;
+  for(uint8_t i=0;i<count;i++) {
+    buff[len++] = found[i].type;
+    buff[len++] = found[i].address;
+  }
+  buff[len] = sensorsCrc8(buff, len, 0xFF);
+  len++;
+  return out.write(buff, len);
+}
+
+bool SensorDiscovery::load(Stream &in) {
+  uint8_t buff[3 + SENSOR_DISCOVERY_MAX*2 + 1];
+  if(in.readBytes(buff, 3) != 3 || buff[0] != TopologyMagic || buff[1] != TopologyVersion || buff[2] > SENSOR_DISCOVERY_MAX) {
+    return false;
+  }
+  uint8_t len = buff[2]*2 + 1;
+  if(in.readBytes(buff + 3, len) != len || sensorsCrc8(buff, len + 2, 0xFF) != buff[len + 2]) {
+    return false;
+  }
+  count = 0;
+  for(uint8_t i=0;i<buff[2];i++) {
+    if(!add((SensorType)buff[3 + i*2], buff[4 + i*2])) {
+      count = 0;
+      return false;
+    }
+  }
+  return true;
+}
+
+uint8_t SensorDiscovery::createSensors(Sensor *sensors[], uint8_t max, float altitude) const {
+  uint8_t created = 0;
+  for(uint8_t i=0;i<count && created<max;i++) {
+    Sensor *s = createSensor(found[i].type, found[i].address, altitude, wire);
+    if(s) {
+      sensors[created++] = s;
+    }
+  }
+  return created;
+}
+
+Sensor *SensorDiscovery::createSensor(SensorType type, uint8_t address, float altitude, TwoWire &wire) {
+  // not used when drivers are not compiled in
+  (void)address;
+  (void)altitude;
+  (void)wire;
+  switch(type) {
+#ifdef SENSORS_INCLUDE_BME280
+    case SensorTypeBME280:
+      return new BME280Sensor(altitude, address, wire);
+#endif
+#ifdef SENSORS_INCLUDE_BMP280
+    case SensorTypeBMP280:
+      return new BMP280Sensor(altitude, wire);
+#endif
+#ifdef SENSORS_INCLUDE_SHTX
+    case SensorTypeSHT31:
+      return new SHT31Sensor(wire);
+    case SensorTypeSHTC3:
+      return new SHTC3Sensor(wire);
+#endif
+#ifdef SENSORS_INCLUDE_SHT4X
+    case SensorTypeSHT4X:
+      return new SHT4XSensor(wire);
+#endif
+#ifdef SENSORS_INCLUDE_SI702X
+    case SensorTypeSI702x:
+      return new SI702xSensor(wire);
+#endif
+#ifdef SENSORS_INCLUDE_HTU21D
+    case SensorTypeHTU21D:
+      return new HTU21DSensor(wire);
+#endif
+#ifdef SENSORS_INCLUDE_BH1750
+    case SensorTypeBH1750:
+      return new BH1750Sensor(wire);
+#endif
+#ifdef SENSORS_INCLUDE_CCS811
+    case SensorTypeCCS811:
+      return &wire == &Wire?new CCS811Sensor():nullptr;
+#endif
+#ifdef SENSORS_INCLUDE_SCD30
+    case SensorTypeSCD30:
+      return new SCD30Sensor(wire);
+#endif
+#ifdef SENSORS_INCLUDE_SCD41
+    case SensorTypeSCD41:
+      return new SCD41Sensor(wire);
+#endif
+#ifdef SENSORS_INCLUDE_SEN54
+    case SensorTypeSEN54:
+      return new SEN54Sensor(wire);
+#endif
+#ifdef SENSORS_INCLUDE_SGP40
+    case SensorTypeSGP40:
+      return new SGP40Sensor(1, wire);
+#endif
+#ifdef SENSORS_INCLUDE_SGP41
+    case SensorTypeSGP41:
+      return new SGP41Sensor(1, wire);
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+bool SensorDiscovery::probe(uint8_t address) {
+  wire.beginTransmission(address);
+  return wire.endTransmission() == 0;
+}
+
+bool SensorDiscovery::readRegister(uint8_t address, uint8_t reg, uint8_t &value) {
+  wire.beginTransmission(address);
+  wire.write(reg);
+  if(wire.endTransmission() != 0 || wire.requestFrom(address, (uint8_t)1) != 1) {
+    return false;
+  }
+  value = wire.read();
+  return true;
+}
+
+bool SensorDiscovery::readCommand(uint8_t address, const uint8_t *command, uint8_t commandLen, uint8_t *data, uint8_t len, uint8_t delayMs) {
+  wire.beginTransmission(address);
+  wire.write(command, commandLen);
+  if(wire.endTransmission() != 0) {
+    return false;
+  }
+  if(delayMs) {
+    delay(delayMs);
+  }
+  if(wire.requestFrom(address, len) != len) {
+    return false;
+  }
+  for(uint8_t i=0;i<len;i++) {
+    data[i] = wire.read();
+  }
+  return true;
+}
+
+bool SensorDiscovery::readWord(uint8_t address, uint16_t command, uint8_t delayMs, uint16_t *value) {
+  const uint8_t cmd[] = { (uint8_t)(command >> 8), (uint8_t)command };
+  uint8_t buff[3];
+  if(!readCommand(address, cmd, sizeof(cmd), buff, sizeof(buff), delayMs) || sensorsCrc8(buff, 2, 0xFF) != buff[2]) {
+    return false;
+  }
+  if(value) {
+    *value = (buff[0] << 8) | buff[1];
+  }
+  return true;
+}
+
+// Si702x reports device ID in the second part of the electronic serial number. Other devices at 0x40 are taken
+// for HTU21D only if they return a temperature measurement with valid CRC (initialized by 0) and status bits,
+// so that unrelated parts (e.g. INA219 current monitor) are not mistaken for it
+SensorType SensorDiscovery::identify0x40() {
+  static const uint8_t readId2[] = { 0xFC, 0xC9 };
+  static const uint8_t measureTemperature[] = { 0xF3 };
+  uint8_t buff[6];
+  if(readCommand(0x40, readId2, sizeof(readId2), buff, sizeof(buff), 0)) {
+    switch(buff[0]) {
+      case 0x0D: // Si7013
+      case 0x14: // Si7020
+      case 0x15: // Si7021
+        return SensorTypeSI702x;
+    }
+  }
+  // no hold measurement takes max 50ms, LSB bit 1 is 0 for temperature and bit 0 is always 0
+  if(readCommand(0x40, measureTemperature, sizeof(measureTemperature), buff, 3, 50)
+    && sensorsCrc8(buff, 2, 0x00) == buff[2] && !(buff[1] & 0x03)) {
+    return SensorTypeHTU21D;
+  }
+  return SensorTypeNone;
+}
+
+// SHT4x answers the single byte serial number command, SHT3x needs two byte commands and is verified by its status register
+SensorType SensorDiscovery::identify0x44() {
+  static const uint8_t readSerial[] = { 0x89 };
+  uint8_t buff[6];
+  if(readCommand(0x44, readSerial, sizeof(readSerial), buff, sizeof(buff), 1)
+    && sensorsCrc8(buff, 2, 0xFF) == buff[2] && sensorsCrc8(buff+3, 2, 0xFF) == buff[5]) {
+    return SensorTypeSHT4X;
+  }
+  if(readWord(0x44, SHT3xStatus, 1)) {
+    return SensorTypeSHT31;
+  }
+  return SensorTypeNone;
+}
+
+// Both SGP40 and SGP41 return serial number (three words with CRC, SGP40 datasheet, ch4.4), which is read first,
+// so no SGP41 command is written to another device. SGP40 doesn't acknowledge SGP41 commands. Conditioning
+// (with default compensation) is accepted only by SGP41, heater is then turned off until the sensor is initialized.
+// Turning it off takes 1 ms, so the driver can init right after scan
+SensorType SensorDiscovery::identify0x59() {
+  static const uint8_t conditioning[] = { 0x26, 0x12, 0x80, 0x00, 0xA2, 0x66, 0x66, 0x93 };
+  static const uint8_t heaterOff[] = { 0x36, 0x15 };
+  static const uint8_t readSerial[] = { (uint8_t)(SGPSerialNumber >> 8), (uint8_t)SGPSerialNumber };
+  uint8_t buff[9];
+  if(!readCommand(0x59, readSerial, sizeof(readSerial), buff, sizeof(buff), 1)) {
+    return SensorTypeNone;
+  }
+  for(uint8_t i=0;i<sizeof(buff);i+=3) {
+    if(sensorsCrc8(buff+i, 2, 0xFF) != buff[i+2]) {
+      return SensorTypeNone;
+    }
+  }
+  wire.beginTransmission(0x59);
+  wire.write(conditioning, sizeof(conditioning));
+  if(wire.endTransmission() != 0) {
+    return SensorTypeSGP40;
+  }
+  delay(50);
+  wire.requestFrom((uint8_t)0x59, (uint8_t)3);
+  while(wire.available()) {
+    wire.read();
+  }
+  wire.beginTransmission(0x59);
+  wire.write(heaterOff, sizeof(heaterOff));
+  wire.endTransmission();
+  delay(1);
+  return SensorTypeSGP41;
+}
+
+// SHTC3 ID has bits 11 and 5:0 fixed (SHTC3 datasheet, ch5.9). The driver leaves it sleeping, so it's woken up first (240 us).
+// SHTC3 doesn't return data without a command, while other devices at 0x70 do: TCA9548A I2C multiplexer its channel register,
+// HT16K33 LED driver its display RAM. These are not written to, as the multiplexer would take the commands for channel selection
+SensorType SensorDiscovery::identify0x70() {
+  const uint8_t wakeUp[] = { (uint8_t)(SHTC3WakeUp >> 8), (uint8_t)SHTC3WakeUp };
+  uint16_t id;
+  if(wire.requestFrom((uint8_t)0x70, (uint8_t)1) != 0) {
+    while(wire.available()) {
+      wire.read();
+    }
+    return SensorTypeNone;
+  }
+  wire.beginTransmission(0x70);
+  wire.write(wakeUp, sizeof(wakeUp));
+  wire.endTransmission();
+  delay(1);
+  if(readWord(0x70, SHTC3ReadId, 1, &id) && (id & 0x083F) == 0x0807) {
+    return SensorTypeSHTC3;
+  }
+  return SensorTypeNone;
+}
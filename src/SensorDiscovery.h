@@ -0,0 +1,75 @@
+#ifndef SENSOR_DISCOVERY_H
+#define SENSOR_DISCOVERY_H
+
+#include "Sensors.h"
+#include <Wire.h>
+
+#ifndef SENSOR_DISCOVERY_MAX
+#define SENSOR_DISCOVERY_MAX 16
+#endif
+
+// I2C sensors which can be discovered
+enum SensorType : uint8_t {
+  SensorTypeNone = 0,
+  SensorTypeBME280,
+  SensorTypeBMP280,
+  SensorTypeSHT31,
+  SensorTypeSHTC3,
+  SensorTypeSHT4X,
+  SensorTypeSI702x,
+  SensorTypeHTU21D,
+  SensorTypeBH1750,
+  SensorTypeCCS811,
+  SensorTypeSCD30,
+  SensorTypeSCD41,
+  SensorTypeSEN54,
+  SensorTypeSGP40,
+  SensorTypeSGP41,
+  SensorTypeCount
+};
+
+struct DiscoveredSensor {
+  SensorType type;
+  uint8_t address;
+};
+
+// Finds supported sensors on an I2C bus (it must be already started) by probing only their known addresses
+// and ID registers, so missing devices don't cost driver init timeouts.
+// The found topology can be saved (e.g. into a file or RTC memory) and loaded on next boot to skip probing.
+class SensorDiscovery {
+  protected:
+    DiscoveredSensor found[SENSOR_DISCOVERY_MAX];
+    uint8_t count;
+    TwoWire &wire;
+  public:
+    SensorDiscovery(TwoWire &wire = Wire):count(0),wire(wire) {}
+    // Probes the bus, returns number of found sensors
+    uint8_t scan();
+    // Writes topology in a compact binary form, returns number of written bytes
+    size_t save(Print &out) const;
+    // Reads topology written by save(), returns false and keeps nothing if data are missing or corrupted
+    bool load(Stream &in);
+    void clear() { count = 0; }
+    // Adds sensor to topology manually
+    bool add(SensorType type, uint8_t address);
+    uint8_t getCount() const { return count; }
+    const DiscoveredSensor &get(uint8_t index) const { return found[index]; }
+    // Creates (but doesn't initialize) sensors of the topology on the bus of the discovery. Altitude is used by pressure sensors.
+    // Returns number of created sensors, caller owns them
+    uint8_t createSensors(Sensor *sensors[], uint8_t max, float altitude = 0) const;
+    // Returns nullptr if driver of the type is not compiled in or it cannot use the bus (CCS811 works only on Wire)
+    static Sensor *createSensor(SensorType type, uint8_t address, float altitude = 0, TwoWire &wire = Wire);
+  protected:
+    bool probe(uint8_t address);
+    bool readRegister(uint8_t address, uint8_t reg, uint8_t &value);
+    bool readCommand(uint8_t address, const uint8_t *command, uint8_t commandLen, uint8_t *data, uint8_t len, uint8_t delayMs);
+    // Sends two byte command of a Sensirion device and reads its single word response into value (if set),
+    // returns false if CRC doesn't match
+    bool readWord(uint8_t address, uint16_t command, uint8_t delayMs, uint16_t *value = nullptr);
+    SensorType identify0x40();
+    SensorType identify0x44();
+    SensorType identify0x59();
+    SensorType identify0x70();
+};
+
+#endif //SENSOR_DISCOVERY_H
@@ -0,0 +1,201 @@
+#include "SensorFilters.h"
+
+ValueFilter &ValueFilter::then(ValueFilter &filter) {
+  ValueFilter *last = this;
+  while(last->next) {
+    last = last->next;
+  }
+  last->next = &filter;
+  return *this;
+}
+
+bool ValueFilter::filter(float &value) {
+  if(isnan(value)) {
+    return true;
+  }
+  for(ValueFilter *f = this; f; f = f->next) {
+    if(!f->process(value)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ValueFilter::reset() {
+  for(ValueFilter *f = this; f; f = f->next) {
+    f->clear();
+  }
+}
+
+// ===========  SortedWindow  ==================
+
+SortedWindow::SortedWindow(uint8_t size):size(size?size:1),count(0),pos(0) {
+  ring = new float[this->size];
+  sorted = new float[this->size];
+}
+
+SortedWindow::~SortedWindow() {
+  delete [] ring;
+  delete [] sorted;
+}
+
+uint8_t SortedWindow::lowerBound(float value) const {
+  uint8_t lo = 0, hi = count;
+  while(lo < hi) {
+    uint8_t mid = (lo + hi) / 2;
+    if(sorted[mid] < value) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+void SortedWindow::add(float value) {
+  if(isnan(value)) {
+    return;
+  }
+  if(count == size) {
+    // remove the oldest sample
+    uint8_t i = lowerBound(ring[pos]);
+    memmove(sorted + i, sorted + i + 1, (count - i - 1) * sizeof(float));
+    count--;
+  }
+  uint8_t i = lowerBound(value);
+  memmove(sorted + i + 1, sorted + i, (count - i) * sizeof(float));
+  sorted[i] = value;
+  count++;
+  ring[pos] = value;
+  pos = (pos + 1) % size;
+}
+
+float SortedWindow::median() const {
+  if(!count) {
+    return NAN;
+  }
+  return count & 1?sorted[count/2]:(sorted[count/2 - 1] + sorted[count/2]) / 2;
+}
+
+float SortedWindow::mad(float median) const {
+  if(!count) {
+    return NAN;
+  }
+  uint8_t split = lowerBound(median);
+  float cur = deviation(median, split, count/2);
+  return count & 1?cur:(deviation(median, split, count/2 - 1) + cur) / 2;
+}
+
+// Deviations left of split grow to the left, right of it to the right. The k-th smallest (from 0) of both sequences is
+// found by binary search of how many of the first k+1 deviations come from the left one
+float SortedWindow::deviation(float median, uint8_t split, uint8_t k) const {
+  uint8_t left = split, right = count - split;
+  uint8_t lo = k + 1 > right?k + 1 - right:0;
+  uint8_t hi = k + 1 < left?k + 1:left;
+  while(lo < hi) {
+    uint8_t i = (lo + hi) / 2;
+    uint8_t j = k + 1 - i;
+    // i-th left deviation is not smaller than the last taken right one
+    if(j == 0 || median - sorted[split - 1 - i] >= sorted[split + j - 1] - median) {
+      hi = i;
+    } else {
+      lo = i + 1;
+    }
+  }
+  uint8_t j = k + 1 - lo;
+  float leftDev = lo?median - sorted[split - lo]:0;
+  float rightDev = j?sorted[split + j - 1] - median:0;
+  return leftDev > rightDev?leftDev:rightDev;
+}
+
+// ===========  Filters  ==================
+
+bool MedianFilter::process(float &value) {
+  window.add(value);
+  value = window.median();
+  return true;
+}
+
+// Scale of MAD to standard deviation of normal distribution
+static const float MadScale = 1.4826;
+
+bool HampelFilter::process(float &value) {
+  lastRejected = false;
+  float median = window.median();
+  float deviation = fabsf(value - median);
+  // raw samples enter the window, so a real step change is accepted once it fills half of the window
+  bool outlier = window.getCount() >= 3 && deviation > minDeviation && deviation > threshold * MadScale * window.mad(median);
+  window.add(value);
+  if(outlier) {
+    lastRejected = true;
+    rejected++;
+    if(!replace) {
+      return false;
+    }
+    value = median;
+  }
+  return true;
+}
+
+bool EmaFilter::process(float &value) {
+  if(!initialized) {
+    this->value = value;
+    initialized = true;
+  } else {
+    this->value += alpha * (value - this->value);
+  }
+  value = this->value;
+  return true;
+}
+
+// ===========  FilterPipeline  ==================
+
+bool FilterPipeline::attach(Sensor &sensor, const char *key, ValueFilter &filter) {
+  if(bindingsCount == FILTER_PIPELINE_MAX_BINDINGS) {
+    return false;
+  }
+  Binding &b = bindings[bindingsCount++];
+  b.sensor = &sensor;
+  b.key = key;
+  b.filter = &filter;
+  b.lastValue = NAN;
+  b.rejected = false;
+  sensor.setReadingProcessor(this);
+  return true;
+}
+
+FilterPipeline::Binding *FilterPipeline::find(const Sensor *sensor, const char *key) {
+  for(uint8_t i=0;i<bindingsCount;i++) {
+    if(bindings[i].sensor == sensor && (bindings[i].key == key || !strcmp(bindings[i].key, key))) {
+      return &bindings[i];
+    }
+  }
+  return nullptr;
+}
+
+bool FilterPipeline::isRejected(const Sensor &sensor, const char *key) const {
+  Binding *b = const_cast<FilterPipeline *>(this)->find(&sensor, key);
+  return b && b->rejected;
+}
+
+void FilterPipeline::process(Sensor &sensor) {
+  this->sensor = &sensor;
+  sensor.writeFields(*this);
+  this->sensor = nullptr;
+}
+
+// Gets raw values of the read from the sensor and stores filtered ones back
+void FilterPipeline::addField(const char *key, float value) {
+  Binding *b = find(sensor, key);
+  if(!b) {
+    return;
+  }
+  b->rejected = !b->filter->filter(value);
+  if(b->rejected) {
+    rejected++;
+    value = b->lastValue;
+  } else {
+    b->lastValue = value;
+  }
+  sensor->setField(key, value);
+}
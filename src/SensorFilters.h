@@ -0,0 +1,132 @@
+#ifndef SENSOR_FILTERS_H
+#define SENSOR_FILTERS_H
+
+#include "SensorBase.h"
+
+#ifndef FILTER_PIPELINE_MAX_BINDINGS
+#define FILTER_PIPELINE_MAX_BINDINGS 8
+#endif
+
+// Filter of a stream of values. Filters are chained by then(), value passes the chain until some filter rejects it.
+// Buffers are allocated in constructors, filtering doesn't use heap.
+class ValueFilter {
+  protected:
+    ValueFilter *next = nullptr;
+    uint32_t rejected = 0;
+  public:
+    virtual ~ValueFilter() {}
+    // Appends filter to the end of chain, returns this filter, so calls can be chained
+    ValueFilter &then(ValueFilter &filter);
+    // Passes value through the chain, returns false if a filter rejected it. NAN passes unchanged
+    bool filter(float &value);
+    // Clears history of whole chain
+    void reset();
+    // Number of samples rejected or replaced by this filter
+    uint32_t getRejectedCount() const { return rejected; }
+  protected:
+    // Filters value in place, returns false to drop it
+    virtual bool process(float &value) = 0;
+    virtual void clear() = 0;
+};
+
+// Keeps window of samples sorted, insertion and removal cost binary search and a move of at most window size values.
+// The move is a single memmove of up to 255 floats, cheaper than rebalancing a tree for windows used on MCUs, but it is O(w).
+// Median is O(1), MAD O(log w)
+class SortedWindow {
+  protected:
+    float *ring;
+    float *sorted;
+    uint8_t size;
+    uint8_t count;
+    uint8_t pos;
+  public:
+    SortedWindow(uint8_t size);
+    ~SortedWindow();
+    // NAN is skipped, it has no place in the order
+    void add(float value);
+    void clear() { count = 0; pos = 0; }
+    uint8_t getCount() const { return count; }
+    float median() const;
+    // Median of absolute deviations from median, selected from both halves of sorted window without merging them
+    float mad(float median) const;
+  protected:
+    uint8_t lowerBound(float value) const;
+    // k-th smallest absolute deviation from median, split is index of the first sample not lower than median
+    float deviation(float median, uint8_t split, uint8_t k) const;
+};
+
+// Moving median of the last window samples, removes single sample spikes
+class MedianFilter : public ValueFilter {
+  protected:
+    SortedWindow window;
+  public:
+    MedianFilter(uint8_t window):window(window) {}
+  protected:
+    virtual bool process(float &value) override;
+    virtual void clear() override { window.clear(); }
+};
+
+// Hampel filter rejects samples further than threshold * scaled MAD from median of the last window samples.
+// A sample costs O(log w) comparisons and the O(w) memmove of the sorted window.
+// Outliers are replaced by the median or dropped. Deviations up to minDeviation are always accepted, for sensors with coarse resolution
+class HampelFilter : public ValueFilter {
+  protected:
+    SortedWindow window;
+    float threshold;
+    float minDeviation;
+    bool replace;
+    bool lastRejected = false;
+  public:
+    HampelFilter(uint8_t window, float threshold = 3, bool replace = true, float minDeviation = 0):
+      window(window),threshold(threshold),minDeviation(minDeviation),replace(replace) {}
+    bool isLastRejected() const { return lastRejected; }
+  protected:
+    virtual bool process(float &value) override;
+    virtual void clear() override { window.clear(); }
+};
+
+// Exponential moving average, alpha in (0,1] is weight of the new sample
+class EmaFilter : public ValueFilter {
+  protected:
+    float alpha;
+    float value;
+    bool initialized = false;
+  public:
+    EmaFilter(float alpha):alpha(alpha) {}
+  protected:
+    virtual bool process(float &value) override;
+    virtual void clear() override { initialized = false; }
+};
+
+// Attaches filter chains to fields of sensors. Filters run once per successful read (as the reading processor of the sensor),
+// after the read is recorded and before it's published, so the sensor keeps the filtered values and all its consumers
+// (writeFields(), getValue(), registry, snapshot, sensor sets) see them. A sensor can be filtered by a single pipeline.
+// Rejected values are replaced by the last accepted value of the field and flagged until next sample. NAN values are not filtered
+class FilterPipeline : public ReadingProcessor, public FieldSink {
+  protected:
+    struct Binding {
+      const Sensor *sensor;
+      const char *key;
+      ValueFilter *filter;
+      float lastValue;
+      bool rejected;
+    };
+    Binding bindings[FILTER_PIPELINE_MAX_BINDINGS];
+    uint8_t bindingsCount = 0;
+    Sensor *sensor = nullptr;
+    uint32_t rejected = 0;
+  public:
+    // Filters field key of sensor by the chain starting with filter
+    bool attach(Sensor &sensor, const char *key, ValueFilter &filter);
+    // Filters fields of the sensor and stores results into it, called by the sensor after a successful read
+    virtual void process(Sensor &sensor) override;
+    // Returns true if the last value of field was rejected
+    bool isRejected(const Sensor &sensor, const char *key) const;
+    uint32_t getRejectedCount() const { return rejected; }
+  protected:
+    Binding *find(const Sensor *sensor, const char *key);
+    virtual void addField(const char *key, float value) override;
+    virtual void addField(const char *key, int32_t value) override { addField(key, (float)value); }
+};
+
+#endif //SENSOR_FILTERS_H
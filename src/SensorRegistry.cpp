@@ -0,0 +1,119 @@
+#include "SensorRegistry.h"
+
+SensorRegistry::SensorRegistry() {
+  clear();
+}
+
+uint8_t SensorRegistry::capabilityIndex(SensorCapability capability) {
+  uint16_t mask = capability;
+  // exactly one known bit, __builtin_ctz() is undefined for 0
+  if(!mask || (mask & (mask-1)) || mask >= (1<<SENSOR_CAPABILITIES_COUNT)) {
+    return SENSOR_CAPABILITIES_COUNT;
+  }
+  return __builtin_ctz(mask);
+}
+
+void SensorRegistry::clear() {
+  memset(counts, 0, sizeof(counts));
+}
+
+bool SensorRegistry::add(Sensor *sensor, int8_t priority) {
+  uint16_t caps = sensor->getCapabilities();
+  bool ok = true;
+  for(uint8_t i=0;i<SENSOR_CAPABILITIES_COUNT;i++) {
+    if(!(caps & (1<<i)) || find(i, sensor) >= 0) {
+      continue;
+    }
+    if(counts[i] == SENSOR_REGISTRY_MAX_PROVIDERS) {
+      ok = false;
+      continue;
+    }
+    insert(i, sensor, priority);
+  }
+  return ok;
+}
+
+// Inserts provider after all providers with the same or higher priority
+void SensorRegistry::insert(uint8_t index, Sensor *sensor, int8_t priority) {
+  Provider *list = providers[index];
+  uint8_t pos = counts[index];
+  while(pos > 0 && list[pos-1].priority < priority) {
+    list[pos] = list[pos-1];
+    pos--;
+  }
+  list[pos].sensor = sensor;
+  list[pos].priority = priority;
+  counts[index]++;
+}
+
+int8_t SensorRegistry::find(uint8_t index, Sensor *sensor) const {
+  for(uint8_t i=0;i<counts[index];i++) {
+    if(providers[index][i].sensor == sensor) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+bool SensorRegistry::setPriority(Sensor *sensor, SensorCapability capability, int8_t priority) {
+  uint8_t index = capabilityIndex(capability);
+  if(index == SENSOR_CAPABILITIES_COUNT) {
+    return false;
+  }
+  int8_t pos = find(index, sensor);
+  if(pos < 0) {
+    return false;
+  }
+  Provider *list = providers[index];
+  for(uint8_t i=pos+1;i<counts[index];i++) {
+    list[i-1] = list[i];
+  }
+  counts[index]--;
+  insert(index, sensor, priority);
+  return true;
+}
+
+void SensorRegistry::remove(Sensor *sensor) {
+  for(uint8_t i=0;i<SENSOR_CAPABILITIES_COUNT;i++) {
+    int8_t pos = find(i, sensor);
+    if(pos < 0) {
+      continue;
+    }
+    for(uint8_t j=pos+1;j<counts[i];j++) {
+      providers[i][j-1] = providers[i][j];
+    }
+    counts[i]--;
+  }
+}
+
+uint8_t SensorRegistry::getProvidersCount(SensorCapability capability) const {
+  uint8_t i = capabilityIndex(capability);
+  return i < SENSOR_CAPABILITIES_COUNT?counts[i]:0;
+}
+
+Sensor *SensorRegistry::getProvider(SensorCapability capability, uint8_t index) const {
+  uint8_t i = capabilityIndex(capability);
+  if(i == SENSOR_CAPABILITIES_COUNT) {
+    return nullptr;
+  }
+  return index < counts[i]?providers[i][index].sensor:nullptr;
+}
+
+Sensor *SensorRegistry::getBest(SensorCapability capability) const {
+  uint8_t i = capabilityIndex(capability);
+  if(i == SENSOR_CAPABILITIES_COUNT) {
+    return nullptr;
+  }
+  for(uint8_t j=0;j<counts[i];j++) {
+    if(providers[i][j].sensor->getStatus()) {
+      return providers[i][j].sensor;
+    }
+  }
+  return nullptr;
+}
+
+bool SensorRegistry::getValue(SensorCapability capability, float &value) const {
+  // invalid mask has no best provider
+  Sensor *s = getBest(capability);
+  return s && s->getValue(capability, value);
+}
@@ -0,0 +1,45 @@
+#ifndef SENSOR_REGISTRY_H
+#define SENSOR_REGISTRY_H
+
+#include "SensorBase.h"
+
+#ifndef SENSOR_REGISTRY_MAX_PROVIDERS
+#define SENSOR_REGISTRY_MAX_PROVIDERS 4
+#endif
+
+// Index of sensors by capability. Sensors are indexed once when added, so finding a provider
+// of a capability doesn't iterate over all sensors.
+// Providers of each capability are ordered by priority, higher first; equal priorities keep order of adding.
+// Sensors are not deleted by the registry.
+class SensorRegistry {
+  protected:
+    struct Provider {
+      Sensor *sensor;
+      int8_t priority;
+    };
+    Provider providers[SENSOR_CAPABILITIES_COUNT][SENSOR_REGISTRY_MAX_PROVIDERS];
+    uint8_t counts[SENSOR_CAPABILITIES_COUNT];
+  public:
+    SensorRegistry();
+    // Adds sensor as a provider of all its capabilities. Returns false if some capability has already max providers
+    bool add(Sensor *sensor, int8_t priority = 0);
+    // Changes priority of the sensor for a single capability.
+    // Methods taking a capability accept a single SensorCapability bit, other masks fail (false, nullptr or 0)
+    bool setPriority(Sensor *sensor, SensorCapability capability, int8_t priority);
+    void remove(Sensor *sensor);
+    void clear();
+    uint8_t getProvidersCount(SensorCapability capability) const;
+    // Returns provider of the capability in order of priority, nullptr if none
+    Sensor *getProvider(SensorCapability capability, uint8_t index = 0) const;
+    // Returns the highest priority provider, which has valid reading, nullptr if none
+    Sensor *getBest(SensorCapability capability) const;
+    // Sets value from the best provider, returns false if no provider has valid reading
+    bool getValue(SensorCapability capability, float &value) const;
+    // Converts single capability bit into index, returns SENSOR_CAPABILITIES_COUNT for 0, several bits or unknown bits
+    static uint8_t capabilityIndex(SensorCapability capability);
+  protected:
+    void insert(uint8_t index, Sensor *sensor, int8_t priority);
+    int8_t find(uint8_t index, Sensor *sensor) const;
+};
+
+#endif //SENSOR_REGISTRY_H
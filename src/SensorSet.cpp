@@ -0,0 +1,98 @@
+#include "SensorSet.h"
+#include "BusAcquisition.h"
+#include <sys/time.h>
+
+// Time before which system clock is considered as not set (2020-01-01)
+static const time_t MinValidTime = 1577836800;
+
+SensorSet::SensorSet(uint8_t capacity, const char *measurement, size_t batchSize, uint16_t maxCycles):
+  sensors(new Sensor*[capacity]),finishTimes(new uint32_t[capacity]),timestamps(new uint64_t[capacity]),
+  capacity(capacity),count(0),measurement(measurement),tagsCount(0),
+  batch(new char[batchSize]),writer(batch, batchSize),maxCycles(maxCycles),cycles(0),droppedLines(0),parallelBuses(false) {
+}
+
+SensorSet::~SensorSet() {
+  delete [] sensors;
+  delete [] finishTimes;
+  delete [] timestamps;
+  delete [] batch;
+}
+
+bool SensorSet::add(Sensor *sensor) {
+  if(count == capacity) {
+    return false;
+  }
+  timestamps[count] = 0;
+  sensors[count++] = sensor;
+  return true;
+}
+
+bool SensorSet::addTag(const char *key, const char *value) {
+  if(tagsCount == SENSOR_SET_MAX_TAGS) {
+    return false;
+  }
+  tagKeys[tagsCount] = key;
+  tagValues[tagsCount++] = value;
+  return true;
+}
+
+uint8_t SensorSet::initAll() {
+  uint8_t ok = 0;
+  for(uint8_t i=0;i<count;i++) {
+    if(sensors[i]->begin()) {
+      ok++;
+    }
+  }
+  return ok;
+}
+
+uint8_t SensorSet::acquire(uint32_t timeout) {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  uint64_t startEpoch = tv.tv_sec < MinValidTime?0:(uint64_t)tv.tv_sec*1000 + tv.tv_usec/1000;
+  uint32_t start = sensorsMillis();
+  uint8_t ok = parallelBuses?readAllByBus(sensors, count, timeout, finishTimes):Sensor::readAll(sensors, count, timeout, finishTimes);
+  bool complete = true;
+  for(uint8_t i=0;i<count;i++) {
+    Sensor *s = sensors[i];
+    if(!s->getStatus()) {
+      continue;
+    }
+    timestamps[i] = startEpoch?startEpoch + (finishTimes[i] - start):0;
+    // writer drops everything after an overflow, until the batch is cleared
+    if(!writer.isOverflow()) {
+      writer.beginLine(measurement);
+      for(uint8_t t=0;t<tagsCount;t++) {
+        writer.addTag(tagKeys[t], tagValues[t]);
+      }
+      writer.addTag("sensor", s->getName().c_str());
+      s->writeFields(writer);
+      writer.endLine(timestamps[i]);
+    }
+    if(writer.isOverflow()) {
+      droppedLines++;
+      complete = false;
+    }
+  }
+  if(complete) {
+    cycles++;
+  }
+  return ok;
+}
+
+bool SensorSet::flush(InfluxDBClient &client) {
+  if(!writer.length()) {
+    clearBatch();
+    return true;
+  }
+  if(!client.writeRecord(batch)) {
+    return false;
+  }
+  clearBatch();
+  return true;
+}
+
+void SensorSet::clearBatch() {
+  writer.clear();
+  cycles = 0;
+}
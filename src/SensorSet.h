@@ -0,0 +1,66 @@
+#ifndef SENSOR_SET_H
+#define SENSOR_SET_H
+
+#include "SensorBase.h"
+
+#ifndef SENSOR_SET_MAX_TAGS
+#define SENSOR_SET_MAX_TAGS 4
+#endif
+
+// Collection of sensors, which runs acquisition cycles and collects results of several cycles
+// as line protocol into a preallocated batch buffer, so they can be written in a single request.
+// Each successfully read sensor adds a line with the measurement name, tag sensor=<sensor name> and
+// the acquisition timestamp in milliseconds (configure client with WritePrecision::MS).
+// Sensors are not deleted by the set.
+class SensorSet {
+  protected:
+    Sensor **sensors;
+    uint32_t *finishTimes;
+    uint64_t *timestamps;
+    uint8_t capacity;
+    uint8_t count;
+    const char *measurement;
+    const char *tagKeys[SENSOR_SET_MAX_TAGS];
+    const char *tagValues[SENSOR_SET_MAX_TAGS];
+    uint8_t tagsCount;
+    char *batch;
+    LineProtocolWriter writer;
+    uint16_t maxCycles;
+    uint16_t cycles;
+    uint32_t droppedLines;
+    bool parallelBuses;
+  public:
+    // capacity is max number of sensors, batchSize is size of the batch buffer in bytes, maxCycles is number of cycles after which the batch is full
+    SensorSet(uint8_t capacity, const char *measurement, size_t batchSize, uint16_t maxCycles);
+    ~SensorSet();
+    bool add(Sensor *sensor);
+    // Adds tag to all lines. Key and value must remain valid
+    bool addTag(const char *key, const char *value);
+    // Initializes all sensors, returns number of successfully initialized
+    uint8_t initAll();
+    // Reads all sensors with overlapped conversions and appends lines of successfully read sensors to the batch.
+    // Failed sensors are skipped. Lines which don't fit into the batch are dropped and counted, see getDroppedLines().
+    // Returns number of successfully read sensors
+    uint8_t acquire(uint32_t timeout = 2000);
+    // Reads sensors of each I2C bus by their own task, see readAllByBus()
+    void setParallelBuses(bool enable) { parallelBuses = enable; }
+    // Writes batch in a single request and clears it on success
+    bool flush(InfluxDBClient &client);
+    void clearBatch();
+    // Returns true when batch contains maxCycles cycles or some lines didn't fit
+    bool isBatchFull() const { return cycles >= maxCycles || writer.isOverflow(); }
+    // Returns true if some lines didn't fit into the batch, later lines are dropped until the batch is cleared
+    bool isOverflow() const { return writer.isOverflow(); }
+    // Returns number of lines dropped since construction, because they didn't fit into the batch
+    uint32_t getDroppedLines() const { return droppedLines; }
+    // Returns number of cycles with all lines in the batch
+    uint16_t getCyclesCount() const { return cycles; }
+    const char *getBatch() const { return writer.getBuffer(); }
+    size_t getBatchLength() const { return writer.length(); }
+    uint8_t getCount() const { return count; }
+    Sensor *getSensor(uint8_t index) const { return index < count?sensors[index]:nullptr; }
+    // Returns epoch time in ms of the last acquisition of a sensor, 0 if not known
+    uint64_t getTimestamp(uint8_t index) const { return index < count?timestamps[index]:0; }
+};
+
+#endif //SENSOR_SET_H
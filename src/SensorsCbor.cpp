@@ -0,0 +1,412 @@
+#include "SensorsCbor.h"
+#include "SensorsFormat.h"
+
+// CBOR major types
+static const uint8_t CborUnsigned = 0;
+static const uint8_t CborNegative = 1;
+static const uint8_t CborText = 3;
+static const uint8_t CborArray = 4;
+static const uint8_t CborMap = 5;
+static const uint8_t CborSimple = 7;
+// Additional information values
+static const uint8_t CborHalf = 25;
+static const uint8_t CborSingle = 26;
+static const uint8_t CborDouble = 27;
+static const uint8_t CborIndefinite = 31;
+static const uint8_t CborBreak = 0xFF;
+
+// Field schema, id is index + 1. Never change order, only append
+static const char *const CborFieldKeys[] PROGMEM = {
+  Temp, Hum, Press, PressRaw, Co2, Moist, Voc, GasResistance, Light,
+  "nox", "nox_gas_resistance", "pm1.0", "pm2.5", "pm4.0", "pm10.0"
+};
+
+static const uint8_t CborFieldsCount = sizeof(CborFieldKeys)/sizeof(CborFieldKeys[0]);
+
+uint8_t getCborFieldId(const char *key) {
+  for(uint8_t i=0;i<CborFieldsCount;i++) {
+    const char *schemaKey = (const char *)pgm_read_ptr(&CborFieldKeys[i]);
+    if(schemaKey == key || !strcmp(schemaKey, key)) {
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+const char *getCborFieldKey(uint8_t id) {
+  if(!id || id > CborFieldsCount) {
+    return nullptr;
+  }
+  return (const char *)pgm_read_ptr(&CborFieldKeys[id - 1]);
+}
+
+uint16_t floatToHalf(float value) {
+  uint32_t x;
+  memcpy(&x, &value, sizeof(x));
+  uint16_t sign = (x >> 16) & 0x8000;
+  int16_t exp = ((x >> 23) & 0xFF) - 127 + 15;
+  uint32_t mant = x & 0x7FFFFF;
+  if(((x >> 23) & 0xFF) == 0xFF) {
+    // infinity or NaN
+    return sign | 0x7C00 | (mant?0x200:0);
+  }
+  if(exp >= 31) {
+    return sign | 0x7C00;
+  }
+  uint32_t half, rem, mid;
+  if(exp <= 0) {
+    // subnormal half
+    if(exp < -10) {
+      return sign;
+    }
+    mant |= 0x800000;
+    uint8_t shift = 14 - exp;
+    half = mant >> shift;
+    rem = mant & ((1UL << shift) - 1);
+    mid = 1UL << (shift - 1);
+  } else {
+    half = ((uint32_t)exp << 10) | (mant >> 13);
+    rem = mant & 0x1FFF;
+    mid = 0x1000;
+  }
+  // carry into exponent gives correctly rounded result, up to infinity
+  if(rem > mid || (rem == mid && (half & 1))) {
+    half++;
+  }
+  return sign | half;
+}
+
+float halfToFloat(uint16_t half) {
+  uint32_t exp = (half >> 10) & 0x1F;
+  uint32_t mant = half & 0x3FF;
+  if(!exp) {
+    float f = ldexpf(mant, -24);
+    return half & 0x8000?-f:f;
+  }
+  uint32_t x = ((uint32_t)(half & 0x8000) << 16) | (exp == 31?0x7F800000:(exp + 112) << 23) | (mant << 13);
+  float f;
+  memcpy(&f, &x, sizeof(f));
+  return f;
+}
+
+// ===========  CborWriter  ==================
+
+CborWriter::CborWriter(uint8_t *buffer, size_t size):buffer(buffer),size(size) {
+  clear();
+}
+
+void CborWriter::clear() {
+  len = 0;
+  cycleStart = 0;
+  sensorStart = 0;
+  fieldsStart = 0;
+  overflow = false;
+}
+
+void CborWriter::writeByte(uint8_t b) {
+  if(overflow || len == size) {
+    overflow = true;
+    return;
+  }
+  buffer[len++] = b;
+}
+
+void CborWriter::writeHead(uint8_t major, uint64_t value) {
+  major <<= 5;
+  uint8_t bytes;
+  if(value < 24) {
+    writeByte(major | value);
+    return;
+  } else if(value <= 0xFF) {
+    writeByte(major | 24);
+    bytes = 1;
+  } else if(value <= 0xFFFF) {
+    writeByte(major | 25);
+    bytes = 2;
+  } else if(value <= 0xFFFFFFFF) {
+    writeByte(major | 26);
+    bytes = 4;
+  } else {
+    writeByte(major | 27);
+    bytes = 8;
+  }
+  while(bytes--) {
+    writeByte(value >> (bytes*8));
+  }
+}
+
+bool CborWriter::writeKey(const char *key) {
+  uint8_t id = getCborFieldId(key);
+  if(id) {
+    writeHead(CborUnsigned, id);
+    return true;
+  }
+  size_t keyLen = strlen(key);
+  // decoder rejects longer keys, which would make the whole buffer malformed
+  if(keyLen >= CBOR_MAX_KEY_LEN) {
+    skippedFields++;
+    return false;
+  }
+  writeHead(CborText, keyLen);
+  if(overflow || len + keyLen > size) {
+    overflow = true;
+    return true;
+  }
+  memcpy(buffer + len, key, keyLen);
+  len += keyLen;
+  return true;
+}
+
+void CborWriter::beginCycle(uint64_t timestamp) {
+  // previous cycle which didn't fit was dropped, so this one can fit
+  overflow = false;
+  cycleStart = len;
+  writeByte((CborArray << 5) | 2);
+  writeHead(CborUnsigned, timestamp);
+  writeByte((CborMap << 5) | CborIndefinite);
+}
+
+void CborWriter::beginSensor(uint16_t id) {
+  sensorStart = len;
+  writeHead(CborUnsigned, id);
+  writeByte((CborMap << 5) | CborIndefinite);
+  fieldsStart = len;
+}
+
+void CborWriter::addField(const char *key, float value) {
+  if(isnan(value) || !writeKey(key)) {
+    return;
+  }
+  uint16_t half = floatToHalf(value);
+  char text[SENSORS_NUMBER_MAX_LEN], halfText[SENSORS_NUMBER_MAX_LEN];
+  uint8_t textLen = formatFixed(text, value, 2);
+  if(textLen == formatFixed(halfText, halfToFloat(half), 2) && !memcmp(text, halfText, textLen)) {
+    writeByte((CborSimple << 5) | CborHalf);
+    writeByte(half >> 8);
+    writeByte(half);
+  } else {
+    uint32_t x;
+    memcpy(&x, &value, sizeof(x));
+    writeByte((CborSimple << 5) | CborSingle);
+    for(int8_t i=3;i>=0;i--) {
+      writeByte(x >> (i*8));
+    }
+  }
+}
+
+void CborWriter::addField(const char *key, int32_t value) {
+  if(!writeKey(key)) {
+    return;
+  }
+  if(value < 0) {
+    writeHead(CborNegative, -1 - (int64_t)value);
+  } else {
+    writeHead(CborUnsigned, value);
+  }
+}
+
+void CborWriter::endSensor() {
+  // drop sensor without values, e.g. all fields were NAN
+  if(!overflow && len == fieldsStart) {
+    len = sensorStart;
+    return;
+  }
+  writeByte(CborBreak);
+}
+
+void CborWriter::endCycle() {
+  writeByte(CborBreak);
+  // drop cycle which didn't fit, so the buffer contains only complete cycles
+  if(overflow) {
+    len = cycleStart;
+    droppedCycles++;
+  }
+}
+
+void CborWriter::writeSensor(uint16_t id, Sensor &sensor) {
+  if(!sensor.getStatus()) {
+    return;
+  }
+  beginSensor(id);
+  sensor.writeFields(*this);
+  endSensor();
+}
+
+// ===========  Decoder  ==================
+
+class CborReader {
+  protected:
+    const uint8_t *data;
+    size_t length;
+    size_t pos = 0;
+  public:
+    CborReader(const uint8_t *data, size_t length):data(data),length(length) {}
+    bool atEnd() const { return pos >= length; }
+    size_t getPos() const { return pos; }
+    void seek(size_t pos) { this->pos = pos; }
+    // Returns true and skips the byte, if the next is break
+    bool isBreak() {
+      if(pos < length && data[pos] == CborBreak) {
+        pos++;
+        return true;
+      }
+      return false;
+    }
+    // Reads head of data item, info is additional information, value is argument or bytes of a float
+    bool readHead(uint8_t &major, uint8_t &info, uint64_t &value) {
+      if(pos >= length) {
+        return false;
+      }
+      major = data[pos] >> 5;
+      info = data[pos++] & 0x1F;
+      value = info;
+      if(info < 24 || info == CborIndefinite) {
+        return true;
+      }
+      if(info > CborDouble) {
+        return false;
+      }
+      uint8_t bytes = 1 << (info - 24);
+      if(pos + bytes > length) {
+        return false;
+      }
+      value = 0;
+      while(bytes--) {
+        value = (value << 8) | data[pos++];
+      }
+      return true;
+    }
+    bool readText(char *text, uint64_t textLen) {
+      if(textLen >= CBOR_MAX_KEY_LEN || pos + textLen > length) {
+        return false;
+      }
+      memcpy(text, data + pos, textLen);
+      text[textLen] = 0;
+      pos += textLen;
+      return true;
+    }
+};
+
+// Counts values of a sensor map, so it's validated before its line is started
+class CborValuesCounter : public FieldSink {
+  public:
+    uint16_t count = 0;
+    virtual void addField(const char *, float value) override { count += !isnan(value); }
+    virtual void addField(const char *, int32_t) override { count++; }
+};
+
+static bool decodeField(CborReader &reader, FieldSink &writer) {
+  uint8_t major, info;
+  uint64_t value;
+  char text[CBOR_MAX_KEY_LEN];
+  const char *key;
+  if(!reader.readHead(major, info, value)) {
+    return false;
+  }
+  if(major == CborUnsigned) {
+    key = value <= 0xFF?getCborFieldKey(value):nullptr;
+  } else if(major == CborText && info != CborIndefinite && reader.readText(text, value)) {
+    key = text;
+  } else {
+    return false;
+  }
+  if(!key || !reader.readHead(major, info, value)) {
+    return false;
+  }
+  switch(major) {
+    case CborUnsigned:
+    case CborNegative:
+      // writer encodes only int32_t values, larger ones can't be written as line protocol integers
+      if(value > INT32_MAX) {
+        return false;
+      }
+      writer.addField(key, major == CborUnsigned?(int32_t)value:(int32_t)(-1 - (int64_t)value));
+      return true;
+    case CborSimple:
+      if(info == CborHalf) {
+        writer.addField(key, halfToFloat(value));
+      } else if(info == CborSingle) {
+        uint32_t x = value;
+        float f;
+        memcpy(&f, &x, sizeof(f));
+        writer.addField(key, f);
+      } else if(info == CborDouble) {
+        double d;
+        memcpy(&d, &value, sizeof(d));
+        writer.addField(key, (float)d);
+      } else {
+        return false;
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Decodes map items until break or count items
+static bool decodeSensor(CborReader &reader, uint8_t info, uint64_t count, FieldSink &writer) {
+  for(uint64_t i=0;info == CborIndefinite || i < count;i++) {
+    if(info == CborIndefinite && reader.isBreak()) {
+      return true;
+    }
+    if(!decodeField(reader, writer)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int32_t cborToLineProtocol(const uint8_t *data, size_t length, const char *measurement, const char *const sensorNames[], uint16_t sensorsCount, LineProtocolWriter &writer) {
+  CborReader reader(data, length);
+  int32_t cycles = 0;
+  uint8_t major, info;
+  uint64_t value, timestamp;
+  while(!reader.atEnd()) {
+    if(!reader.readHead(major, info, value) || major != CborArray || value != 2) {
+      return -1;
+    }
+    if(!reader.readHead(major, info, timestamp) || major != CborUnsigned) {
+      return -1;
+    }
+    uint8_t mapInfo;
+    uint64_t sensors;
+    if(!reader.readHead(major, mapInfo, sensors) || major != CborMap) {
+      return -1;
+    }
+    for(uint64_t i=0;mapInfo == CborIndefinite || i < sensors;i++) {
+      if(mapInfo == CborIndefinite && reader.isBreak()) {
+        break;
+      }
+      uint64_t id;
+      if(!reader.readHead(major, info, id) || major != CborUnsigned || id > 0xFFFF) {
+        return -1;
+      }
+      uint64_t count;
+      if(!reader.readHead(major, info, count) || major != CborMap) {
+        return -1;
+      }
+      // validate the whole map before the line is started, so malformed data don't leave a partial line
+      size_t fieldsPos = reader.getPos();
+      CborValuesCounter counter;
+      if(!decodeSensor(reader, info, count, counter)) {
+        return -1;
+      }
+      if(!counter.count) {
+        continue;
+      }
+      reader.seek(fieldsPos);
+      writer.beginLine(measurement);
+      if(id < sensorsCount) {
+        writer.addTag("sensor", sensorNames[id]);
+      } else {
+        char idText[SENSORS_NUMBER_MAX_LEN + 1];
+        idText[formatInt(idText, id)] = 0;
+        writer.addTag("sensor", idText);
+      }
+      decodeSensor(reader, info, count, writer);
+      writer.endLine(timestamp);
+    }
+    cycles++;
+  }
+  return cycles;
+}
@@ -0,0 +1,69 @@
+#ifndef SENSORS_CBOR_H
+#define SENSORS_CBOR_H
+
+#include "SensorBase.h"
+
+// Compact CBOR (RFC 8949) encoding of acquisition cycles, decoded back into line protocol by cborToLineProtocol().
+// A cycle is array(2) [timestamp, {sensorId: {fieldId: value}}], sensor and field maps have indefinite length.
+// Sensor ids are assigned by caller, e.g. index of sensor in a set. Field ids come from the fixed schema, see getCborFieldId(),
+// keys not in schema are written as text, fields with text keys too long for the decoder are skipped. Floats are written as half precision when line protocol text (2 decimals) stays the same,
+// otherwise as single precision, NAN values are skipped. Integer fields are CBOR integers. Sensor maps without values are dropped.
+// Max length of a text field key including terminating null, longer keys aren't written
+#ifndef CBOR_MAX_KEY_LEN
+#define CBOR_MAX_KEY_LEN 32
+#endif
+
+class CborWriter : public FieldSink {
+  protected:
+    uint8_t *buffer;
+    size_t size;
+    size_t len;
+    size_t cycleStart;
+    size_t sensorStart;
+    size_t fieldsStart;
+    uint32_t droppedCycles = 0;
+    uint32_t skippedFields = 0;
+    bool overflow;
+  public:
+    CborWriter(uint8_t *buffer, size_t size);
+    // Starts a cycle, timestamp 0 means no timestamp
+    void beginCycle(uint64_t timestamp = 0);
+    void beginSensor(uint16_t id);
+    virtual void addField(const char *key, float value) override;
+    virtual void addField(const char *key, int32_t value) override;
+    void endSensor();
+    void endCycle();
+    // Writes fields of successfully read sensor
+    void writeSensor(uint16_t id, Sensor &sensor);
+    // Clears buffer, keeps number of dropped cycles
+    void clear();
+    const uint8_t *getBuffer() const { return buffer; }
+    size_t length() const { return len; }
+    // Returns true if the current or the last cycle didn't fit into the buffer and was dropped, reset by beginCycle()
+    bool isOverflow() const { return overflow; }
+    // Returns number of cycles dropped since construction, because they didn't fit
+    uint32_t getDroppedCycles() const { return droppedCycles; }
+    // Returns number of fields skipped since construction, because their key is longer than CBOR_MAX_KEY_LEN - 1
+    uint32_t getSkippedFields() const { return skippedFields; }
+  protected:
+    void writeHead(uint8_t major, uint64_t value);
+    void writeByte(uint8_t b);
+    // Returns false if key is too long, the field must be skipped
+    bool writeKey(const char *key);
+};
+
+// Returns id of field key in the schema, 0 if key is not in schema. Ids are never reused, new keys are only appended
+uint8_t getCborFieldId(const char *key);
+// Returns key of field id, nullptr if unknown
+const char *getCborFieldKey(uint8_t id);
+
+// Decodes cycles from data into lines of measurement with tag sensor=<name>, where sensorNames are indexed by sensor id.
+// Sensors with unknown id are tagged by their id, sensors without values are skipped. Integers must fit int32_t.
+// Returns number of decoded cycles, or -1 if data are malformed. Lines of sensors decoded before the error stay in writer
+int32_t cborToLineProtocol(const uint8_t *data, size_t length, const char *measurement, const char *const sensorNames[], uint16_t sensorsCount, LineProtocolWriter &writer);
+
+// Conversion between float and IEEE 754 half precision, rounding to nearest even
+uint16_t floatToHalf(float value);
+float halfToFloat(uint16_t half);
+
+#endif //SENSORS_CBOR_H
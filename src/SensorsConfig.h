@@ -0,0 +1,28 @@
+#ifndef SENSORS_CONFIG_H
+#define SENSORS_CONFIG_H
+
+// Each driver and its third party library is compiled only when its SENSORS_INCLUDE_<driver> macro is defined.
+// By default all drivers are included. When SENSORS_SELECT_DRIVERS is defined, only drivers enabled by build flags are compiled,
+// e.g. -DSENSORS_SELECT_DRIVERS -DSENSORS_INCLUDE_SHT4X. The flags must be visible to library sources, so set them as build flags
+#ifndef SENSORS_SELECT_DRIVERS
+#define SENSORS_INCLUDE_DHT 1
+#define SENSORS_INCLUDE_BME280 1
+#define SENSORS_INCLUDE_BMP280 1
+#define SENSORS_INCLUDE_SHTX 1
+#define SENSORS_INCLUDE_SHT4X 1
+#define SENSORS_INCLUDE_SI702X 1
+#define SENSORS_INCLUDE_HTU21D 1
+#define SENSORS_INCLUDE_BH1750 1
+#define SENSORS_INCLUDE_CCS811 1
+#define SENSORS_INCLUDE_SCD30 1
+#define SENSORS_INCLUDE_SCD41 1
+#define SENSORS_INCLUDE_SEN54 1
+#define SENSORS_INCLUDE_SGP40 1
+#define SENSORS_INCLUDE_SGP41 1
+// DS18B20
+#ifndef ESP32
+#define SENSORS_INCLUDE_ONEWIRE 1
+#endif
+#endif
+
+#endif //SENSORS_CONFIG_H
@@ -0,0 +1,197 @@
+#include "SensorsFormat.h"
+
+static const uint32_t Pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000 };
+
+static uint8_t formatUnsigned(char *buff, uint64_t value, uint8_t minDigits) {
+  char digits[20];
+  uint8_t len = 0;
+  do {
+    digits[len++] = '0' + value % 10;
+    value /= 10;
+  } while(value || len < minDigits);
+  for(uint8_t i=0;i<len;i++) {
+    buff[i] = digits[len-1-i];
+  }
+  return len;
+}
+
+uint8_t formatFixed(char *buff, float value, uint8_t decimals) {
+  char *p = buff;
+  if(decimals > 6) {
+    decimals = 6;
+  }
+  // as dtostrf() does, nan and inf are unsigned and negative zero prints without sign
+  if(isnan(value)) {
+    memcpy(p, "nan", 3);
+    return 3;
+  }
+  if(isinf(value)) {
+    memcpy(p, "inf", 3);
+    return 3;
+  }
+  if(value < 0) {
+    *p++ = '-';
+    value = -value;
+  }
+  // same arithmetic as dtostrf(), rounding by adding half of the last digit and taking digits one by one,
+  // so that the text is identical including the ties where double precision falls short
+  double number = value;
+  double rounding = 2.0;
+  for(uint8_t i=0;i<decimals;i++) {
+    rounding *= 10.0;
+  }
+  number += 1.0 / rounding;
+  double tenpow = 1.0;
+  uint8_t digits = 1;
+  while(number >= 10.0 * tenpow) {
+    tenpow *= 10.0;
+    digits++;
+  }
+  number /= tenpow;
+  digits += decimals;
+  while(digits-- > 0) {
+    int8_t digit = (int8_t)number;
+    if(digit > 9) {
+      digit = 9;
+    }
+    *p++ = '0' + digit;
+    if(digits == decimals && decimals) {
+      *p++ = '.';
+    }
+    number -= digit;
+    number *= 10.0;
+  }
+  return p-buff;
+}
+
+// Writes integer mantissa << shift (up to 128 bits, float max is below 2^128) in decimal
+static uint8_t formatShifted(char *buff, uint32_t mantissa, uint8_t shift) {
+  if(shift < 40) {
+    return formatUnsigned(buff, (uint64_t)mantissa << shift, 1);
+  }
+  // little endian 32 bit words, divided by 10 until zero
+  uint32_t words[4] = { 0, 0, 0, 0 };
+  uint8_t word = shift / 32, bits = shift % 32;
+  words[word] = mantissa << bits;
+  if(bits && word < 3) {
+    words[word+1] = mantissa >> (32 - bits);
+  }
+  char digits[40];
+  uint8_t len = 0;
+  bool nonZero = true;
+  while(nonZero) {
+    uint32_t rem = 0;
+    nonZero = false;
+    for(int8_t i=3;i>=0;i--) {
+      uint64_t cur = ((uint64_t)rem << 32) | words[i];
+      words[i] = cur / 10;
+      rem = cur % 10;
+      nonZero |= words[i] != 0;
+    }
+    digits[len++] = '0' + rem;
+  }
+  for(uint8_t i=0;i<len;i++) {
+    buff[i] = digits[len-1-i];
+  }
+  return len;
+}
+
+uint8_t formatDecimal(char *buff, float value, uint8_t decimals) {
+  char *p = buff;
+  if(decimals > 6) {
+    decimals = 6;
+  }
+  if(signbit(value)) {
+    *p++ = '-';
+  }
+  if(isnan(value)) {
+    memcpy(p, "nan", 3);
+    return p-buff+3;
+  }
+  if(isinf(value)) {
+    memcpy(p, "inf", 3);
+    return p-buff+3;
+  }
+  // value is mantissa * 2^exponent, which is scaled by 10^decimals and rounded in integers only
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  uint32_t mantissa = bits & 0x7FFFFF;
+  int16_t exponent = (bits >> 23) & 0xFF;
+  if(exponent) {
+    mantissa |= 0x800000;
+  } else {
+    exponent = 1;
+  }
+  exponent -= 150;
+  if(exponent >= 0) {
+    // integer, possibly not fitting 64 bits
+    p += formatShifted(p, mantissa, exponent);
+    if(decimals) {
+      *p++ = '.';
+      memset(p, '0', decimals);
+      p += decimals;
+    }
+    return p-buff;
+  }
+  // 24 bit mantissa times 10^6 fits 44 bits, so larger shift leaves less than half and rounds to zero
+  uint64_t scaled = (uint64_t)mantissa * Pow10[decimals];
+  uint8_t shift = -exponent;
+  uint64_t units = 0;
+  if(shift < 45) {
+    units = scaled >> shift;
+    uint64_t rest = scaled & (((uint64_t)1 << shift) - 1);
+    uint64_t half = (uint64_t)1 << (shift - 1);
+    // round half to even, as printf does
+    if(rest > half || (rest == half && (units & 1))) {
+      units++;
+    }
+  }
+  p += formatUnsigned(p, units / Pow10[decimals], 1);
+  if(decimals) {
+    *p++ = '.';
+    p += formatUnsigned(p, units % Pow10[decimals], decimals);
+  }
+  return p-buff;
+}
+
+uint8_t formatInt(char *buff, int32_t value) {
+  if(value < 0) {
+    *buff = '-';
+    return formatUnsigned(buff+1, -(int64_t)value, 1) + 1;
+  }
+  return formatUnsigned(buff, value, 1);
+}
+
+static void printPadded(Print &out, const char *buff, uint8_t len, uint8_t width) {
+  while(width > len) {
+    out.write(' ');
+    width--;
+  }
+  out.write((const uint8_t *)buff, len);
+}
+
+void printFixed(Print &out, float value, uint8_t width, uint8_t decimals) {
+  char buff[SENSORS_NUMBER_MAX_LEN];
+  printPadded(out, buff, formatDecimal(buff, value, decimals), width);
+}
+
+void printInt(Print &out, int32_t value, uint8_t width) {
+  char buff[SENSORS_NUMBER_MAX_LEN];
+  printPadded(out, buff, formatInt(buff, value), width);
+}
+
+size_t BufferPrint::write(uint8_t c) {
+  return write(&c, 1);
+}
+
+size_t BufferPrint::write(const uint8_t *data, size_t n) {
+  if(len + n >= size) {
+    n = size?size - len - 1:0;
+  }
+  memcpy(buffer + len, data, n);
+  len += n;
+  if(size) {
+    buffer[len] = 0;
+  }
+  return n;
+}
@@ -0,0 +1,51 @@
+#ifndef SENSORS_FORMAT_H
+#define SENSORS_FORMAT_H
+
+#include <Arduino.h>
+
+// Max length of a number written by formatFixed() or formatInt(), without terminating zero
+#define SENSORS_NUMBER_MAX_LEN 48
+
+// Writes value with the given number of decimal places (max 6) exactly as String(value, decimals) of the ESP cores
+// (dtostrf()) does, so ties round up as far as double precision allows and -0.0 prints as 0.00,
+// but without heap allocations and padding. Used for line protocol, so that it matches Point.
+// Returns number of written chars, buffer is not zero terminated
+uint8_t formatFixed(char *buff, float value, uint8_t decimals);
+
+// Writes value with the given number of decimal places (max 6) as printf("%.<decimals>f") does, so the exact binary value
+// rounds half to even and negative zero keeps its sign. Uses only integer arithmetic.
+// Returns number of written chars, buffer is not zero terminated
+uint8_t formatDecimal(char *buff, float value, uint8_t decimals);
+
+// Writes decimal representation of value. Returns number of written chars, buffer is not zero terminated
+uint8_t formatInt(char *buff, int32_t value);
+
+// Prints value formatted by formatDecimal() right aligned to width, as printf("%<width>.<decimals>f") does
+void printFixed(Print &out, float value, uint8_t width, uint8_t decimals);
+
+// Prints value right aligned to width as printf("%<width>d") does
+void printInt(Print &out, int32_t value, uint8_t width);
+
+// Print appending to a String
+class StringPrint : public Print {
+  protected:
+    String &str;
+  public:
+    StringPrint(String &str):str(str) {}
+    virtual size_t write(uint8_t c) override { str += (char)c; return 1; }
+};
+
+// Print writing into a caller supplied buffer, which is always zero terminated. Text not fitting is dropped
+class BufferPrint : public Print {
+  protected:
+    char *buffer;
+    size_t size;
+    size_t len;
+  public:
+    BufferPrint(char *buffer, size_t size):buffer(buffer),size(size),len(0) { if(size) buffer[0] = 0; }
+    virtual size_t write(uint8_t c) override;
+    virtual size_t write(const uint8_t *data, size_t n) override;
+    size_t length() const { return len; }
+};
+
+#endif //SENSORS_FORMAT_H
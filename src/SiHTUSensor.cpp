@@ -0,0 +1,164 @@
+#include "SiHTUSensor.h"
+#include <Wire.h>
+
+#if defined(SENSORS_INCLUDE_SI702X) || defined(SENSORS_INCLUDE_HTU21D)
+
+// ===========  SiHTUSensor  ==================
+
+static const uint8_t SiHTUAddress = 0x40;
+static const uint8_t SiHTUMeasureTempNoHold = 0xF3;
+static const uint8_t SiHTUMeasureHumNoHold = 0xF5;
+
+bool SiHTUSensor::sendCommand(uint8_t command) {
+  bus->beginTransmission(SiHTUAddress);
+  bus->write(command);
+  uint8_t err = bus->endTransmission();
+  countBusTransfer(1);
+  if(err) {
+    setError(ErrorRead, err);
+    status = false;
+    return false;
+  }
+  conversionStart = sensorsMillis();
+  return true;
+}
+
+bool SiHTUSensor::readRaw(uint16_t &raw) {
+  uint8_t buff[3];
+  uint8_t received = bus->requestFrom(SiHTUAddress, (uint8_t)3);
+  countBusTransfer(received);
+  if(received != 3) {
+    // no byte means device didn't acknowledge its address
+    setError(received?ErrorRead:ErrorBus, received);
+    return false;
+  }
+  for(uint8_t i=0;i<3;i++) {
+    buff[i] = bus->read();
+  }
+  if(sensorsCrc8(buff, 2, 0x00) != buff[2]) {
+    setError(ErrorCrc);
+    return false;
+  }
+  // two lowest bits carry status
+  raw = ((buff[0] << 8) | buff[1]) & 0xFFFC;
+  return true;
+}
+
+bool SiHTUSensor::startMeasurement() {
+  phase = 0;
+  return sendCommand(SiHTUMeasureTempNoHold);
+}
+
+bool SiHTUSensor::measurementReady() {
+  if(phase == 0 && sensorsMillis()-conversionStart > tempConversionTime) {
+    uint16_t raw;
+    // read temperature and continue with humidity, errors are reported from finishMeasurement()
+    phase = 2;
+    if(!readRaw(raw)) {
+      return true;
+    }
+    temp = raw * 175.72 / 65536.0 - 46.85;
+    if(!sendCommand(SiHTUMeasureHumNoHold)) {
+      return true;
+    }
+    phase = 1;
+    return false;
+  }
+  return phase == 2 || (phase == 1 && sensorsMillis()-conversionStart > humConversionTime);
+}
+
+bool SiHTUSensor::finishMeasurement() {
+  status = false;
+  if(phase != 1) {
+    return false;
+  }
+  uint16_t raw;
+  if(!readRaw(raw)) {
+    return false;
+  }
+  hum = raw * 125.0 / 65536.0 - 6.0;
+  setError(ErrorNone);
+  status = true;
+  return true;
+}
+
+#endif
+
+#ifdef SENSORS_INCLUDE_SI702X
+
+// ===========  SI702xSensor  ==================
+
+bool SI702xSensor::init() {
+  status = si7021.begin();
+  if(status) {
+    switch(si7021.getModel()) {
+      case SI_Engineering_Samples:
+        typ = F("SI engineering sample");
+        break;
+      case SI_7013:
+        typ = F("Si7013");
+        break;
+      case SI_7020:
+        typ = F("Si7020");
+        break;
+      case SI_7021:
+        typ = F("Si7021");
+        break;
+      case SI_UNKNOWN:
+      default:
+        typ = F("Unknown");
+    }
+  } else {
+    setError(ErrorInit);
+  }
+  return status;
+}
+
+bool SI702xSensor::readValues() {
+  float t = si7021.readTemperature();
+  status = false;
+  if(!isnan(t)) {
+    temp = t;
+    float h = si7021.readHumidity();
+    if(!isnan(h)) {
+      hum = h;
+    }
+  } else {
+    setError(ErrorRead);
+    return false;
+  }
+  status = true;
+  return true;
+}
+
+#endif
+
+#ifdef SENSORS_INCLUDE_HTU21D
+
+// ===========  HTU21DSensor  ==================
+bool HTU21DSensor::init() {
+  status = htu.begin(bus);
+  if(!status) {
+    setError(ErrorInit);
+  }
+  return status;
+}
+
+bool HTU21DSensor::readValues() {
+  status = false;
+  float t = htu.readTemperature();
+  if(!isnan(t)) {
+    temp = t;
+    float h = htu.readHumidity();
+    if(!isnan(h)) {
+      hum = h;
+    }
+  } else {
+    setError(ErrorRead);
+    return false;
+  }
+  status = true;
+  return true;
+}
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef SIHTU_SENSOR_H
+#define SIHTU_SENSOR_H
+
+#include "SensorBase.h"
+
+#if defined(SENSORS_INCLUDE_SI702X) || defined(SENSORS_INCLUDE_HTU21D)
+#include <Wire.h>
+
+// Split measurement for Si702x and HTU21D compatible chips using no hold master mode commands
+class SiHTUSensor: public TemperatureHumiditySensor {
+  protected:
+    uint8_t tempConversionTime;
+    uint8_t humConversionTime;
+    uint8_t phase = 0;
+    uint32_t conversionStart = 0;
+  public:
+    virtual bool startMeasurement() override;
+    virtual bool measurementReady() override;
+    virtual bool finishMeasurement() override;
+    virtual uint32_t getProfileConversionTime(SensorProfile) override { return tempConversionTime + humConversionTime; }
+  protected:
+    SiHTUSensor(const char *name, uint8_t tempConversionTime, uint8_t humConversionTime, TwoWire &wire):
+      TemperatureHumiditySensor(name),tempConversionTime(tempConversionTime),humConversionTime(humConversionTime) { bus = &wire; }
+    bool sendCommand(uint8_t command);
+    bool readRaw(uint16_t &raw);
+};
+#endif
+
+#ifdef SENSORS_INCLUDE_SI702X
+#include <Adafruit_Si7021.h>
+
+class SI702xSensor: public SiHTUSensor {
+  private:
+    Adafruit_Si7021 si7021;
+    String typ;
+  public:
+    SI702xSensor(TwoWire &wire = Wire):SiHTUSensor("SI702x", 11, 13, wire),si7021(&wire) {}
+    virtual bool init() override;
+    virtual bool readValues() override;
+    String getType() { return typ; }
+};
+#endif
+
+#ifdef SENSORS_INCLUDE_HTU21D
+#include <Adafruit_HTU21DF.h>
+
+class HTU21DSensor: public SiHTUSensor {
+  private:
+    Adafruit_HTU21DF htu;
+  public:
+    HTU21DSensor(TwoWire &wire = Wire):SiHTUSensor("HTU21D", 50, 16, wire) {}
+    virtual bool init() override;
+    virtual bool readValues() override;
+};
+#endif
+
+#endif //SIHTU_SENSOR_H
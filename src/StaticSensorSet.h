@@ -0,0 +1,181 @@
+#ifndef STATIC_SENSOR_SET_H
+#define STATIC_SENSOR_SET_H
+
+#include "Sensors.h"
+#include <type_traits>
+
+// Gas sensors which are read after other sensors, compensated by their temperature and humidity
+template<typename T> struct IsCompensatedGasSensor {
+  static const bool value =
+#ifdef SENSORS_INCLUDE_SGP40
+    std::is_base_of<SGP40Sensor, T>::value ||
+#endif
+#ifdef SENSORS_INCLUDE_SGP41
+    std::is_base_of<SGP41Sensor, T>::value ||
+#endif
+    false;
+};
+
+// Sensors providing temperature and humidity for compensation of gas sensors
+template<typename T> struct IsCompensationSource {
+  static const bool value = std::is_base_of<TemperatureHumiditySensor, T>::value && !IsCompensatedGasSensor<T>::value;
+};
+
+// Recursive storage of StaticSensorSet, node I keeps sensor T by value. Entry points are called qualified (sensor.T::init()),
+// so these calls don't go through the vtable. Virtual methods the drivers call inside (e.g. readValues(), getFields()) still do
+template<uint8_t I, typename... T> struct StaticSensorNode {
+  static const int8_t sourceIndex = -1;
+  uint8_t initAll() { return 0; }
+  uint8_t start(bool, bool *, uint32_t) { return 0; }
+  uint8_t poll(bool, bool *, uint32_t, uint32_t &, uint8_t &) { return 0; }
+  template<typename S> void compensate(S &) {}
+  void writeFields(FieldSink &) {}
+  void printTo(Print &) {}
+  uint16_t getCapabilities() { return 0; }
+  bool getValue(SensorCapability, float &) { return false; }
+};
+
+template<uint8_t I, typename T, typename... Rest> struct StaticSensorNode<I, T, Rest...> : StaticSensorNode<I + 1, Rest...> {
+  typedef StaticSensorNode<I + 1, Rest...> Next;
+  // Index of the first compensation source from this node, -1 if none
+  static const int8_t sourceIndex = IsCompensationSource<T>::value?I:Next::sourceIndex;
+  T sensor;
+
+  uint8_t initAll() {
+    Sensor &s = sensor;
+    uint32_t start = micros();
+    uint8_t ok = s.recordInit(sensor.T::init(), start)?1:0;
+    return ok + Next::initAll();
+  }
+  // Starts measurement of gas or other sensors, returns number of started
+  uint8_t start(bool gas, bool *measuring, uint32_t timeout) {
+    uint8_t started = 0;
+    if(IsCompensatedGasSensor<T>::value == gas) {
+      Sensor &s = sensor;
+      measuring[I] = false;
+      if(s.checkHealth()) {
+        s.measureStart = micros();
+        measuring[I] = sensor.T::startMeasurement();
+        s.startPolling(timeout);
+        if(!measuring[I]) {
+          s.recordRead(false, s.measureStart);
+        }
+      }
+      started = measuring[I];
+    }
+    return started + Next::start(gas, measuring, timeout);
+  }
+  // Finishes ready measurements, returns number of finished. Shortens wait (ms) until the next due poll
+  uint8_t poll(bool gas, bool *measuring, uint32_t now, uint32_t &wait, uint8_t &ok) {
+    uint8_t finished = 0;
+    Sensor &s = sensor;
+    if(IsCompensatedGasSensor<T>::value == gas && measuring[I] && s.pollDue(now, wait)) {
+      if(sensor.T::measurementReady()) {
+        if(s.recordRead(sensor.T::finishMeasurement(), s.measureStart)) {
+          ok++;
+        }
+        finished = 1;
+      } else if(s.pollTimedOut(now)) {
+        s.setError(ErrorTimeout);
+        s.status = false;
+        s.recordRead(false, s.measureStart);
+        finished = 1;
+      } else {
+        s.schedulePoll(now, wait);
+      }
+      if(finished) {
+        measuring[I] = false;
+      }
+    }
+    return finished + Next::poll(gas, measuring, now, wait, ok);
+  }
+  template<typename S> void compensate(S &source) {
+    setCompensation(source, std::integral_constant<bool, IsCompensatedGasSensor<T>::value>());
+    Next::compensate(source);
+  }
+  void writeFields(FieldSink &sink) {
+    if(sensor.getStatus()) {
+      sensor.T::writeFields(sink);
+    }
+    Next::writeFields(sink);
+  }
+  void printTo(Print &out) {
+    sensor.printTo(out);
+    out.println();
+    Next::printTo(out);
+  }
+  uint16_t getCapabilities() {
+    return sensor.T::getCapabilities()|Next::getCapabilities();
+  }
+  bool getValue(SensorCapability capability, float &value) {
+    return (sensor.getStatus() && sensor.T::getValue(capability, value)) || Next::getValue(capability, value);
+  }
+ private:
+  template<typename S> void setCompensation(S &source, std::true_type) {
+    if(source.getStatus()) {
+      sensor.setCompensation(source.temp, source.hum);
+    }
+  }
+  template<typename S> void setCompensation(S &, std::false_type) {}
+};
+
+template<uint8_t I, typename T, typename... Rest> T &getStaticSensor(StaticSensorNode<I, T, Rest...> &node) {
+  return node.sensor;
+}
+
+// Fixed set of sensors known at compile time, e.g. StaticSensorSet<BME280Sensor, SCD41Sensor, SGP41Sensor>.
+// Sensors are kept by value, without heap. The set calls their entry points with static dispatch, so the compiler can inline
+// the set's loop into them, but not the virtual calls drivers make internally.
+// Sensors are default constructed, sensor with constructor parameters can be wrapped, e.g.
+//   struct GardenBME280 : BME280Sensor { GardenBME280():BME280Sensor(250) {} };
+// SGP40 and SGP41 are read after other sensors, compensated by the first temperature and humidity sensor of the set
+template<typename... T> class StaticSensorSet {
+  protected:
+    typedef StaticSensorNode<0, T...> Nodes;
+    Nodes nodes;
+    bool measuring[sizeof...(T) ? sizeof...(T) : 1];
+  public:
+    static const uint8_t Count = sizeof...(T);
+    // Initializes all sensors, returns number of successfully initialized
+    uint8_t initAll() { return nodes.initAll(); }
+    // Reads all sensors with overlapped conversions, as Sensor::readAll(). Returns number of successfully read sensors
+    uint8_t readAll(uint32_t timeout = 2000) {
+      uint8_t ok = read(false, timeout);
+      compensate(std::integral_constant<bool, (Nodes::sourceIndex >= 0)>());
+      return ok + read(true, timeout);
+    }
+    // Passes fields of all successfully read sensors to the sink
+    void writeFields(FieldSink &sink) { nodes.writeFields(sink); }
+    // Adds fields of all successfully read sensors to the point
+    void storeValues(Point &point) {
+      PointFieldSink sink(point);
+      nodes.writeFields(sink);
+    }
+    // Prints a line per sensor, as Sensor::printTo()
+    void printTo(Print &out) { nodes.printTo(out); }
+    uint16_t getCapabilities() { return nodes.getCapabilities(); }
+    // Gets value of capability from the first successfully read sensor providing it
+    bool getValue(SensorCapability capability, float &value) { return nodes.getValue(capability, value); }
+    // Returns sensor with index I
+    template<uint8_t I> auto get() -> decltype(getStaticSensor<I>(nodes)) { return getStaticSensor<I>(nodes); }
+  protected:
+    uint8_t read(bool gas, uint32_t timeout) {
+      uint8_t pending = nodes.start(gas, measuring, timeout);
+      uint8_t ok = 0;
+      while(pending) {
+        uint32_t now = sensorsMillis();
+        uint32_t wait = SENSOR_POLL_INTERVAL;
+        pending -= nodes.poll(gas, measuring, now, wait, ok);
+        if(pending && wait) {
+          delay(wait);
+        } else if(pending) {
+          yield();
+        }
+      }
+      return ok;
+    }
+    void compensate(std::true_type) { nodes.compensate(get<Nodes::sourceIndex>()); }
+    void compensate(std::false_type) {}
+};
+
+#endif //STATIC_SENSOR_SET_H
@@ -0,0 +1,256 @@
+#include "TimeSeries.h"
+
+// Max number of bits of encoded sample: 4+32 for timestamp, 2+5+5+32 for value
+static const uint32_t MaxSampleBits = 80;
+
+static uint8_t countLeadingZeros(uint32_t v) {
+  return v?__builtin_clz(v):32;
+}
+
+static uint8_t countTrailingZeros(uint32_t v) {
+  return v?__builtin_ctz(v):32;
+}
+
+static uint32_t floatBits(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// =================== CompressedSeries ===================
+
+CompressedSeries::CompressedSeries(uint16_t blockSize, uint8_t blocksCount):
+  data(new uint8_t[(uint32_t)blockSize*blocksCount]),blocks(new SeriesBlock[blocksCount]),blockSize(blockSize),blocksCount(blocksCount) {
+  clear();
+}
+
+CompressedSeries::~CompressedSeries() {
+  delete [] data;
+  delete [] blocks;
+}
+
+void CompressedSeries::clear() {
+  for(uint8_t i=0;i<blocksCount;i++) {
+    blocks[i].count = 0;
+    blocks[i].bits = 0;
+  }
+  first = 0;
+  current = 0;
+}
+
+void CompressedSeries::startBlock(uint8_t block) {
+  blocks[block].count = 0;
+  blocks[block].bits = 0;
+  memset(data + (uint32_t)block*blockSize, 0, blockSize);
+}
+
+void CompressedSeries::writeBits(uint32_t value, uint8_t n) {
+  uint8_t *block = data + (uint32_t)current*blockSize;
+  uint32_t &pos = blocks[current].bits;
+  while(n) {
+    uint8_t free = 8 - (pos & 7);
+    uint8_t chunk = n < free?n:free;
+    n -= chunk;
+    uint8_t bits = (value >> n) & ((1 << chunk) - 1);
+    block[pos >> 3] |= bits << (free - chunk);
+    pos += chunk;
+  }
+}
+
+bool CompressedSeries::append(uint32_t timestamp, float value) {
+  bool newBlock = !blocks[current].count;
+  if(!newBlock && timestamp < lastTimestamp) {
+    return false;
+  }
+  if(!newBlock && blocks[current].bits + MaxSampleBits > blockSize*8UL) {
+    // move to the next block, drop the oldest one when all are used
+    current = (current + 1) % blocksCount;
+    if(current == first) {
+      first = (first + 1) % blocksCount;
+    }
+    newBlock = true;
+  }
+  uint32_t bits = floatBits(value);
+  if(newBlock) {
+    startBlock(current);
+    writeBits(timestamp, 32);
+    writeBits(bits, 32);
+    lastDelta = 0;
+    lastMeaningful = 0;
+  } else {
+    int32_t delta = timestamp - lastTimestamp;
+    int32_t dod = delta - lastDelta;
+    if(dod == 0) {
+      writeBits(0, 1);
+    } else if(dod >= -64 && dod <= 63) {
+      writeBits(0b10, 2);
+      writeBits(dod, 7);
+    } else if(dod >= -256 && dod <= 255) {
+      writeBits(0b110, 3);
+      writeBits(dod, 9);
+    } else if(dod >= -2048 && dod <= 2047) {
+      writeBits(0b1110, 4);
+      writeBits(dod, 12);
+    } else {
+      writeBits(0b1111, 4);
+      writeBits(dod, 32);
+    }
+    lastDelta = delta;
+    uint32_t x = bits ^ lastValue;
+    if(!x) {
+      writeBits(0, 1);
+    } else {
+      uint8_t leading = countLeadingZeros(x);
+      uint8_t trailing = countTrailingZeros(x);
+      if(lastMeaningful && leading >= lastLeading && 32 - trailing <= lastLeading + lastMeaningful) {
+        // meaningful bits fit into previous window
+        writeBits(0b10, 2);
+        writeBits(x >> (32 - lastLeading - lastMeaningful), lastMeaningful);
+      } else {
+        uint8_t meaningful = 32 - leading - trailing;
+        writeBits(0b11, 2);
+        writeBits(leading, 5);
+        writeBits(meaningful - 1, 5);
+        writeBits(x >> trailing, meaningful);
+        lastLeading = leading;
+        lastMeaningful = meaningful;
+      }
+    }
+  }
+  blocks[current].count++;
+  lastTimestamp = timestamp;
+  lastValue = bits;
+  return true;
+}
+
+uint32_t CompressedSeries::getCount() const {
+  uint32_t count = 0;
+  for(uint8_t i=0;i<blocksCount;i++) {
+    count += blocks[i].count;
+  }
+  return count;
+}
+
+uint32_t CompressedSeries::getUsedBytes() const {
+  uint32_t bytes = 0;
+  for(uint8_t i=0;i<blocksCount;i++) {
+    bytes += (blocks[i].bits + 7) >> 3;
+  }
+  return bytes;
+}
+
+float CompressedSeries::getCompressionRatio() const {
+  uint32_t used = getUsedBytes();
+  return used?getCount()*8.0/used:0;
+}
+
+// =================== CompressedSeries::Iterator ===================
+
+CompressedSeries::Iterator::Iterator(const CompressedSeries *series):
+  series(series),block(series->first),sample(0),bitPos(0) {
+}
+
+uint32_t CompressedSeries::Iterator::readBits(uint8_t n) {
+  const uint8_t *data = series->data + (uint32_t)block*series->blockSize;
+  uint32_t value = 0;
+  while(n) {
+    uint8_t avail = 8 - (bitPos & 7);
+    uint8_t chunk = n < avail?n:avail;
+    uint8_t bits = (data[bitPos >> 3] >> (avail - chunk)) & ((1 << chunk) - 1);
+    value = (value << chunk) | bits;
+    bitPos += chunk;
+    n -= chunk;
+  }
+  return value;
+}
+
+// sign extends n bit two's complement value
+static int32_t signExtend(uint32_t value, uint8_t n) {
+  return (int32_t)(value << (32 - n)) >> (32 - n);
+}
+
+bool CompressedSeries::Iterator::next(uint32_t &timestamp, float &value) {
+  while(sample == series->blocks[block].count) {
+    if(block == series->current) {
+      return false;
+    }
+    block = (block + 1) % series->blocksCount;
+    sample = 0;
+    bitPos = 0;
+  }
+  if(!sample) {
+    this->timestamp = readBits(32);
+    this->value = readBits(32);
+    delta = 0;
+    meaningful = 0;
+  } else {
+    int32_t dod;
+    if(!readBits(1)) {
+      dod = 0;
+    } else if(!readBits(1)) {
+      dod = signExtend(readBits(7), 7);
+    } else if(!readBits(1)) {
+      dod = signExtend(readBits(9), 9);
+    } else if(!readBits(1)) {
+      dod = signExtend(readBits(12), 12);
+    } else {
+      dod = readBits(32);
+    }
+    delta += dod;
+    this->timestamp += delta;
+    if(readBits(1)) {
+      if(readBits(1)) {
+        leading = readBits(5);
+        meaningful = readBits(5) + 1;
+      }
+      this->value ^= readBits(meaningful) << (32 - leading - meaningful);
+    }
+  }
+  sample++;
+  timestamp = this->timestamp;
+  memcpy(&value, &this->value, sizeof(value));
+  return true;
+}
+
+// =================== SeriesStore ===================
+
+SeriesStore::SeriesStore(uint8_t maxSeries, uint16_t blockSize, uint8_t blocksCount):
+  entries(new Entry[maxSeries]),capacity(maxSeries),count(0),blockSize(blockSize),blocksCount(blocksCount),
+  currentSensor(nullptr),currentTimestamp(0) {
+}
+
+SeriesStore::~SeriesStore() {
+  for(uint8_t i=0;i<count;i++) {
+    delete entries[i].series;
+  }
+  delete [] entries;
+}
+
+void SeriesStore::record(Sensor &sensor, uint32_t timestamp) {
+  currentSensor = &sensor;
+  currentTimestamp = timestamp;
+  sensor.writeFields(*this);
+  currentSensor = nullptr;
+}
+
+CompressedSeries *SeriesStore::getSeries(const Sensor *sensor, const char *key) {
+  for(uint8_t i=0;i<count;i++) {
+    // keys are interned, so compare pointers first
+    if(entries[i].sensor == sensor && (entries[i].key == key || !strcmp(key, entries[i].key))) {
+      return entries[i].series;
+    }
+  }
+  return nullptr;
+}
+
+void SeriesStore::addField(const char *key, float value) {
+  CompressedSeries *series = getSeries(currentSensor, key);
+  if(!series) {
+    if(count == capacity) {
+      return;
+    }
+    series = new CompressedSeries(blockSize, blocksCount);
+    entries[count++] = { currentSensor, key, series };
+  }
+  series->append(currentTimestamp, value);
+}
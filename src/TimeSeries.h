@@ -0,0 +1,97 @@
+#ifndef TIME_SERIES_H
+#define TIME_SERIES_H
+
+#include "SensorBase.h"
+
+// Bit level state of a compressed block
+struct SeriesBlock {
+  uint32_t count;
+  uint32_t bits;
+};
+
+// In memory history of (timestamp, value) samples compressed as in Gorilla TSDB: timestamps
+// are encoded as delta of deltas, values as XOR with the previous value. Data is kept
+// in a ring of fixed size blocks, so when memory is full the oldest block is dropped.
+// Timestamps are in seconds.
+class CompressedSeries {
+  public:
+    // Sequentially decodes samples from the oldest to the newest
+    class Iterator {
+      friend class CompressedSeries;
+      protected:
+        const CompressedSeries *series;
+        uint8_t block;
+        uint32_t sample;
+        uint32_t bitPos;
+        uint32_t timestamp;
+        int32_t delta;
+        uint32_t value;
+        uint8_t leading;
+        uint8_t meaningful;
+        Iterator(const CompressedSeries *series);
+        uint32_t readBits(uint8_t n);
+      public:
+        // Returns false when there are no more samples
+        bool next(uint32_t &timestamp, float &value);
+    };
+  protected:
+    uint8_t *data;
+    SeriesBlock *blocks;
+    uint16_t blockSize;
+    uint8_t blocksCount;
+    // index of the oldest and current block
+    uint8_t first;
+    uint8_t current;
+    // encoder state of the current block
+    uint32_t lastTimestamp;
+    int32_t lastDelta;
+    uint32_t lastValue;
+    uint8_t lastLeading;
+    uint8_t lastMeaningful;
+  public:
+    // blockSize in bytes
+    CompressedSeries(uint16_t blockSize, uint8_t blocksCount);
+    ~CompressedSeries();
+    // Appends sample, timestamps must not decrease
+    bool append(uint32_t timestamp, float value);
+    void clear();
+    Iterator iterator() const { return Iterator(this); }
+    uint32_t getCount() const;
+    // Returns number of bytes occupied by compressed data
+    uint32_t getUsedBytes() const;
+    // Returns ratio between size of raw samples (4B timestamp + 4B float) and compressed data
+    float getCompressionRatio() const;
+  protected:
+    void startBlock(uint8_t block);
+    void writeBits(uint32_t value, uint8_t n);
+};
+
+// Keeps compressed history of all fields of sensors. Each (sensor, field) pair has its own series
+class SeriesStore : public FieldSink {
+  protected:
+    struct Entry {
+      const Sensor *sensor;
+      const char *key;
+      CompressedSeries *series;
+    };
+    Entry *entries;
+    uint8_t capacity;
+    uint8_t count;
+    uint16_t blockSize;
+    uint8_t blocksCount;
+    const Sensor *currentSensor;
+    uint32_t currentTimestamp;
+  public:
+    // maxSeries is max number of stored fields, each series has blocksCount blocks of blockSize bytes
+    SeriesStore(uint8_t maxSeries, uint16_t blockSize, uint8_t blocksCount);
+    ~SeriesStore();
+    // Appends current values of all fields of the sensor
+    void record(Sensor &sensor, uint32_t timestamp);
+    // Returns series of a field of the sensor or nullptr
+    CompressedSeries *getSeries(const Sensor *sensor, const char *key);
+    uint8_t getCount() const { return count; }
+    virtual void addField(const char *key, float value) override;
+    virtual void addField(const char *key, int32_t value) override { addField(key, (float)value); }
+};
+
+#endif //TIME_SERIES_H
@@ -0,0 +1,87 @@
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "Sim.h"
+#include <functional>
+#include <vector>
+#include <string>
+#include <chrono>
+
+// Minimal test framework. TEST(name) registers a test, main() of each test file runs all of them on a reset simulation,
+// so a test switching to real time mode doesn't need to switch back, even when its checks fail
+// and returns number of failed checks
+struct TestCase {
+  const char *name;
+  std::function<void()> body;
+};
+
+inline std::vector<TestCase> &testCases() {
+  static std::vector<TestCase> cases;
+  return cases;
+}
+
+inline int &testFailures() {
+  static int failures = 0;
+  return failures;
+}
+
+struct TestRegistrar {
+  TestRegistrar(const char *name, std::function<void()> body) { testCases().push_back({ name, body }); }
+};
+
+#define TEST(name) \
+  static void name(); \
+  static TestRegistrar name##Registrar(#name, name); \
+  static void name()
+
+#define CHECK(cond) do { \
+  if(!(cond)) { \
+    printf("  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+    testFailures()++; \
+  } } while(0)
+
+#define CHECK_EQ(a, b) do { \
+  auto _a = (a); \
+  auto _b = (b); \
+  if(!(_a == _b)) { \
+    printf("  %s:%d: CHECK_EQ(%s, %s) failed: %s != %s\n", __FILE__, __LINE__, #a, #b, testToString(_a).c_str(), testToString(_b).c_str()); \
+    testFailures()++; \
+  } } while(0)
+
+#define CHECK_NEAR(a, b, eps) do { \
+  double _a = (a); \
+  double _b = (b); \
+  if(!(fabs(_a - _b) <= (eps))) { \
+    printf("  %s:%d: CHECK_NEAR(%s, %s) failed: %f != %f\n", __FILE__, __LINE__, #a, #b, _a, _b); \
+    testFailures()++; \
+  } } while(0)
+
+inline std::string testToString(const String &v) { return std::string("\"") + v.c_str() + "\""; }
+inline std::string testToString(const char *v) { return std::string("\"") + (v?v:"(null)") + "\""; }
+inline std::string testToString(const std::string &v) { return "\"" + v + "\""; }
+inline std::string testToString(bool v) { return v?"true":"false"; }
+template<typename T>
+inline std::string testToString(T v) { return std::to_string(v); }
+
+// Wall clock time of body in us, for benchmarks
+inline double measureUs(std::function<void()> body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+  for(auto &t : testCases()) {
+    printf("%s\n", t.name);
+    sim::reset();
+    Wire.resetCounters();
+    t.body();
+  }
+  sim::setRealTime(false);
+  printf("%d failure(s)\n", testFailures());
+  return testFailures() > 0;
+}
+
+#endif //TEST_UTIL_H
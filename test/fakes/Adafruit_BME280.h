@@ -0,0 +1,146 @@
+#ifndef ADAFRUIT_BME280_H
+#define ADAFRUIT_BME280_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "BoschEncoding.h"
+
+#define BME280_ADDRESS (0x77)
+#define BME280_ADDRESS_ALTERNATE (0x76)
+
+enum {
+  BME280_REGISTER_CHIPID = 0xD0,
+  BME280_REGISTER_SOFTRESET = 0xE0,
+  BME280_REGISTER_CONTROLHUMID = 0xF2,
+  BME280_REGISTER_STATUS = 0XF3,
+  BME280_REGISTER_CONTROL = 0xF4,
+  BME280_REGISTER_CONFIG = 0xF5,
+  BME280_REGISTER_PRESSUREDATA = 0xF7,
+  BME280_REGISTER_TEMPDATA = 0xFA,
+  BME280_REGISTER_HUMIDDATA = 0xFD
+};
+
+// Subset of Adafruit BME280 library with the same register access and timing. Data use simplified encoding of BoschEncoding.h
+class Adafruit_BME280 {
+  public:
+    enum sensor_sampling { SAMPLING_NONE, SAMPLING_X1, SAMPLING_X2, SAMPLING_X4, SAMPLING_X8, SAMPLING_X16 };
+    enum sensor_mode { MODE_SLEEP = 0, MODE_FORCED = 1, MODE_NORMAL = 3 };
+    enum sensor_filter { FILTER_OFF, FILTER_X2, FILTER_X4, FILTER_X8, FILTER_X16 };
+    enum standby_duration {
+      STANDBY_MS_0_5 = 0, STANDBY_MS_10 = 6, STANDBY_MS_20 = 7, STANDBY_MS_62_5 = 1,
+      STANDBY_MS_125 = 2, STANDBY_MS_250 = 3, STANDBY_MS_500 = 4, STANDBY_MS_1000 = 5
+    };
+  protected:
+    struct ctrl_meas {
+      unsigned int osrs_t : 3;
+      unsigned int osrs_p : 3;
+      unsigned int mode : 2;
+      unsigned int get() { return (osrs_t << 5) | (osrs_p << 2) | mode; }
+    };
+    struct ctrl_hum {
+      unsigned int osrs_h : 3;
+      unsigned int get() { return osrs_h; }
+    };
+    struct config {
+      unsigned int t_sb : 3;
+      unsigned int filter : 3;
+      unsigned int get() { return (t_sb << 5) | (filter << 2); }
+    };
+    TwoWire *_wire = nullptr;
+    uint8_t _i2caddr = BME280_ADDRESS;
+    ctrl_meas _measReg = { 0, 0, 0 };
+    ctrl_hum _humReg = { 0 };
+    config _configReg = { 0, 0 };
+  public:
+    bool begin(uint8_t addr = BME280_ADDRESS, TwoWire *theWire = &Wire) {
+      _i2caddr = addr;
+      _wire = theWire;
+      if(read8(BME280_REGISTER_CHIPID) != 0x60) {
+        return false;
+      }
+      write8(BME280_REGISTER_SOFTRESET, 0xB6);
+      delay(10);
+      setSampling();
+      delay(100);
+      return true;
+    }
+    void setSampling(sensor_mode mode = MODE_NORMAL, sensor_sampling tempSampling = SAMPLING_X16, sensor_sampling pressSampling = SAMPLING_X16,
+                     sensor_sampling humSampling = SAMPLING_X16, sensor_filter filter = FILTER_OFF, standby_duration duration = STANDBY_MS_0_5) {
+      _measReg.mode = mode;
+      _measReg.osrs_t = tempSampling;
+      _measReg.osrs_p = pressSampling;
+      _humReg.osrs_h = humSampling;
+      _configReg.filter = filter;
+      _configReg.t_sb = duration;
+      // making sure sensor is in sleep mode before setting configuration as it otherwise may be ignored
+      write8(BME280_REGISTER_CONTROL, MODE_SLEEP);
+      write8(BME280_REGISTER_CONTROLHUMID, _humReg.get());
+      write8(BME280_REGISTER_CONFIG, _configReg.get());
+      write8(BME280_REGISTER_CONTROL, _measReg.get());
+    }
+    bool takeForcedMeasurement() {
+      if(_measReg.mode != MODE_FORCED) {
+        return true;
+      }
+      write8(BME280_REGISTER_CONTROL, _measReg.get());
+      unsigned long start = millis();
+      while(read8(BME280_REGISTER_STATUS) & 0x08) {
+        if(millis() - start > 2000) {
+          return false;
+        }
+        delay(1);
+      }
+      return true;
+    }
+    float readTemperature() {
+      uint32_t adc = read24(BME280_REGISTER_TEMPDATA);
+      return adc == 0x800000?NAN:boschDecodeTemperature(adc >> 4);
+    }
+    float readPressure() {
+      uint32_t adc = read24(BME280_REGISTER_PRESSUREDATA);
+      return adc == 0x800000?NAN:boschDecodePressure(adc >> 4);
+    }
+    float readHumidity() {
+      uint16_t adc = read16(BME280_REGISTER_HUMIDDATA);
+      return adc == 0x8000?NAN:boschDecodeHumidity(adc);
+    }
+    float seaLevelForAltitude(float altitude, float atmospheric) {
+      return atmospheric / pow(1.0 - (altitude / 44330.0), 5.255);
+    }
+    uint32_t sensorID() { return read8(BME280_REGISTER_CHIPID); }
+  protected:
+    void write8(byte reg, byte value) {
+      _wire->beginTransmission(_i2caddr);
+      _wire->write(reg);
+      _wire->write(value);
+      _wire->endTransmission();
+    }
+    uint8_t read8(byte reg) {
+      uint8_t v = 0;
+      readBytes(reg, &v, 1);
+      return v;
+    }
+    uint16_t read16(byte reg) {
+      uint8_t v[2] = { 0x80, 0 };
+      readBytes(reg, v, 2);
+      return (v[0] << 8) | v[1];
+    }
+    uint32_t read24(byte reg) {
+      uint8_t v[3] = { 0x80, 0, 0 };
+      readBytes(reg, v, 3);
+      return ((uint32_t)v[0] << 16) | (v[1] << 8) | v[2];
+    }
+    bool readBytes(byte reg, uint8_t *data, uint8_t len) {
+      _wire->beginTransmission(_i2caddr);
+      _wire->write(reg);
+      if(_wire->endTransmission() != 0 || _wire->requestFrom(_i2caddr, len) != len) {
+        return false;
+      }
+      for(uint8_t i=0;i<len;i++) {
+        data[i] = _wire->read();
+      }
+      return true;
+    }
+};
+
+#endif //ADAFRUIT_BME280_H
@@ -0,0 +1,79 @@
+#ifndef ADAFRUIT_BMP280_H
+#define ADAFRUIT_BMP280_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "BoschEncoding.h"
+
+#define BMP280_ADDRESS (0x77)
+#define BMP280_ADDRESS_ALT (0x76)
+#define BMP280_CHIPID (0x58)
+
+// Subset of Adafruit BMP280 library, begin() sets normal mode. Data use simplified encoding of BoschEncoding.h
+class Adafruit_BMP280 {
+  public:
+    enum sensor_sampling { SAMPLING_NONE, SAMPLING_X1, SAMPLING_X2, SAMPLING_X4, SAMPLING_X8, SAMPLING_X16 };
+    enum sensor_mode { MODE_SLEEP = 0, MODE_FORCED = 1, MODE_NORMAL = 3, MODE_SOFT_RESET_CODE = 0xB6 };
+    enum sensor_filter { FILTER_OFF, FILTER_X2, FILTER_X4, FILTER_X8, FILTER_X16 };
+    enum standby_duration { STANDBY_MS_1 = 0, STANDBY_MS_63, STANDBY_MS_125, STANDBY_MS_250, STANDBY_MS_500, STANDBY_MS_1000, STANDBY_MS_2000, STANDBY_MS_4000 };
+  protected:
+    TwoWire *_wire;
+    uint8_t _i2caddr = BMP280_ADDRESS;
+  public:
+    Adafruit_BMP280(TwoWire *theWire = &Wire):_wire(theWire) {}
+    bool begin(uint8_t addr = BMP280_ADDRESS, uint8_t chipid = BMP280_CHIPID) {
+      _i2caddr = addr;
+      if(read8(0xD0) != chipid) {
+        return false;
+      }
+      setSampling();
+      delay(100);
+      return true;
+    }
+    void setSampling(sensor_mode mode = MODE_NORMAL, sensor_sampling tempSampling = SAMPLING_X16, sensor_sampling pressSampling = SAMPLING_X16,
+                     sensor_filter filter = FILTER_OFF, standby_duration duration = STANDBY_MS_1) {
+      write8(0xF5, (duration << 5) | (filter << 2));
+      write8(0xF4, (tempSampling << 5) | (pressSampling << 2) | mode);
+    }
+    float readTemperature() {
+      uint32_t adc = read24(0xFA);
+      return adc == 0x800000?NAN:boschDecodeTemperature(adc >> 4);
+    }
+    float readPressure() {
+      uint32_t adc = read24(0xF7);
+      return adc == 0x800000?NAN:boschDecodePressure(adc >> 4);
+    }
+    float seaLevelForAltitude(float altitude, float atmospheric) {
+      return atmospheric / pow(1.0 - (altitude / 44330.0), 5.255);
+    }
+  protected:
+    void write8(byte reg, byte value) {
+      _wire->beginTransmission(_i2caddr);
+      _wire->write(reg);
+      _wire->write(value);
+      _wire->endTransmission();
+    }
+    uint8_t read8(byte reg) {
+      uint8_t v = 0;
+      readBytes(reg, &v, 1);
+      return v;
+    }
+    uint32_t read24(byte reg) {
+      uint8_t v[3] = { 0x80, 0, 0 };
+      readBytes(reg, v, 3);
+      return ((uint32_t)v[0] << 16) | (v[1] << 8) | v[2];
+    }
+    bool readBytes(byte reg, uint8_t *data, uint8_t len) {
+      _wire->beginTransmission(_i2caddr);
+      _wire->write(reg);
+      if(_wire->endTransmission() != 0 || _wire->requestFrom(_i2caddr, len) != len) {
+        return false;
+      }
+      for(uint8_t i=0;i<len;i++) {
+        data[i] = _wire->read();
+      }
+      return true;
+    }
+};
+
+#endif //ADAFRUIT_BMP280_H
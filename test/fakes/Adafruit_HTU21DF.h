@@ -0,0 +1,56 @@
+#ifndef ADAFRUIT_HTU21DF_H
+#define ADAFRUIT_HTU21DF_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#define HTU21DF_I2CADDR (0x40)
+
+// Subset of Adafruit HTU21DF library with the same commands and timing, returns NAN on failure
+class Adafruit_HTU21DF {
+  protected:
+    TwoWire *_wire = nullptr;
+  public:
+    bool begin(TwoWire *theWire = &Wire) {
+      _wire = theWire;
+      reset();
+      uint8_t cmd = 0xE7;
+      if(!command(cmd) || _wire->requestFrom((uint8_t)HTU21DF_I2CADDR, (uint8_t)1) != 1) {
+        return false;
+      }
+      return _wire->read() == 0x02;
+    }
+    void reset() {
+      command(0xFE);
+      delay(15);
+    }
+    float readTemperature() {
+      float raw = readValue(0xE3);
+      return isnan(raw)?raw:raw * 175.72 / 65536 - 46.85;
+    }
+    float readHumidity() {
+      float raw = readValue(0xE5);
+      return isnan(raw)?raw:raw * 125 / 65536 - 6;
+    }
+  protected:
+    bool command(uint8_t cmd) {
+      _wire->beginTransmission(HTU21DF_I2CADDR);
+      _wire->write(cmd);
+      return _wire->endTransmission() == 0;
+    }
+    float readValue(uint8_t cmd) {
+      if(!command(cmd)) {
+        return NAN;
+      }
+      delay(50);
+      if(_wire->requestFrom((uint8_t)HTU21DF_I2CADDR, (uint8_t)3) != 3) {
+        return NAN;
+      }
+      uint16_t raw = _wire->read() << 8;
+      raw |= _wire->read();
+      _wire->read();
+      return raw & 0xFFFC;
+    }
+};
+
+#endif //ADAFRUIT_HTU21DF_H
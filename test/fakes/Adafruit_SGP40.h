@@ -0,0 +1,56 @@
+#ifndef ADAFRUIT_SGP40_H
+#define ADAFRUIT_SGP40_H
+
+#include <SensirionCore.h>
+
+#define SGP40_DEFAULT_ADDR 0x59
+
+// Subset of Adafruit SGP40 library. measureRaw() returns 0 on failure.
+// measureVocIndex() doesn't run the gas index algorithm, it reports the neutral index 100 for any signal
+class Adafruit_SGP40 {
+  protected:
+    TwoWire *_wire = nullptr;
+  public:
+    uint16_t serialnumber[3] = { 0 };
+  public:
+    bool begin(TwoWire *theWire = &Wire) {
+      _wire = theWire;
+      if(sensirionSendCommand(*_wire, SGP40_DEFAULT_ADDR, 0x3682)) {
+        return false;
+      }
+      delay(10);
+      if(sensirionReadWords(*_wire, SGP40_DEFAULT_ADDR, serialnumber, 3)) {
+        return false;
+      }
+      return selfTest();
+    }
+    bool selfTest() {
+      uint16_t reply = 0;
+      if(sensirionSendCommand(*_wire, SGP40_DEFAULT_ADDR, 0x280E)) {
+        return false;
+      }
+      delay(320);
+      return !sensirionReadWords(*_wire, SGP40_DEFAULT_ADDR, &reply, 1) && reply == 0xD400;
+    }
+    bool softReset() { return !sensirionSendCommand(*_wire, 0x00, 0x06, nullptr, 0, 1); }
+    bool heaterOff() { return !sensirionSendCommand(*_wire, SGP40_DEFAULT_ADDR, 0x3615); }
+    uint16_t measureRaw(float temperature = 25, float humidity = 50) {
+      uint16_t args[2];
+      args[0] = (uint16_t)((humidity * 65535) / 100 + 0.5);
+      args[1] = (uint16_t)(((temperature + 45) * 65535) / 175);
+      uint16_t reply = 0;
+      if(sensirionSendCommand(*_wire, SGP40_DEFAULT_ADDR, 0x260F, args, 2)) {
+        return 0;
+      }
+      delay(30);
+      if(sensirionReadWords(*_wire, SGP40_DEFAULT_ADDR, &reply, 1)) {
+        return 0;
+      }
+      return reply;
+    }
+    int32_t measureVocIndex(float temperature = 25, float humidity = 50) {
+      return measureRaw(temperature, humidity) ? 100 : 0;
+    }
+};
+
+#endif //ADAFRUIT_SGP40_H
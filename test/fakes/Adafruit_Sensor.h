@@ -0,0 +1,6 @@
+#ifndef ADAFRUIT_SENSOR_H
+#define ADAFRUIT_SENSOR_H
+
+// Unified sensor API is not used by the drivers
+
+#endif //ADAFRUIT_SENSOR_H
@@ -0,0 +1,98 @@
+#include "Adafruit_Si7021.h"
+
+bool Adafruit_Si7021::command(const uint8_t *cmd, uint8_t len) {
+  _wire->beginTransmission(_i2caddr);
+  _wire->write(cmd, len);
+  return _wire->endTransmission() == 0;
+}
+
+void Adafruit_Si7021::reset() {
+  uint8_t cmd = 0xFE;
+  command(&cmd, 1);
+  delay(50);
+}
+
+uint8_t Adafruit_Si7021::readRegister8(uint8_t reg) {
+  if(!command(&reg, 1) || _wire->requestFrom(_i2caddr, (uint8_t)1) != 1) {
+    return 0;
+  }
+  return _wire->read();
+}
+
+bool Adafruit_Si7021::begin() {
+  reset();
+  if(readRegister8(0xE7) != 0x3A) {
+    return false;
+  }
+  readSerialNumber();
+  static const uint8_t revCmd[2] = { 0x84, 0xB8 };
+  if(command(revCmd, 2) && _wire->requestFrom(_i2caddr, (uint8_t)1) == 1) {
+    _revision = _wire->read() == 0x20?2:1;
+  }
+  return true;
+}
+
+void Adafruit_Si7021::readSerialNumber() {
+  static const uint8_t id1[2] = { 0xFA, 0x0F };
+  static const uint8_t id2[2] = { 0xFC, 0xC9 };
+  uint8_t buff[8] = { 0 };
+  if(command(id1, 2) && _wire->requestFrom(_i2caddr, (uint8_t)8) == 8) {
+    for(uint8_t i=0;i<8;i++) {
+      buff[i] = _wire->read();
+    }
+    sernum_a = ((uint32_t)buff[0] << 24) | ((uint32_t)buff[2] << 16) | (buff[4] << 8) | buff[6];
+  }
+  if(command(id2, 2) && _wire->requestFrom(_i2caddr, (uint8_t)6) == 6) {
+    for(uint8_t i=0;i<6;i++) {
+      buff[i] = _wire->read();
+    }
+    sernum_b = ((uint32_t)buff[0] << 24) | ((uint32_t)buff[1] << 16) | (buff[3] << 8) | buff[4];
+  }
+  switch(sernum_b >> 24) {
+    case 0:
+    case 0xFF:
+      _model = SI_Engineering_Samples;
+      break;
+    case 0x0D:
+      _model = SI_7013;
+      break;
+    case 0x14:
+      _model = SI_7020;
+      break;
+    case 0x15:
+      _model = SI_7021;
+      break;
+    default:
+      _model = SI_UNKNOWN;
+  }
+}
+
+// Waits typical conversion time and polls the result with 100ms timeout, NAN on failure
+float Adafruit_Si7021::readValue(uint8_t cmd) {
+  if(!command(&cmd, 1)) {
+    return NAN;
+  }
+  delay(20);
+  unsigned long start = millis();
+  while(millis() - start < 100) {
+    if(_wire->requestFrom(_i2caddr, (uint8_t)3) == 3) {
+      uint16_t raw = _wire->read() << 8;
+      raw |= _wire->read();
+      _wire->read();
+      if(cmd == 0xF3) {
+        return raw * 175.72 / 65536 - 46.85;
+      }
+      return raw * 125.0 / 65536 - 6;
+    }
+    delay(6);
+  }
+  return NAN;
+}
+
+float Adafruit_Si7021::readHumidity() {
+  float h = readValue(0xF5);
+  if(isnan(h)) {
+    return h;
+  }
+  return h > 100?100:h < 0?0:h;
+}
@@ -0,0 +1,36 @@
+#ifndef ADAFRUIT_SI7021_H
+#define ADAFRUIT_SI7021_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#define SI7021_DEFAULT_ADDRESS 0x40
+
+enum si_sensorType { SI_Engineering_Samples, SI_7013, SI_7020, SI_7021, SI_UNKNOWN };
+
+// Subset of Adafruit Si7021 library with the same commands and timing
+class Adafruit_Si7021 {
+  protected:
+    TwoWire *_wire;
+    uint8_t _i2caddr = SI7021_DEFAULT_ADDRESS;
+    si_sensorType _model = SI_UNKNOWN;
+    uint8_t _revision = 0;
+  public:
+    uint32_t sernum_a = 0;
+    uint32_t sernum_b = 0;
+  public:
+    Adafruit_Si7021(TwoWire *theWire = &Wire):_wire(theWire) {}
+    bool begin();
+    void reset();
+    void readSerialNumber();
+    float readTemperature() { return readValue(0xF3); }
+    float readHumidity();
+    si_sensorType getModel() { return _model; }
+    uint8_t getRevision() { return _revision; }
+  protected:
+    bool command(const uint8_t *cmd, uint8_t len);
+    float readValue(uint8_t cmd);
+    uint8_t readRegister8(uint8_t reg);
+};
+
+#endif //ADAFRUIT_SI7021_H
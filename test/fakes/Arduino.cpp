@@ -0,0 +1,344 @@
+#include "Arduino.h"
+#include "Sim.h"
+#include "OneWire.h"
+#include <stdarg.h>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+
+HardwareSerial Serial;
+
+// =================== Simulated environment ===================
+
+static std::atomic<uint64_t> simTime(0);
+static uint32_t yieldStep = 20;
+static bool realTime = false;
+static std::chrono::steady_clock::time_point realStart = std::chrono::steady_clock::now();
+
+struct AnalogPin {
+  std::function<uint16_t(uint64_t)> source;
+  std::vector<uint64_t> reads;
+};
+
+static std::map<uint8_t, AnalogPin> analogPins;
+
+struct DHTValues {
+  float temp;
+  float hum;
+};
+
+static std::map<uint8_t, DHTValues> dhtValues;
+
+void TwoWire_detachAll();
+
+namespace sim {
+
+void reset() {
+  realTime = false;
+  simTime = 0;
+  yieldStep = 20;
+  analogPins.clear();
+  dhtValues.clear();
+  OneWire::resetBuses();
+  TwoWire_detachAll();
+}
+
+uint64_t now() {
+  if(realTime) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - realStart).count();
+  }
+  return simTime;
+}
+
+void advance(uint64_t us) {
+  simTime += us;
+}
+
+void setYieldStep(uint32_t us) {
+  yieldStep = us;
+}
+
+void setRealTime(bool enable) {
+  realTime = enable;
+  realStart = std::chrono::steady_clock::now();
+}
+
+bool isRealTime() {
+  return realTime;
+}
+
+void wait(uint64_t us) {
+  if(realTime) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+  } else {
+    advance(us);
+  }
+}
+
+void setAnalog(uint8_t pin, uint16_t value) {
+  analogPins[pin].source = [value](uint64_t) { return value; };
+}
+
+void setAnalogSource(uint8_t pin, std::function<uint16_t(uint64_t)> source) {
+  analogPins[pin].source = source;
+}
+
+const std::vector<uint64_t> &getAnalogReads(uint8_t pin) {
+  return analogPins[pin].reads;
+}
+
+void setDHT(uint8_t pin, float temp, float hum) {
+  dhtValues[pin] = { temp, hum };
+}
+
+float getDHTTemperature(uint8_t pin) {
+  auto it = dhtValues.find(pin);
+  return it == dhtValues.end()?NAN:it->second.temp;
+}
+
+float getDHTHumidity(uint8_t pin) {
+  auto it = dhtValues.find(pin);
+  return it == dhtValues.end()?NAN:it->second.hum;
+}
+
+}
+
+unsigned long millis() {
+  return (unsigned long)(uint32_t)(sim::now()/1000);
+}
+
+unsigned long micros() {
+  return (unsigned long)(uint32_t)sim::now();
+}
+
+void delay(unsigned long ms) {
+  sim::wait((uint64_t)ms*1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+  sim::wait(us);
+}
+
+void yield() {
+  if(realTime) {
+    std::this_thread::yield();
+  } else {
+    sim::advance(yieldStep);
+  }
+}
+
+int analogRead(uint8_t pin) {
+  AnalogPin &analog = analogPins[pin];
+  uint64_t t = sim::now();
+  analog.reads.push_back(t);
+  return analog.source?analog.source(t):0;
+}
+
+void pinMode(uint8_t, uint8_t) {
+}
+
+// =================== Number formatting ===================
+
+// Copy of dtostrf() of the ESP8266 core
+char *dtostrf(double number, signed char width, unsigned char prec, char *s) {
+  bool negative = false;
+  if(isnan(number)) {
+    strcpy(s, "nan");
+    return s;
+  }
+  if(isinf(number)) {
+    strcpy(s, "inf");
+    return s;
+  }
+  char *out = s;
+  int fillme = width;
+  if(prec > 0) {
+    fillme -= (prec+1);
+  }
+  if(number < 0.0) {
+    negative = true;
+    fillme--;
+    number = -number;
+  }
+  double rounding = 2.0;
+  for(uint8_t i=0;i<prec;++i) {
+    rounding *= 10.0;
+  }
+  rounding = 1.0 / rounding;
+  number += rounding;
+  double tenpow = 1.0;
+  int digitcount = 1;
+  while(number >= 10.0 * tenpow) {
+    tenpow *= 10.0;
+    digitcount++;
+  }
+  number /= tenpow;
+  fillme -= digitcount;
+  while(fillme-- > 0) {
+    *out++ = ' ';
+  }
+  if(negative) {
+    *out++ = '-';
+  }
+  digitcount += prec;
+  int8_t digit = 0;
+  while(digitcount-- > 0) {
+    digit = (int8_t)number;
+    if(digit > 9) {
+      digit = 9;
+    }
+    *out++ = (char)('0' | digit);
+    if((digitcount == prec) && (prec > 0)) {
+      *out++ = '.';
+    }
+    number -= digit;
+    number *= 10.0;
+  }
+  *out = 0;
+  return s;
+}
+
+static std::string toBase(unsigned long long value, unsigned char base) {
+  if(base < 2) {
+    base = 10;
+  }
+  char buff[65];
+  char *p = buff + sizeof(buff);
+  *--p = 0;
+  do {
+    uint8_t d = value % base;
+    *--p = d < 10?'0'+d:'a'+d-10;
+    value /= base;
+  } while(value);
+  return p;
+}
+
+static std::string toBaseSigned(long long value, unsigned char base) {
+  if(base == 10 && value < 0) {
+    return "-" + toBase(-(unsigned long long)value, 10);
+  }
+  // other bases print two's complement of the type
+  return toBase((unsigned long long)value, base);
+}
+
+String::String(unsigned char value, unsigned char base):s(toBase(value, base)) {}
+String::String(int value, unsigned char base):s(base == 10?toBaseSigned(value, base):toBase((unsigned int)value, base)) {}
+String::String(unsigned int value, unsigned char base):s(toBase(value, base)) {}
+String::String(long value, unsigned char base):s(base == 10?toBaseSigned(value, base):toBase((unsigned long)value, base)) {}
+String::String(unsigned long value, unsigned char base):s(toBase(value, base)) {}
+String::String(long long value, unsigned char base):s(toBaseSigned(value, base)) {}
+String::String(unsigned long long value, unsigned char base):s(toBase(value, base)) {}
+
+String::String(float value, unsigned char decimalPlaces) {
+  char buf[64];
+  s = dtostrf(value, decimalPlaces + 2, decimalPlaces, buf);
+}
+
+String::String(double value, unsigned char decimalPlaces) {
+  char buf[330];
+  s = dtostrf(value, decimalPlaces + 2, decimalPlaces, buf);
+}
+
+void String::trim() {
+  size_t b = s.find_first_not_of(" \t\r\n");
+  if(b == std::string::npos) {
+    s.clear();
+    return;
+  }
+  s = s.substr(b, s.find_last_not_of(" \t\r\n") - b + 1);
+}
+
+// =================== Print ===================
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+  while(size--) {
+    n += write(*buffer++);
+  }
+  return n;
+}
+
+size_t Print::printNumber(unsigned long long n, uint8_t base) {
+  std::string str = toBase(n, base);
+  return write(str.c_str(), str.size());
+}
+
+size_t Print::print(long value, int base) {
+  return print((long long)value, base);
+}
+
+size_t Print::print(unsigned long value, int base) {
+  return printNumber(value, base);
+}
+
+size_t Print::print(long long value, int base) {
+  if(base == 10 && value < 0) {
+    return print('-') + printNumber(-(unsigned long long)value, 10);
+  }
+  return printNumber((unsigned long long)value, base);
+}
+
+size_t Print::print(unsigned long long value, int base) {
+  return printNumber(value, base);
+}
+
+// Print::printFloat() of the Arduino cores
+size_t Print::printFloat(double number, uint8_t digits) {
+  size_t n = 0;
+  if(isnan(number)) {
+    return print("nan");
+  }
+  if(isinf(number)) {
+    return print("inf");
+  }
+  if(number > 4294967040.0 || number < -4294967040.0) {
+    return print("ovf");
+  }
+  if(number < 0.0) {
+    n += print('-');
+    number = -number;
+  }
+  double rounding = 0.5;
+  for(uint8_t i=0;i<digits;++i) {
+    rounding /= 10.0;
+  }
+  number += rounding;
+  unsigned long intPart = (unsigned long)number;
+  double remainder = number - (double)intPart;
+  n += print(intPart);
+  if(digits > 0) {
+    n += print('.');
+  }
+  while(digits-- > 0) {
+    remainder *= 10.0;
+    int toPrint = int(remainder);
+    n += print(toPrint);
+    remainder -= toPrint;
+  }
+  return n;
+}
+
+size_t Print::printf(const char *format, ...) {
+  char buff[256];
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(buff, sizeof(buff), format, args);
+  va_end(args);
+  if(len < 0) {
+    return 0;
+  }
+  return write(buff, len < (int)sizeof(buff)?len:sizeof(buff)-1);
+}
+
+size_t Stream::readBytes(uint8_t *buffer, size_t length) {
+  size_t count = 0;
+  while(count < length) {
+    int c = read();
+    if(c < 0) {
+      break;
+    }
+    buffer[count++] = (uint8_t)c;
+  }
+  return count;
+}
@@ -0,0 +1,178 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+// Host replacement of the Arduino core used by tests. String, Print and number formatting behave as in the ESP cores,
+// time comes from the simulated clock of Sim.h
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PROGMEM
+#define PSTR(s) (s)
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(PSTR(s)))
+#define FPSTR(p) (reinterpret_cast<const __FlashStringHelper *>(p))
+#define snprintf_P snprintf
+#define sprintf_P sprintf
+#define strlen_P strlen
+#define memcpy_P memcpy
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define strcat_P strcat
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+#define pgm_read_dword(p) (*(const uint32_t *)(p))
+#define pgm_read_float(p) (*(const float *)(p))
+#define pgm_read_ptr(p) (*(void * const *)(p))
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define INPUT 0
+#define OUTPUT 1
+#define LOW 0
+#define HIGH 1
+
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+// ESP core number to string conversion, rounds half up and prints no sign for negative zero
+char *dtostrf(double number, signed char width, unsigned char prec, char *s);
+
+class String {
+  protected:
+    std::string s;
+  public:
+    String() {}
+    String(const char *c):s(c?c:"") {}
+    String(const __FlashStringHelper *c):s(c?(const char *)c:"") {}
+    String(const std::string &c):s(c) {}
+    String(char c):s(1, c) {}
+    String(unsigned char value, unsigned char base = 10);
+    String(int value, unsigned char base = 10);
+    String(unsigned int value, unsigned char base = 10);
+    String(long value, unsigned char base = 10);
+    String(unsigned long value, unsigned char base = 10);
+    String(long long value, unsigned char base = 10);
+    String(unsigned long long value, unsigned char base = 10);
+    String(float value, unsigned char decimalPlaces = 2);
+    String(double value, unsigned char decimalPlaces = 2);
+    bool reserve(unsigned int size) { s.reserve(size); return true; }
+    unsigned int length() const { return s.size(); }
+    bool isEmpty() const { return s.empty(); }
+    const char *c_str() const { return s.c_str(); }
+    char charAt(unsigned int index) const { return index < s.size()?s[index]:0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char &operator[](unsigned int index) { return s[index]; }
+    bool concat(const String &str) { s += str.s; return true; }
+    bool concat(const char *cstr) { if(cstr) s += cstr; return true; }
+    bool concat(const char *cstr, unsigned int length) { s.append(cstr, length); return true; }
+    bool concat(char c) { s += c; return true; }
+    bool concat(unsigned char num) { return concat(String(num)); }
+    bool concat(short num) { return concat(String((int)num)); }
+    bool concat(unsigned short num) { return concat(String((unsigned int)num)); }
+    bool concat(int num) { return concat(String(num)); }
+    bool concat(unsigned int num) { return concat(String(num)); }
+    bool concat(long num) { return concat(String(num)); }
+    bool concat(unsigned long num) { return concat(String(num)); }
+    bool concat(long long num) { return concat(String(num)); }
+    bool concat(unsigned long long num) { return concat(String(num)); }
+    bool concat(float num) { return concat(String(num)); }
+    bool concat(double num) { return concat(String(num)); }
+    bool concat(const __FlashStringHelper *str) { return concat((const char *)str); }
+    template<typename T> String &operator+=(T value) { concat(value); return *this; }
+    bool equals(const String &str) const { return s == str.s; }
+    bool equals(const char *cstr) const { return s == (cstr?cstr:""); }
+    bool operator==(const String &rhs) const { return equals(rhs); }
+    bool operator==(const char *cstr) const { return equals(cstr); }
+    bool operator!=(const String &rhs) const { return !equals(rhs); }
+    bool operator!=(const char *cstr) const { return !equals(cstr); }
+    bool operator<(const String &rhs) const { return s < rhs.s; }
+    bool startsWith(const String &prefix) const { return s.compare(0, prefix.s.size(), prefix.s) == 0; }
+    bool endsWith(const String &suffix) const { return s.size() >= suffix.s.size() && s.compare(s.size()-suffix.s.size(), suffix.s.size(), suffix.s) == 0; }
+    int indexOf(char ch, unsigned int fromIndex = 0) const { size_t i = s.find(ch, fromIndex); return i == std::string::npos?-1:(int)i; }
+    int indexOf(const String &str, unsigned int fromIndex = 0) const { size_t i = s.find(str.s, fromIndex); return i == std::string::npos?-1:(int)i; }
+    String substring(unsigned int beginIndex) const { return beginIndex < s.size()?String(s.substr(beginIndex)):String(); }
+    String substring(unsigned int beginIndex, unsigned int endIndex) const { return beginIndex < s.size() && endIndex > beginIndex?String(s.substr(beginIndex, endIndex-beginIndex)):String(); }
+    void trim();
+    long toInt() const { return atol(s.c_str()); }
+    float toFloat() const { return atof(s.c_str()); }
+    friend String operator+(const String &lhs, const String &rhs) { String r(lhs); r.concat(rhs); return r; }
+    friend String operator+(const String &lhs, const char *rhs) { String r(lhs); r.concat(rhs); return r; }
+    friend String operator+(const String &lhs, char rhs) { String r(lhs); r.concat(rhs); return r; }
+    friend String operator+(const char *lhs, const String &rhs) { String r(lhs); r.concat(rhs); return r; }
+};
+
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *str) { return str?write((const uint8_t *)str, strlen(str)):0; }
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+    size_t print(const __FlashStringHelper *str) { return write((const char *)str); }
+    size_t print(const String &str) { return write(str.c_str(), str.length()); }
+    size_t print(const char *str) { return write(str); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(int value, int base = DEC) { return print((long)value, base); }
+    size_t print(unsigned int value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(long long value, int base = DEC);
+    size_t print(unsigned long long value, int base = DEC);
+    size_t print(double value, int digits = 2) { return printFloat(value, digits); }
+    template<typename T> size_t println(T value) { return print(value) + println(); }
+    template<typename T> size_t println(T value, int format) { return print(value, format) + println(); }
+    size_t println() { return write("\r\n"); }
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+  protected:
+    size_t printNumber(unsigned long long n, uint8_t base);
+    size_t printFloat(double number, uint8_t digits);
+};
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    size_t readBytes(uint8_t *buffer, size_t length);
+    size_t readBytes(char *buffer, size_t length) { return readBytes((uint8_t *)buffer, length); }
+};
+
+// Collects printed text, tests read it by getOutput()
+class HardwareSerial : public Stream {
+  protected:
+    std::string output;
+  public:
+    void begin(unsigned long) {}
+    virtual size_t write(uint8_t c) override { output += (char)c; return 1; }
+    using Print::write;
+    virtual int available() override { return 0; }
+    virtual int read() override { return -1; }
+    virtual int peek() override { return -1; }
+    const std::string &getOutput() const { return output; }
+    void clearOutput() { output.clear(); }
+};
+
+extern HardwareSerial Serial;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+int analogRead(uint8_t pin);
+void pinMode(uint8_t pin, uint8_t mode);
+
+#endif //ARDUINO_H
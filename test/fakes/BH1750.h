@@ -0,0 +1,66 @@
+#ifndef BH1750_H
+#define BH1750_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// Subset of claws BH1750 library
+class BH1750 {
+  public:
+    enum Mode {
+      UNCONFIGURED = 0,
+      CONTINUOUS_HIGH_RES_MODE = 0x10,
+      CONTINUOUS_HIGH_RES_MODE_2 = 0x11,
+      CONTINUOUS_LOW_RES_MODE = 0x13,
+      ONE_TIME_HIGH_RES_MODE = 0x20,
+      ONE_TIME_HIGH_RES_MODE_2 = 0x21,
+      ONE_TIME_LOW_RES_MODE = 0x23
+    };
+  protected:
+    byte address;
+    TwoWire *i2c = nullptr;
+    Mode mode = UNCONFIGURED;
+    unsigned long lastReadTimestamp = 0;
+  public:
+    BH1750(byte addr = 0x23):address(addr) {}
+    bool begin(Mode mode = CONTINUOUS_HIGH_RES_MODE, byte addr = 0x23, TwoWire *i2c = nullptr) {
+      this->i2c = i2c?i2c:&Wire;
+      if(addr) {
+        address = addr;
+      }
+      return configure(mode);
+    }
+    bool configure(Mode m) {
+      i2c->beginTransmission(address);
+      i2c->write((uint8_t)m);
+      bool ack = i2c->endTransmission() == 0;
+      delay(10);
+      if(ack) {
+        mode = m;
+        lastReadTimestamp = millis();
+      }
+      return ack;
+    }
+    bool measurementReady(bool maxWait = false) {
+      unsigned long delaytime = mode == CONTINUOUS_LOW_RES_MODE || mode == ONE_TIME_LOW_RES_MODE?(maxWait?24:16):(maxWait?180:120);
+      return millis() - lastReadTimestamp >= delaytime;
+    }
+    float readLightLevel() {
+      if(mode == UNCONFIGURED) {
+        return -2.0;
+      }
+      float level = -1.0;
+      if(i2c->requestFrom(address, (uint8_t)2) == 2) {
+        unsigned int tmp = i2c->read() << 8;
+        tmp |= i2c->read();
+        level = tmp / 1.2;
+        if(mode == CONTINUOUS_HIGH_RES_MODE_2 || mode == ONE_TIME_HIGH_RES_MODE_2) {
+          level /= 2;
+        }
+      }
+      lastReadTimestamp = millis();
+      return level;
+    }
+};
+
+#endif //BH1750_H
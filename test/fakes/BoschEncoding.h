@@ -0,0 +1,17 @@
+#ifndef BOSCH_ENCODING_H
+#define BOSCH_ENCODING_H
+
+#include <math.h>
+#include <stdint.h>
+
+// Simplified data encoding shared by the fake Adafruit BME280/BMP280 libraries and the device models.
+// Real chips need compensation by calibration registers, which doesn't matter to the drivers.
+// Temperature and pressure are 20 bit, humidity 16 bit. Skipped measurement reads 0x80000 and 0x8000
+inline uint32_t boschEncodeTemperature(float t) { return (uint32_t)lroundf((t + 100) * 2000); }
+inline float boschDecodeTemperature(uint32_t adc) { return adc / 2000.0f - 100; }
+inline uint32_t boschEncodePressure(float pa) { return (uint32_t)lroundf(pa * 4); }
+inline float boschDecodePressure(uint32_t adc) { return adc / 4.0f; }
+inline uint16_t boschEncodeHumidity(float h) { return (uint16_t)lroundf(h * 600); }
+inline float boschDecodeHumidity(uint16_t adc) { return adc / 600.0f; }
+
+#endif //BOSCH_ENCODING_H
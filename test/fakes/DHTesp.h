@@ -0,0 +1,30 @@
+#ifndef DHTESP_H
+#define DHTESP_H
+
+#include <Arduino.h>
+#include "Sim.h"
+
+// Subset of DHTesp, values come from sim::setDHT(). Reading takes the time of the 1-wire transfer
+class DHTesp {
+  public:
+    enum DHT_MODEL_t { AUTO_DETECT, DHT11, DHT22, AM2302, RHT03 };
+    enum DHT_ERROR_t { ERROR_NONE = 0, ERROR_TIMEOUT, ERROR_CHECKSUM };
+  protected:
+    uint8_t pin = 0;
+    DHT_MODEL_t model = AUTO_DETECT;
+    DHT_ERROR_t error = ERROR_NONE;
+  public:
+    void setup(uint8_t dhtPin, DHT_MODEL_t dhtModel = AUTO_DETECT) { pin = dhtPin; model = dhtModel; }
+    float getTemperature() { return read(sim::getDHTTemperature(pin)); }
+    float getHumidity() { return read(sim::getDHTHumidity(pin)); }
+    DHT_ERROR_t getStatus() { return error; }
+    int getMinimumSamplingPeriod() { return model == DHT11?1000:2000; }
+  protected:
+    float read(float value) {
+      delay(5);
+      error = isnan(value)?ERROR_TIMEOUT:ERROR_NONE;
+      return value;
+    }
+};
+
+#endif //DHTESP_H
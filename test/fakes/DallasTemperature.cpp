@@ -0,0 +1,163 @@
+#include "DallasTemperature.h"
+
+static const uint8_t StartConvo = 0x44;
+static const uint8_t ReadScratch = 0xBE;
+static const uint8_t WriteScratch = 0x4E;
+
+enum { TempLsb = 0, TempMsb, HighAlarm, LowAlarm, Configuration, ScratchPadCrc = 8 };
+
+void DallasTemperature::begin() {
+  DeviceAddress deviceAddress;
+  ScratchPad scratchPad;
+  devices = 0;
+  bitResolution = 9;
+  _wire->reset_search();
+  while(_wire->search(deviceAddress)) {
+    if(validAddress(deviceAddress)) {
+      if(readScratchPad(deviceAddress, scratchPad)) {
+        uint8_t resolution = getResolution(deviceAddress);
+        if(resolution > bitResolution) {
+          bitResolution = resolution;
+        }
+      }
+      devices++;
+    }
+  }
+}
+
+bool DallasTemperature::validAddress(const uint8_t *deviceAddress) {
+  return OneWire::crc8(deviceAddress, 7) == deviceAddress[7];
+}
+
+bool DallasTemperature::getAddress(uint8_t *deviceAddress, uint8_t index) {
+  uint8_t depth = 0;
+  _wire->reset_search();
+  while(depth <= index && _wire->search(deviceAddress)) {
+    if(depth == index && validAddress(deviceAddress)) {
+      return true;
+    }
+    depth++;
+  }
+  return false;
+}
+
+bool DallasTemperature::readScratchPad(const uint8_t *deviceAddress, uint8_t *scratchPad) {
+  if(!_wire->reset()) {
+    return false;
+  }
+  _wire->select(deviceAddress);
+  _wire->write(ReadScratch);
+  for(uint8_t i=0;i<9;i++) {
+    scratchPad[i] = _wire->read();
+  }
+  return _wire->reset() == 1;
+}
+
+void DallasTemperature::writeScratchPad(const uint8_t *deviceAddress, const uint8_t *scratchPad) {
+  _wire->reset();
+  _wire->select(deviceAddress);
+  _wire->write(WriteScratch);
+  _wire->write(scratchPad[HighAlarm]);
+  _wire->write(scratchPad[LowAlarm]);
+  _wire->write(scratchPad[Configuration]);
+  _wire->reset();
+}
+
+bool DallasTemperature::isConnected(const uint8_t *deviceAddress, uint8_t *scratchPad) {
+  bool allZeros = true;
+  bool b = readScratchPad(deviceAddress, scratchPad);
+  for(uint8_t i=0;i<9;i++) {
+    allZeros &= scratchPad[i] == 0;
+  }
+  return b && !allZeros && OneWire::crc8(scratchPad, 8) == scratchPad[ScratchPadCrc];
+}
+
+uint8_t DallasTemperature::getResolution(const uint8_t *deviceAddress) {
+  ScratchPad scratchPad;
+  if(!isConnected(deviceAddress, scratchPad)) {
+    return 0;
+  }
+  return 9 + ((scratchPad[Configuration] >> 5) & 0x03);
+}
+
+bool DallasTemperature::setResolution(const uint8_t *deviceAddress, uint8_t newResolution, bool skipGlobalBitResolutionCalculation) {
+  newResolution = constrain(newResolution, 9, 12);
+  ScratchPad scratchPad;
+  if(!isConnected(deviceAddress, scratchPad)) {
+    return false;
+  }
+  if(getResolution(deviceAddress) != newResolution) {
+    scratchPad[Configuration] = 0x1F | ((newResolution - 9) << 5);
+    writeScratchPad(deviceAddress, scratchPad);
+  }
+  if(!skipGlobalBitResolutionCalculation && newResolution > bitResolution) {
+    bitResolution = newResolution;
+  }
+  return true;
+}
+
+DallasTemperature::request_t DallasTemperature::requestTemperatures() {
+  request_t req;
+  req.result = true;
+  _wire->reset();
+  _wire->skip();
+  _wire->write(StartConvo);
+  req.timestamp = millis();
+  if(waitForConversion) {
+    blockTillConversionComplete(bitResolution);
+  }
+  return req;
+}
+
+bool DallasTemperature::isConversionComplete() {
+  return _wire->read_bit() == 1;
+}
+
+int16_t DallasTemperature::millisToWaitForConversion(uint8_t bitResolution) {
+  switch(bitResolution) {
+    case 9:
+      return 94;
+    case 10:
+      return 188;
+    case 11:
+      return 375;
+    default:
+      return 750;
+  }
+}
+
+void DallasTemperature::blockTillConversionComplete(uint8_t bitResolution) {
+  unsigned long start = millis();
+  if(checkForConversion) {
+    while(!isConversionComplete() && millis() - start < (unsigned long)millisToWaitForConversion(bitResolution)) {
+      yield();
+    }
+  } else {
+    delay(millisToWaitForConversion(bitResolution));
+  }
+}
+
+float DallasTemperature::getTempC(const uint8_t *deviceAddress, uint8_t retryCount) {
+  ScratchPad scratchPad;
+  uint8_t retries = 0;
+  while(retries++ <= retryCount) {
+    if(isConnected(deviceAddress, scratchPad)) {
+      // 1/128 degree fixed point, as the library keeps it
+      int32_t neg = scratchPad[TempMsb] & 0x80?(int32_t)0xFFF80000:0;
+      int32_t raw = (((int16_t)scratchPad[TempMsb]) << 11) | (((int16_t)scratchPad[TempLsb]) << 3) | neg;
+      if(raw <= DEVICE_DISCONNECTED_RAW) {
+        return DEVICE_DISCONNECTED_C;
+      }
+      return raw * 0.0078125f;
+    }
+  }
+  return DEVICE_DISCONNECTED_C;
+}
+
+float DallasTemperature::getTempCByIndex(uint8_t index) {
+  DeviceAddress deviceAddress;
+  if(!getAddress(deviceAddress, index)) {
+    return DEVICE_DISCONNECTED_C;
+  }
+  return getTempC(deviceAddress);
+}
@@ -0,0 +1,48 @@
+#ifndef DALLAS_TEMPERATURE_H
+#define DALLAS_TEMPERATURE_H
+
+#include <OneWire.h>
+
+#define DEVICE_DISCONNECTED_C -127
+#define DEVICE_DISCONNECTED_RAW -7040
+
+typedef uint8_t DeviceAddress[8];
+typedef uint8_t ScratchPad[9];
+
+// Subset of DallasTemperature library used by the drivers, same bus traffic and results for DS18B20 probes
+class DallasTemperature {
+  protected:
+    OneWire *_wire;
+    uint8_t devices = 0;
+    uint8_t bitResolution = 9;
+    bool waitForConversion = true;
+    bool checkForConversion = true;
+  public:
+    struct request_t {
+      bool result;
+      unsigned long timestamp;
+      operator bool() { return result; }
+    };
+    DallasTemperature(OneWire *wire):_wire(wire) {}
+    void begin();
+    uint8_t getDeviceCount() { return devices; }
+    bool validAddress(const uint8_t *deviceAddress);
+    bool getAddress(uint8_t *deviceAddress, uint8_t index);
+    bool isConnected(const uint8_t *deviceAddress, uint8_t *scratchPad);
+    bool readScratchPad(const uint8_t *deviceAddress, uint8_t *scratchPad);
+    void writeScratchPad(const uint8_t *deviceAddress, const uint8_t *scratchPad);
+    uint8_t getResolution() { return bitResolution; }
+    uint8_t getResolution(const uint8_t *deviceAddress);
+    bool setResolution(const uint8_t *deviceAddress, uint8_t newResolution, bool skipGlobalBitResolutionCalculation = false);
+    void setWaitForConversion(bool flag) { waitForConversion = flag; }
+    bool getWaitForConversion() { return waitForConversion; }
+    request_t requestTemperatures();
+    bool isConversionComplete();
+    int16_t millisToWaitForConversion(uint8_t bitResolution);
+    float getTempC(const uint8_t *deviceAddress, uint8_t retryCount = 0);
+    float getTempCByIndex(uint8_t index);
+  protected:
+    void blockTillConversionComplete(uint8_t bitResolution);
+};
+
+#endif //DALLAS_TEMPERATURE_H
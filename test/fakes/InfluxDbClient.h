@@ -0,0 +1,109 @@
+#ifndef INFLUXDB_CLIENT_H
+#define INFLUXDB_CLIENT_H
+
+#include <Arduino.h>
+#include <vector>
+
+// Subset of InfluxDB Arduino client: Point with the library escaping and number formatting,
+// client records written lines instead of sending them
+class Point {
+  protected:
+    String _measurement;
+    String _tags;
+    String _fields;
+    String _timestamp;
+  public:
+    Point(const String &measurement):_measurement(escape(measurement, ", ")) {}
+    void addTag(const String &name, String value) {
+      if(_tags.length() > 0) {
+        _tags += ',';
+      }
+      _tags += escape(name, ",= ");
+      _tags += '=';
+      _tags += escape(value, ",= ");
+    }
+    void addField(const String &name, short value) { putField(name, String(value) + "i"); }
+    void addField(const String &name, unsigned short value) { putField(name, String(value) + "i"); }
+    void addField(const String &name, int value) { putField(name, String(value) + "i"); }
+    void addField(const String &name, unsigned int value) { putField(name, String(value) + "i"); }
+    void addField(const String &name, long value) { putField(name, String(value) + "i"); }
+    void addField(const String &name, unsigned long value) { putField(name, String(value) + "i"); }
+    void addField(const String &name, long long value) { putField(name, String(value) + "i"); }
+    void addField(const String &name, unsigned long long value) { putField(name, String(value) + "i"); }
+    void addField(const String &name, bool value) { putField(name, value?"true":"false"); }
+    void addField(const String &name, float value, int decimalPlaces = 2) {
+      if(!isnan(value)) putField(name, String(value, decimalPlaces));
+    }
+    void addField(const String &name, double value, int decimalPlaces = 2) {
+      if(!isnan(value)) putField(name, String(value, decimalPlaces));
+    }
+    void addField(const String &name, const char *value) { putField(name, "\"" + escape(value, "\\\"") + "\""); }
+    void addField(const String &name, const String &value) { addField(name, value.c_str()); }
+    void setTime(unsigned long long timestamp) { _timestamp = timestamp?String(timestamp):String(); }
+    void setTime(const String &timestamp) { _timestamp = timestamp; }
+    void clearFields() { _fields = String(); _timestamp = String(); }
+    void clearTags() { _tags = String(); }
+    bool hasFields() const { return _fields.length() > 0; }
+    bool hasTags() const { return _tags.length() > 0; }
+    bool hasTime() const { return _timestamp.length() > 0; }
+    String getName() const { return _measurement; }
+    String toLineProtocol(const String &includeTags = "") const {
+      String line = _measurement;
+      if(hasTags()) {
+        line += ",";
+        line += _tags;
+      }
+      if(includeTags.length() > 0) {
+        line += ",";
+        line += includeTags;
+      }
+      if(hasFields()) {
+        line += " ";
+        line += _fields;
+      }
+      if(hasTime()) {
+        line += " ";
+        line += _timestamp;
+      }
+      return line;
+    }
+  protected:
+    void putField(const String &name, const String &value) {
+      if(_fields.length() > 0) {
+        _fields += ',';
+      }
+      _fields += escape(name, ",= ");
+      _fields += '=';
+      _fields += value;
+    }
+    static String escape(const String &value, const char *chars) {
+      String out;
+      for(unsigned int i=0;i<value.length();i++) {
+        if(strchr(chars, value[i])) {
+          out += '\\';
+        }
+        out += value[i];
+      }
+      return out;
+    }
+};
+
+class InfluxDBClient {
+  public:
+    // Written lines, one record can contain more lines
+    std::vector<String> records;
+    // Simulates server or connection failure
+    bool fail = false;
+  public:
+    bool writeRecord(const String &record) { return writeRecord(record.c_str()); }
+    bool writeRecord(const char *record) {
+      if(fail) {
+        return false;
+      }
+      records.push_back(record);
+      return true;
+    }
+    bool writePoint(Point &point) { return writeRecord(point.toLineProtocol()); }
+};
+
+#endif //INFLUXDB_CLIENT_H
@@ -0,0 +1,166 @@
+#include "OneWire.h"
+#include "Sim.h"
+#include <algorithm>
+#include <map>
+
+// Time slots of standard speed: reset with presence detect ~1ms, a bit ~70us
+static const uint32_t ResetTime = 960;
+static const uint32_t BitTime = 70;
+
+static std::map<uint8_t, std::vector<OneWireTarget *>> &buses() {
+  static std::map<uint8_t, std::vector<OneWireTarget *>> map;
+  return map;
+}
+
+void OneWire::attach(uint8_t pin, OneWireTarget &device) {
+  buses()[pin].push_back(&device);
+}
+
+void OneWire::resetBuses() {
+  buses().clear();
+}
+
+std::vector<OneWireTarget *> &OneWire::devices() {
+  return buses()[pin];
+}
+
+uint8_t OneWire::reset() {
+  sim::wait(ResetTime);
+  selected.clear();
+  state = RomCommand;
+  bool presence = false;
+  for(OneWireTarget *device : devices()) {
+    device->reset();
+    presence |= device->present();
+  }
+  return presence;
+}
+
+void OneWire::select(const uint8_t rom[8]) {
+  write(0x55);
+  write_bytes(rom, 8);
+}
+
+void OneWire::skip() {
+  write(0xCC);
+}
+
+void OneWire::write(uint8_t v, uint8_t) {
+  sim::wait(8*BitTime);
+  switch(state) {
+    case RomCommand:
+      if(v == 0xCC) {
+        for(OneWireTarget *device : devices()) {
+          if(device->present()) {
+            selected.push_back(device);
+          }
+        }
+        state = Function;
+      } else if(v == 0x55) {
+        romIndex = 0;
+        state = MatchRom;
+      }
+      break;
+    case MatchRom:
+      romBuffer[romIndex++] = v;
+      if(romIndex == 8) {
+        for(OneWireTarget *device : devices()) {
+          if(device->present() && !memcmp(device->getRom(), romBuffer, 8)) {
+            selected.push_back(device);
+          }
+        }
+        state = Function;
+      }
+      break;
+    case Function:
+      for(OneWireTarget *device : selected) {
+        device->write(v);
+      }
+      break;
+  }
+}
+
+void OneWire::write_bytes(const uint8_t *buf, uint16_t count, bool power) {
+  for(uint16_t i=0;i<count;i++) {
+    write(buf[i], power);
+  }
+}
+
+// Open drain bus: a bit is 1 unless some device pulls it down
+uint8_t OneWire::read() {
+  sim::wait(8*BitTime);
+  uint8_t v = 0xFF;
+  if(state == Function) {
+    for(OneWireTarget *device : selected) {
+      v &= device->read();
+    }
+  }
+  return v;
+}
+
+void OneWire::read_bytes(uint8_t *buf, uint16_t count) {
+  for(uint16_t i=0;i<count;i++) {
+    buf[i] = read();
+  }
+}
+
+uint8_t OneWire::read_bit() {
+  sim::wait(BitTime);
+  uint8_t v = 1;
+  if(state == Function) {
+    for(OneWireTarget *device : selected) {
+      v &= device->readBit();
+    }
+  }
+  return v;
+}
+
+static bool romBefore(const OneWireTarget *a, const OneWireTarget *b) {
+  const uint8_t *ra = a->getRom();
+  const uint8_t *rb = b->getRom();
+  for(uint8_t bit=0;bit<64;bit++) {
+    uint8_t ba = (ra[bit/8] >> (bit%8)) & 1;
+    uint8_t bb = (rb[bit/8] >> (bit%8)) & 1;
+    if(ba != bb) {
+      return ba < bb;
+    }
+  }
+  return false;
+}
+
+bool OneWire::search(uint8_t *newAddr, bool) {
+  std::vector<OneWireTarget *> found;
+  for(OneWireTarget *device : devices()) {
+    if(device->present()) {
+      found.push_back(device);
+    }
+  }
+  std::sort(found.begin(), found.end(), romBefore);
+  // search takes a reset and three slots for each ROM bit
+  sim::wait(ResetTime + 8*BitTime + 64*3*BitTime);
+  state = RomCommand;
+  selected.clear();
+  if(searchIndex >= found.size()) {
+    searchIndex = 0;
+    return false;
+  }
+  memcpy(newAddr, found[searchIndex++]->getRom(), 8);
+  return true;
+}
+
+// Dallas CRC-8, polynomial x^8 + x^5 + x^4 + 1
+uint8_t OneWire::crc8(const uint8_t *addr, uint8_t len) {
+  uint8_t crc = 0;
+  while(len--) {
+    uint8_t inbyte = *addr++;
+    for(uint8_t i=8;i;i--) {
+      uint8_t mix = (crc ^ inbyte) & 0x01;
+      crc >>= 1;
+      if(mix) {
+        crc ^= 0x8C;
+      }
+      inbyte >>= 1;
+    }
+  }
+  return crc;
+}
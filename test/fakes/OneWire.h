@@ -0,0 +1,54 @@
+#ifndef ONEWIRE_H
+#define ONEWIRE_H
+
+#include <Arduino.h>
+#include <vector>
+
+// Device attached to a fake 1-Wire bus, implemented by models in test/models
+class OneWireTarget {
+  public:
+    virtual ~OneWireTarget() {}
+    virtual const uint8_t *getRom() const = 0;
+    // Returns false when the device doesn't answer reset pulse and search
+    virtual bool present() = 0;
+    // Reset pulse ends the current function command
+    virtual void reset() = 0;
+    // Function command or its data written after the device was selected
+    virtual void write(uint8_t data) = 0;
+    virtual uint8_t read() = 0;
+    virtual bool readBit() = 0;
+};
+
+// Fake 1-Wire bus with the API of the OneWire library. Buses are identified by pins, devices are attached by attach().
+// ROM commands (skip, match) select devices, which then get function commands and data
+class OneWire {
+  protected:
+    uint8_t pin;
+    std::vector<OneWireTarget *> selected;
+    enum { RomCommand, MatchRom, Function } state = RomCommand;
+    uint8_t romBuffer[8];
+    uint8_t romIndex = 0;
+    uint8_t searchIndex = 0;
+  public:
+    OneWire(uint8_t pin):pin(pin) {}
+    uint8_t reset();
+    void select(const uint8_t rom[8]);
+    void skip();
+    void write(uint8_t v, uint8_t power = 0);
+    void write_bytes(const uint8_t *buf, uint16_t count, bool power = 0);
+    uint8_t read();
+    void read_bytes(uint8_t *buf, uint16_t count);
+    uint8_t read_bit();
+    void depower() {}
+    void reset_search() { searchIndex = 0; }
+    // Finds devices in the order of the real search algorithm, bits of ROM from the lowest, zero branch first
+    bool search(uint8_t *newAddr, bool search_mode = true);
+    static uint8_t crc8(const uint8_t *addr, uint8_t len);
+    // Test API
+    static void attach(uint8_t pin, OneWireTarget &device);
+    static void resetBuses();
+  protected:
+    std::vector<OneWireTarget *> &devices();
+};
+
+#endif //ONEWIRE_H
@@ -0,0 +1,94 @@
+#include "SHTSensor.h"
+
+static uint8_t shtCrc(const uint8_t *data) {
+  uint8_t crc = 0xFF;
+  for(uint8_t i=0;i<2;i++) {
+    crc ^= data[i];
+    for(uint8_t b=0;b<8;b++) {
+      crc = crc & 0x80?(crc << 1) ^ 0x31:crc << 1;
+    }
+  }
+  return crc;
+}
+
+bool SHTSensor::init(TwoWire &w) {
+  wire = &w;
+  if(mSensorType != AUTO_DETECT) {
+    detected = mSensorType;
+    return readSample();
+  }
+  static const SHTSensorType candidates[] = { SHT3X, SHT3X_ALT, SHTC1 };
+  for(SHTSensorType t : candidates) {
+    detected = t;
+    if(readSample()) {
+      return true;
+    }
+  }
+  detected = AUTO_DETECT;
+  return false;
+}
+
+bool SHTSensor::command(uint8_t address, uint16_t cmd) {
+  wire->beginTransmission(address);
+  wire->write(cmd >> 8);
+  wire->write(cmd & 0xFF);
+  return wire->endTransmission() == 0;
+}
+
+bool SHTSensor::readType(SHTSensorType type) {
+  uint8_t address;
+  uint16_t cmd;
+  uint32_t duration;
+  switch(type) {
+    case SHTC1:
+    case SHTC3:
+    case SHTW1:
+    case SHTW2:
+      address = 0x70;
+      cmd = 0x7866;
+      duration = 15;
+      if(type == SHTC3 && !command(address, 0x3517)) {
+        return false;
+      }
+      delay(1);
+      break;
+    case SHT3X:
+    case SHT85:
+    case SHT3X_ALT:
+      address = type == SHT3X_ALT?0x45:0x44;
+      cmd = accuracy == SHT_ACCURACY_HIGH?0x2400:accuracy == SHT_ACCURACY_MEDIUM?0x240B:0x2416;
+      duration = accuracy == SHT_ACCURACY_HIGH?15:accuracy == SHT_ACCURACY_MEDIUM?6:4;
+      break;
+    default:
+      return false;
+  }
+  if(!command(address, cmd)) {
+    return false;
+  }
+  delay(duration);
+  uint8_t data[6];
+  if(wire->requestFrom(address, (uint8_t)6) != 6) {
+    return false;
+  }
+  for(uint8_t i=0;i<6;i++) {
+    data[i] = wire->read();
+  }
+  if(type == SHTC3) {
+    command(address, 0xB098);
+  }
+  if(shtCrc(data) != data[2] || shtCrc(data+3) != data[5]) {
+    return false;
+  }
+  uint16_t t = (data[0] << 8) | data[1];
+  uint16_t h = (data[3] << 8) | data[4];
+  temperature = -45 + 175.0f*t/65535;
+  humidity = 100.0f*h/65535;
+  return true;
+}
+
+bool SHTSensor::readSample() {
+  if(!wire || detected == AUTO_DETECT) {
+    return false;
+  }
+  return readType(detected);
+}
@@ -0,0 +1,32 @@
+#ifndef SHT_SENSOR_H
+#define SHT_SENSOR_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// Subset of arduino-sht: SHT3x and SHTC1/SHTC3 single shot measurements.
+// init() detects the sensor and returns result of the first readSample(), as the library does
+class SHTSensor {
+  public:
+    enum SHTSensorType { AUTO_DETECT, SHTC1, SHTC3, SHTW1, SHTW2, SHT3X, SHT85, SHT3X_ALT, SHT4X };
+    enum SHTAccuracy { SHT_ACCURACY_HIGH, SHT_ACCURACY_MEDIUM, SHT_ACCURACY_LOW };
+    SHTSensorType mSensorType;
+  protected:
+    TwoWire *wire = nullptr;
+    SHTSensorType detected = AUTO_DETECT;
+    SHTAccuracy accuracy = SHT_ACCURACY_HIGH;
+    float temperature = NAN;
+    float humidity = NAN;
+  public:
+    SHTSensor(SHTSensorType type = AUTO_DETECT):mSensorType(type) {}
+    bool init(TwoWire &wire = Wire);
+    bool readSample();
+    float getTemperature() const { return temperature; }
+    float getHumidity() const { return humidity; }
+    bool setAccuracy(SHTAccuracy newAccuracy) { accuracy = newAccuracy; return true; }
+  protected:
+    bool readType(SHTSensorType type);
+    bool command(uint8_t address, uint16_t cmd);
+};
+
+#endif //SHT_SENSOR_H
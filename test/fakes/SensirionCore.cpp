@@ -0,0 +1,62 @@
+#include "SensirionCore.h"
+
+void errorToString(uint16_t error, char errorMessage[], size_t errorMessageSize) {
+  switch(error & 0xFF00) {
+    case WriteError:
+      snprintf(errorMessage, errorMessageSize, "Error writing to I2C bus: %u", error & 0xFF);
+      break;
+    case ReadError:
+      snprintf(errorMessage, errorMessageSize, "%s", (error & 0xFF) == CRCError?"Wrong CRC found":"Not enough data received");
+      break;
+    default:
+      snprintf(errorMessage, errorMessageSize, "Error: %u", error);
+  }
+}
+
+uint8_t sensirionCrc(uint16_t word) {
+  uint8_t crc = 0xFF;
+  uint8_t bytes[2] = { (uint8_t)(word >> 8), (uint8_t)word };
+  for(uint8_t i=0;i<2;i++) {
+    crc ^= bytes[i];
+    for(uint8_t b=0;b<8;b++) {
+      crc = crc & 0x80?(crc << 1) ^ 0x31:crc << 1;
+    }
+  }
+  return crc;
+}
+
+uint16_t sensirionSendCommand(TwoWire &wire, uint8_t address, uint16_t command, const uint16_t *args, uint8_t argc, uint8_t commandBytes) {
+  wire.beginTransmission(address);
+  if(commandBytes == 2) {
+    wire.write(command >> 8);
+  }
+  wire.write(command & 0xFF);
+  for(uint8_t i=0;i<argc;i++) {
+    wire.write(args[i] >> 8);
+    wire.write(args[i] & 0xFF);
+    wire.write(sensirionCrc(args[i]));
+  }
+  uint8_t err = wire.endTransmission();
+  return err?WriteError | err:NoError;
+}
+
+uint16_t sensirionReadWords(TwoWire &wire, uint8_t address, uint16_t *words, uint8_t count) {
+  uint8_t received = wire.requestFrom(address, (uint8_t)(count*3));
+  if(received != count*3) {
+    while(wire.available()) {
+      wire.read();
+    }
+    return ReadError | NotEnoughDataError;
+  }
+  uint16_t err = NoError;
+  for(uint8_t i=0;i<count;i++) {
+    uint8_t hi = wire.read();
+    uint8_t lo = wire.read();
+    uint8_t crc = wire.read();
+    words[i] = (hi << 8) | lo;
+    if(sensirionCrc(words[i]) != crc) {
+      err = ReadError | CRCError;
+    }
+  }
+  return err;
+}
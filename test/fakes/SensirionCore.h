@@ -0,0 +1,29 @@
+#ifndef SENSIRION_CORE_H
+#define SENSIRION_CORE_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// Subset of Sensirion Arduino Core: error codes and word transfers with CRC-8, shared by fake Sensirion drivers
+enum HighLevelError : uint16_t {
+  NoError = 0,
+  WriteError = 0x0100,
+  ReadError = 0x0200,
+  TxFrameError = 0x0300,
+  RxFrameError = 0x0400,
+};
+
+enum LowLevelError : uint16_t {
+  CRCError = 0x0001,
+  NotEnoughDataError = 0x0002,
+};
+
+void errorToString(uint16_t error, char errorMessage[], size_t errorMessageSize);
+
+uint8_t sensirionCrc(uint16_t word);
+// Sends 16 bit (or 8 bit) command with argument words, returns error code
+uint16_t sensirionSendCommand(TwoWire &wire, uint8_t address, uint16_t command, const uint16_t *args = nullptr, uint8_t argc = 0, uint8_t commandBytes = 2);
+// Reads words checking CRC, returns error code
+uint16_t sensirionReadWords(TwoWire &wire, uint8_t address, uint16_t *words, uint8_t count);
+
+#endif //SENSIRION_CORE_H
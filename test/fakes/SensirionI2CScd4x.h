@@ -0,0 +1,56 @@
+#ifndef SENSIRION_I2C_SCD4X_H
+#define SENSIRION_I2C_SCD4X_H
+
+#include <SensirionCore.h>
+
+// Subset of Sensirion SCD4x driver with the library command timing
+class SensirionI2CScd4x {
+  protected:
+    TwoWire *wire = nullptr;
+  public:
+    void begin(TwoWire &i2cBus) { wire = &i2cBus; }
+    uint16_t startPeriodicMeasurement() { return command(0x21B1, 1); }
+    uint16_t startLowPowerPeriodicMeasurement() { return command(0x21AC, 1); }
+    uint16_t stopPeriodicMeasurement() { return command(0x3F86, 500); }
+    uint16_t measureSingleShot() { return command(0x219D, 5000); }
+    uint16_t measureSingleShotRhtOnly() { return command(0x2196, 50); }
+    uint16_t wakeUp() { sensirionSendCommand(*wire, 0x62, 0x36F6); delay(20); return NoError; }
+    uint16_t powerDown() { return command(0x36E0, 1); }
+    uint16_t readMeasurement(uint16_t &co2, float &temperature, float &humidity) {
+      uint16_t words[3];
+      uint16_t err = read(0xEC05, 1, words, 3);
+      if(!err) {
+        co2 = words[0];
+        temperature = -45 + 175.0f*words[1]/65536;
+        humidity = 100.0f*words[2]/65536;
+      }
+      return err;
+    }
+    uint16_t getDataReadyStatus(uint16_t &dataReadyStatus) { return read(0xE4B8, 1, &dataReadyStatus, 1); }
+    uint16_t getDataReadyFlag(bool &dataReadyFlag) {
+      uint16_t status = 0;
+      uint16_t err = getDataReadyStatus(status);
+      dataReadyFlag = (status & 0x07FF) != 0;
+      return err;
+    }
+    uint16_t getSerialNumber(uint16_t &serial0, uint16_t &serial1, uint16_t &serial2) {
+      uint16_t words[3];
+      uint16_t err = read(0x3682, 1, words, 3);
+      serial0 = words[0];
+      serial1 = words[1];
+      serial2 = words[2];
+      return err;
+    }
+  protected:
+    uint16_t command(uint16_t cmd, uint32_t delayMs) {
+      uint16_t err = sensirionSendCommand(*wire, 0x62, cmd);
+      delay(delayMs);
+      return err;
+    }
+    uint16_t read(uint16_t cmd, uint32_t delayMs, uint16_t *words, uint8_t count) {
+      uint16_t err = command(cmd, delayMs);
+      return err?err:sensirionReadWords(*wire, 0x62, words, count);
+    }
+};
+
+#endif //SENSIRION_I2C_SCD4X_H
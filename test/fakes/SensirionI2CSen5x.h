@@ -0,0 +1,69 @@
+#ifndef SENSIRION_I2C_SEN5X_H
+#define SENSIRION_I2C_SEN5X_H
+
+#include <SensirionCore.h>
+
+// Subset of Sensirion SEN5x driver with the library command timing
+class SensirionI2CSen5x {
+  protected:
+    TwoWire *wire = nullptr;
+  public:
+    void begin(TwoWire &i2cBus) { wire = &i2cBus; }
+    uint16_t deviceReset() { return command(0xD304, 200); }
+    uint16_t startMeasurement() { return command(0x0021, 50); }
+    uint16_t startMeasurementWithoutPm() { return command(0x0037, 50); }
+    uint16_t stopMeasurement() { return command(0x0104, 200); }
+    uint16_t readDataReady(bool &dataReady) {
+      uint16_t word = 0;
+      uint16_t err = read(0x0202, 20, &word, 1);
+      dataReady = word & 0xFF;
+      return err;
+    }
+    uint16_t readMeasuredValues(float &pm1p0, float &pm2p5, float &pm4p0, float &pm10p0, float &humidity, float &temperature, float &vocIndex, float &noxIndex) {
+      uint16_t w[8];
+      uint16_t err = read(0x03C4, 20, w, 8);
+      if(!err) {
+        pm1p0 = w[0] == 0xFFFF?NAN:w[0]/10.0f;
+        pm2p5 = w[1] == 0xFFFF?NAN:w[1]/10.0f;
+        pm4p0 = w[2] == 0xFFFF?NAN:w[2]/10.0f;
+        pm10p0 = w[3] == 0xFFFF?NAN:w[3]/10.0f;
+        humidity = w[4] == 0x7FFF?NAN:(int16_t)w[4]/100.0f;
+        temperature = w[5] == 0x7FFF?NAN:(int16_t)w[5]/200.0f;
+        vocIndex = w[6] == 0x7FFF?NAN:(int16_t)w[6]/10.0f;
+        noxIndex = w[7] == 0x7FFF?NAN:(int16_t)w[7]/10.0f;
+      }
+      return err;
+    }
+    uint16_t getVocAlgorithmState(uint8_t state[], uint8_t stateSize) {
+      uint16_t w[4];
+      uint16_t err = read(0x6181, 20, w, 4);
+      for(uint8_t i=0;i<8 && i<stateSize && !err;i++) {
+        state[i] = i%2?w[i/2]:w[i/2] >> 8;
+      }
+      return err;
+    }
+    uint16_t setVocAlgorithmState(const uint8_t state[], uint8_t stateSize) {
+      if(stateSize < 8) {
+        return TxFrameError;
+      }
+      uint16_t w[4];
+      for(uint8_t i=0;i<4;i++) {
+        w[i] = (state[i*2] << 8) | state[i*2+1];
+      }
+      uint16_t err = sensirionSendCommand(*wire, 0x69, 0x6181, w, 4);
+      delay(20);
+      return err;
+    }
+  protected:
+    uint16_t command(uint16_t cmd, uint32_t delayMs) {
+      uint16_t err = sensirionSendCommand(*wire, 0x69, cmd);
+      delay(delayMs);
+      return err;
+    }
+    uint16_t read(uint16_t cmd, uint32_t delayMs, uint16_t *words, uint8_t count) {
+      uint16_t err = command(cmd, delayMs);
+      return err?err:sensirionReadWords(*wire, 0x69, words, count);
+    }
+};
+
+#endif //SENSIRION_I2C_SEN5X_H
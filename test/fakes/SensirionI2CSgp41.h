@@ -0,0 +1,52 @@
+#ifndef SENSIRION_I2C_SGP41_H
+#define SENSIRION_I2C_SGP41_H
+
+#include <SensirionCore.h>
+
+// Subset of Sensirion SGP41 driver with the library command timing
+class SensirionI2CSgp41 {
+  protected:
+    TwoWire *wire = nullptr;
+  public:
+    void begin(TwoWire &i2cBus) { wire = &i2cBus; }
+    uint16_t executeSelfTest(uint16_t &testResult) {
+      uint16_t err = sensirionSendCommand(*wire, 0x59, 0x280E);
+      delay(320);
+      return err?err:sensirionReadWords(*wire, 0x59, &testResult, 1);
+    }
+    uint16_t executeConditioning(uint16_t defaultRh, uint16_t defaultT, uint16_t &srawVoc) {
+      uint16_t args[2] = { defaultRh, defaultT };
+      uint16_t err = sensirionSendCommand(*wire, 0x59, 0x2612, args, 2);
+      delay(50);
+      return err?err:sensirionReadWords(*wire, 0x59, &srawVoc, 1);
+    }
+    uint16_t measureRawSignals(uint16_t relativeHumidity, uint16_t temperature, uint16_t &srawVoc, uint16_t &srawNox) {
+      uint16_t args[2] = { relativeHumidity, temperature };
+      uint16_t words[2];
+      uint16_t err = sensirionSendCommand(*wire, 0x59, 0x2619, args, 2);
+      delay(50);
+      if(!err) {
+        err = sensirionReadWords(*wire, 0x59, words, 2);
+      }
+      if(!err) {
+        srawVoc = words[0];
+        srawNox = words[1];
+      }
+      return err;
+    }
+    uint16_t turnHeaterOff() {
+      uint16_t err = sensirionSendCommand(*wire, 0x59, 0x3615);
+      delay(1);
+      return err;
+    }
+    uint16_t getSerialNumber(uint16_t serialNumber[], uint8_t serialNumberSize) {
+      if(serialNumberSize < 3) {
+        return RxFrameError;
+      }
+      uint16_t err = sensirionSendCommand(*wire, 0x59, 0x3682);
+      delay(1);
+      return err?err:sensirionReadWords(*wire, 0x59, serialNumber, 3);
+    }
+};
+
+#endif //SENSIRION_I2C_SGP41_H
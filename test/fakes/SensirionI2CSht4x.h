@@ -0,0 +1,40 @@
+#ifndef SENSIRION_I2C_SHT4X_H
+#define SENSIRION_I2C_SHT4X_H
+
+#include <SensirionCore.h>
+
+// Subset of Sensirion SHT4x driver with the library command timing
+class SensirionI2CSht4x {
+  protected:
+    TwoWire *wire = nullptr;
+  public:
+    void begin(TwoWire &i2cBus) { wire = &i2cBus; }
+    uint16_t serialNumber(uint32_t &serial) {
+      uint16_t words[2];
+      uint16_t err = read(0x89, 10, words);
+      if(!err) {
+        serial = ((uint32_t)words[0] << 16) | words[1];
+      }
+      return err;
+    }
+    uint16_t measureHighPrecision(float &temperature, float &humidity) { return measure(0xFD, 10, temperature, humidity); }
+    uint16_t measureMediumPrecision(float &temperature, float &humidity) { return measure(0xF6, 5, temperature, humidity); }
+    uint16_t measureLowestPrecision(float &temperature, float &humidity) { return measure(0xE0, 2, temperature, humidity); }
+  protected:
+    uint16_t read(uint8_t cmd, uint32_t delayMs, uint16_t *words) {
+      uint16_t err = sensirionSendCommand(*wire, 0x44, cmd, nullptr, 0, 1);
+      delay(delayMs);
+      return err?err:sensirionReadWords(*wire, 0x44, words, 2);
+    }
+    uint16_t measure(uint8_t cmd, uint32_t delayMs, float &temperature, float &humidity) {
+      uint16_t words[2];
+      uint16_t err = read(cmd, delayMs, words);
+      if(!err) {
+        temperature = -45 + 175.0f*words[0]/65535;
+        humidity = -6 + 125.0f*words[1]/65535;
+      }
+      return err;
+    }
+};
+
+#endif //SENSIRION_I2C_SHT4X_H
@@ -0,0 +1,39 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <functional>
+#include <vector>
+
+// Simulated environment of the fake Arduino core.
+// Time is simulated by default: delay() and bus transfers advance it instantly, yield() by a small step,
+// so tests of long conversions run fast and deterministically. In real time mode millis()/micros() follow
+// the host clock and delays sleep, which is needed when several threads read buses in parallel
+namespace sim {
+
+// Resets time to zero in simulated time mode, clears analog sources, DHT values and 1-Wire buses. Devices attached to TwoWire are detached
+void reset();
+
+uint64_t now();
+void advance(uint64_t us);
+// Time added by every yield() in simulated mode
+void setYieldStep(uint32_t us);
+void setRealTime(bool enable);
+bool isRealTime();
+// Waits us in the current mode, used by fake buses for transfer time
+void wait(uint64_t us);
+
+// Value returned by analogRead(pin), the source gets current time in us
+void setAnalog(uint8_t pin, uint16_t value);
+void setAnalogSource(uint8_t pin, std::function<uint16_t(uint64_t)> source);
+// Times (us) of analogRead() calls of the pin
+const std::vector<uint64_t> &getAnalogReads(uint8_t pin);
+
+// Values returned by DHTesp on the pin, NAN simulates a missing device
+void setDHT(uint8_t pin, float temp, float hum);
+float getDHTTemperature(uint8_t pin);
+float getDHTHumidity(uint8_t pin);
+
+}
+
+#endif //SIM_H
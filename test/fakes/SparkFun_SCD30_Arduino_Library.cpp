@@ -0,0 +1,133 @@
+#include "SparkFun_SCD30_Arduino_Library.h"
+
+static uint8_t scd30Crc(const uint8_t *data) {
+  uint8_t crc = 0xFF;
+  for(uint8_t i=0;i<2;i++) {
+    crc ^= data[i];
+    for(uint8_t b=0;b<8;b++) {
+      crc = crc & 0x80?(crc << 1) ^ 0x31:crc << 1;
+    }
+  }
+  return crc;
+}
+
+bool SCD30::begin(TwoWire &wirePort, bool autoCalibrate, bool measBegin) {
+  wire = &wirePort;
+  if(!isConnected()) {
+    return false;
+  }
+  if(!measBegin) {
+    return true;
+  }
+  if(beginMeasuring()) {
+    setMeasurementInterval(2);
+    setAutoSelfCalibration(autoCalibrate);
+    return true;
+  }
+  return false;
+}
+
+bool SCD30::isConnected() {
+  uint8_t data[3];
+  if(!sendCommand(0xD100)) {
+    return false;
+  }
+  delay(3);
+  if(wire->requestFrom((uint8_t)SCD30_ADDRESS, (uint8_t)3) != 3) {
+    return false;
+  }
+  for(uint8_t i=0;i<3;i++) {
+    data[i] = wire->read();
+  }
+  return scd30Crc(data) == data[2];
+}
+
+bool SCD30::sendCommand(uint16_t command, uint16_t arguments) {
+  uint8_t data[2] = { (uint8_t)(arguments >> 8), (uint8_t)arguments };
+  wire->beginTransmission(SCD30_ADDRESS);
+  wire->write(command >> 8);
+  wire->write(command & 0xFF);
+  wire->write(data[0]);
+  wire->write(data[1]);
+  wire->write(scd30Crc(data));
+  return wire->endTransmission() == 0;
+}
+
+bool SCD30::sendCommand(uint16_t command) {
+  wire->beginTransmission(SCD30_ADDRESS);
+  wire->write(command >> 8);
+  wire->write(command & 0xFF);
+  return wire->endTransmission() == 0;
+}
+
+uint16_t SCD30::readRegister(uint16_t registerAddress) {
+  if(!sendCommand(registerAddress)) {
+    return 0;
+  }
+  delay(3);
+  if(wire->requestFrom((uint8_t)SCD30_ADDRESS, (uint8_t)2) != 2) {
+    return 0;
+  }
+  uint8_t msb = wire->read();
+  uint8_t lsb = wire->read();
+  return (msb << 8) | lsb;
+}
+
+bool SCD30::readMeasurement() {
+  if(!dataAvailable()) {
+    return false;
+  }
+  if(!sendCommand(0x0300)) {
+    return false;
+  }
+  delay(3);
+  if(wire->requestFrom((uint8_t)SCD30_ADDRESS, (uint8_t)18) != 18) {
+    return false;
+  }
+  uint32_t values[3] = { 0 };
+  bool error = false;
+  for(uint8_t v=0;v<3;v++) {
+    for(uint8_t w=0;w<2;w++) {
+      uint8_t data[3];
+      for(uint8_t i=0;i<3;i++) {
+        data[i] = wire->read();
+      }
+      if(scd30Crc(data) != data[2]) {
+        error = true;
+      }
+      values[v] = (values[v] << 16) | (data[0] << 8) | data[1];
+    }
+  }
+  if(error) {
+    return false;
+  }
+  memcpy(&co2, &values[0], 4);
+  memcpy(&temperature, &values[1], 4);
+  memcpy(&humidity, &values[2], 4);
+  co2HasBeenReported = temperatureHasBeenReported = humidityHasBeenReported = false;
+  return true;
+}
+
+uint16_t SCD30::getCO2() {
+  if(co2HasBeenReported) {
+    readMeasurement();
+  }
+  co2HasBeenReported = true;
+  return (uint16_t)co2;
+}
+
+float SCD30::getTemperature() {
+  if(temperatureHasBeenReported) {
+    readMeasurement();
+  }
+  temperatureHasBeenReported = true;
+  return temperature;
+}
+
+float SCD30::getHumidity() {
+  if(humidityHasBeenReported) {
+    readMeasurement();
+  }
+  humidityHasBeenReported = true;
+  return humidity;
+}
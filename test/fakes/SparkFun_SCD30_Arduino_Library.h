@@ -0,0 +1,38 @@
+#ifndef SPARKFUN_SCD30_ARDUINO_LIBRARY_H
+#define SPARKFUN_SCD30_ARDUINO_LIBRARY_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#define SCD30_ADDRESS 0x61
+
+// Subset of SparkFun SCD30 library. Values are cached, getters read new measurement once the cached value was reported
+class SCD30 {
+  protected:
+    TwoWire *wire = nullptr;
+    float co2 = 0;
+    float temperature = 0;
+    float humidity = 0;
+    bool co2HasBeenReported = true;
+    bool temperatureHasBeenReported = true;
+    bool humidityHasBeenReported = true;
+  public:
+    bool begin(bool autoCalibrate) { return begin(Wire, autoCalibrate); }
+    bool begin(TwoWire &wirePort = Wire, bool autoCalibrate = false, bool measBegin = true);
+    bool isConnected();
+    bool beginMeasuring(uint16_t pressureOffset = 0) { return sendCommand(0x0010, pressureOffset); }
+    bool StopMeasurement() { return sendCommand(0x0104); }
+    bool setMeasurementInterval(uint16_t interval) { return sendCommand(0x4600, interval); }
+    bool setAutoSelfCalibration(bool enable) { return sendCommand(0x5306, enable); }
+    bool dataAvailable() { return readRegister(0x0202) == 1; }
+    bool readMeasurement();
+    uint16_t getCO2();
+    float getTemperature();
+    float getHumidity();
+  protected:
+    bool sendCommand(uint16_t command, uint16_t arguments);
+    bool sendCommand(uint16_t command);
+    uint16_t readRegister(uint16_t registerAddress);
+};
+
+#endif //SPARKFUN_SCD30_ARDUINO_LIBRARY_H
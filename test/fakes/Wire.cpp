@@ -0,0 +1,113 @@
+#include "Wire.h"
+#include "Sim.h"
+#include <algorithm>
+
+static std::vector<TwoWire *> &allBuses() {
+  static std::vector<TwoWire *> buses;
+  return buses;
+}
+
+TwoWire Wire;
+TwoWire Wire1;
+
+void TwoWire_detachAll() {
+  for(TwoWire *bus : allBuses()) {
+    bus->detachAll();
+  }
+}
+
+TwoWire::TwoWire() {
+  allBuses().push_back(this);
+}
+
+TwoWire::~TwoWire() {
+  auto &buses = allBuses();
+  buses.erase(std::remove(buses.begin(), buses.end(), this), buses.end());
+}
+
+void TwoWire::attach(I2CTarget &device) {
+  devices.push_back(&device);
+}
+
+void TwoWire::detach(I2CTarget &device) {
+  devices.erase(std::remove(devices.begin(), devices.end(), &device), devices.end());
+}
+
+void TwoWire::detachAll() {
+  devices.clear();
+  rxBuffer.clear();
+  rxIndex = 0;
+  transmitting = false;
+  clock = 100000;
+  resetCounters();
+}
+
+I2CTarget *TwoWire::find(uint8_t address) {
+  for(I2CTarget *device : devices) {
+    if(device->getAddress() == address) {
+      return device;
+    }
+  }
+  return nullptr;
+}
+
+// Each byte takes 9 clocks (8 bits and acknowledge)
+void TwoWire::transfer(size_t len) {
+  transactions++;
+  bytes += len;
+  sim::wait((uint64_t)len*9*1000000/clock);
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  txAddress = address;
+  txBuffer.clear();
+  transmitting = true;
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if(!transmitting) {
+    return 0;
+  }
+  txBuffer.push_back(data);
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity) {
+  for(size_t i=0;i<quantity;i++) {
+    write(data[i]);
+  }
+  return transmitting?quantity:0;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+  transmitting = false;
+  I2CTarget *device = find(txAddress);
+  if(!device || !device->acknowledge()) {
+    transfer(1);
+    return 2;
+  }
+  transfer(1 + txBuffer.size());
+  if(!txBuffer.empty() && !device->receive(txBuffer.data(), txBuffer.size())) {
+    return 3;
+  }
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity) {
+  return requestFrom(address, quantity, (uint8_t)1);
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, uint8_t) {
+  rxBuffer.clear();
+  rxIndex = 0;
+  I2CTarget *device = find(address);
+  if(!device || !device->acknowledge()) {
+    transfer(1);
+    return 0;
+  }
+  rxBuffer.resize(quantity);
+  size_t len = quantity?device->transmit(rxBuffer.data(), quantity):0;
+  rxBuffer.resize(len);
+  transfer(1 + len);
+  return len;
+}
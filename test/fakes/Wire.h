@@ -0,0 +1,69 @@
+#ifndef WIRE_H
+#define WIRE_H
+
+#include <Arduino.h>
+#include <vector>
+
+// Device attached to a fake bus, implemented by models in test/models
+class I2CTarget {
+  public:
+    virtual ~I2CTarget() {}
+    virtual uint8_t getAddress() const = 0;
+    // Returns false when the device doesn't acknowledge its address
+    virtual bool acknowledge() = 0;
+    // Bytes written in one transaction, returns false to not acknowledge them
+    virtual bool receive(const uint8_t *data, size_t len) = 0;
+    // Fills bytes read in one transaction, returns their count, 0 when the device doesn't acknowledge the read
+    virtual size_t transmit(uint8_t *data, size_t len) = 0;
+};
+
+// Fake I2C bus with the API of the Arduino cores. Transactions are routed to attached devices and take time of the
+// transferred bytes (address included) at the bus clock, in simulated or real time
+class TwoWire : public Stream {
+  protected:
+    std::vector<I2CTarget *> devices;
+    uint8_t txAddress = 0;
+    std::vector<uint8_t> txBuffer;
+    bool transmitting = false;
+    std::vector<uint8_t> rxBuffer;
+    size_t rxIndex = 0;
+    uint32_t clock = 100000;
+    uint32_t transactions = 0;
+    uint64_t bytes = 0;
+  public:
+    TwoWire();
+    virtual ~TwoWire();
+    bool begin() { return true; }
+    bool begin(int, int, uint32_t frequency = 0) { if(frequency) clock = frequency; return true; }
+    void setClock(uint32_t frequency) { clock = frequency; }
+    void beginTransmission(uint8_t address);
+    void beginTransmission(int address) { beginTransmission((uint8_t)address); }
+    // Returns 0 on success, 2 when address was not acknowledged, 3 when data were not acknowledged
+    uint8_t endTransmission(bool sendStop = true);
+    uint8_t requestFrom(uint8_t address, uint8_t quantity);
+    uint8_t requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop);
+    uint8_t requestFrom(int address, int quantity) { return requestFrom((uint8_t)address, (uint8_t)quantity); }
+    uint8_t requestFrom(int address, int quantity, int sendStop) { return requestFrom((uint8_t)address, (uint8_t)quantity, (uint8_t)sendStop); }
+    virtual size_t write(uint8_t data) override;
+    virtual size_t write(const uint8_t *data, size_t quantity) override;
+    using Print::write;
+    virtual int available() override { return rxBuffer.size() - rxIndex; }
+    virtual int read() override { return rxIndex < rxBuffer.size()?rxBuffer[rxIndex++]:-1; }
+    virtual int peek() override { return rxIndex < rxBuffer.size()?rxBuffer[rxIndex]:-1; }
+    void flush() {}
+    // Test API
+    void attach(I2CTarget &device);
+    void detach(I2CTarget &device);
+    void detachAll();
+    uint32_t getTransactions() const { return transactions; }
+    uint64_t getBytes() const { return bytes; }
+    void resetCounters() { transactions = 0; bytes = 0; }
+  protected:
+    I2CTarget *find(uint8_t address);
+    void transfer(size_t len);
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif //WIRE_H
@@ -0,0 +1,87 @@
+#include "ccs811.h"
+
+bool CCS811::i2cwrite(uint8_t regaddr, int count, const uint8_t *buf) {
+  Wire.beginTransmission(slaveaddr);
+  Wire.write(regaddr);
+  for(int i=0;i<count;i++) {
+    Wire.write(buf[i]);
+  }
+  return Wire.endTransmission() == 0;
+}
+
+bool CCS811::i2cread(uint8_t regaddr, int count, uint8_t *buf) {
+  Wire.beginTransmission(slaveaddr);
+  Wire.write(regaddr);
+  if(Wire.endTransmission(false) != 0) {
+    return false;
+  }
+  delayMicroseconds(i2cdelay_us);
+  if(Wire.requestFrom(slaveaddr, count) != count) {
+    return false;
+  }
+  for(int i=0;i<count;i++) {
+    buf[i] = Wire.read();
+  }
+  return true;
+}
+
+bool CCS811::begin() {
+  static const uint8_t swReset[] = { 0x11, 0xE5, 0x72, 0x8A };
+  uint8_t hwId = 0, hwVersion = 0, status = 0, version[2] = { 0 };
+  if(!i2cwrite(0xFF, 4, swReset)) {
+    return false;
+  }
+  delayMicroseconds(2000);
+  if(!i2cread(0x20, 1, &hwId) || hwId != 0x81) {
+    return false;
+  }
+  if(!i2cread(0x21, 1, &hwVersion) || (hwVersion & 0xF0) != 0x10) {
+    return false;
+  }
+  if(!i2cread(0x00, 1, &status) || status != 0x10) {
+    return false;
+  }
+  if(!i2cread(0x24, 2, version)) {
+    return false;
+  }
+  appversion = (version[0] << 8) | version[1];
+  if(!i2cwrite(0xF4, 0, nullptr)) {
+    return false;
+  }
+  delayMicroseconds(1000);
+  if(!i2cread(0x00, 1, &status) || status != 0x90) {
+    return false;
+  }
+  return true;
+}
+
+bool CCS811::start(int mode) {
+  uint8_t measMode = mode << 4;
+  return i2cwrite(0x01, 1, &measMode);
+}
+
+void CCS811::read(uint16_t *eco2, uint16_t *etvoc, uint16_t *errstat, uint16_t *raw) {
+  uint8_t stat = 0;
+  uint8_t buf[8] = { 0 };
+  bool ok = i2cread(0x00, 1, &stat);
+  if(ok && stat == CCS811_ERRSTAT_OK) {
+    ok = i2cread(0x02, 8, buf);
+  } else {
+    buf[5] = 0;
+  }
+  buf[4] = stat;
+  if(eco2) *eco2 = ok?buf[0]*256+buf[1]:0;
+  if(etvoc) *etvoc = ok?buf[2]*256+buf[3]:0;
+  if(errstat) *errstat = (ok?0:CCS811_ERRSTAT_I2CFAIL) | (buf[5]*256+buf[4]);
+  if(raw) *raw = ok?buf[6]*256+buf[7]:0;
+}
+
+// Bits of errstat as binary number
+const char *CCS811::errstat_str(uint16_t errstat) {
+  static char s[17];
+  for(int i=0;i<16;i++) {
+    s[15-i] = errstat & (1 << i)?'1':'0';
+  }
+  s[16] = 0;
+  return s;
+}
@@ -0,0 +1,44 @@
+#ifndef CCS811_H
+#define CCS811_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// Subset of maarten-pennings CCS811 library, uses the global Wire
+#define CCS811_SLAVEADDR_0 0x5A
+#define CCS811_SLAVEADDR_1 0x5B
+
+#define CCS811_MODE_IDLE 0
+#define CCS811_MODE_1SEC 1
+#define CCS811_MODE_10SEC 2
+#define CCS811_MODE_60SEC 3
+
+#define CCS811_ERRSTAT_ERROR 0x0001
+#define CCS811_ERRSTAT_I2CFAIL 0x0002
+#define CCS811_ERRSTAT_DATA_READY 0x0008
+#define CCS811_ERRSTAT_APP_VALID 0x0010
+#define CCS811_ERRSTAT_FW_MODE 0x0080
+#define CCS811_ERRSTAT_OK (CCS811_ERRSTAT_DATA_READY | CCS811_ERRSTAT_APP_VALID | CCS811_ERRSTAT_FW_MODE)
+#define CCS811_ERRSTAT_OK_NODATA (CCS811_ERRSTAT_APP_VALID | CCS811_ERRSTAT_FW_MODE)
+
+class CCS811 {
+  protected:
+    int nwake;
+    int slaveaddr;
+    int i2cdelay_us = 0;
+    uint16_t appversion = 0;
+  public:
+    CCS811(int nwake = -1, int slaveaddr = CCS811_SLAVEADDR_0):nwake(nwake),slaveaddr(slaveaddr) {}
+    bool begin();
+    bool start(int mode);
+    void read(uint16_t *eco2, uint16_t *etvoc, uint16_t *errstat, uint16_t *raw);
+    const char *errstat_str(uint16_t errstat);
+    int application_version() { return appversion; }
+    void set_i2cdelay(int us) { i2cdelay_us = us; }
+    int get_i2cdelay() { return i2cdelay_us; }
+  protected:
+    bool i2cwrite(uint8_t regaddr, int count, const uint8_t *buf);
+    bool i2cread(uint8_t regaddr, int count, uint8_t *buf);
+};
+
+#endif //CCS811_H
@@ -0,0 +1,774 @@
+#include "Devices.h"
+#include "BoschEncoding.h"
+#include <string.h>
+
+// =================== BoschModel ===================
+
+static uint8_t oversampling(uint8_t osrs) {
+  return osrs?1 << (osrs > 5?4:osrs-1):0;
+}
+
+// Max measurement time (BME280 datasheet, ch9.1)
+uint32_t BoschModel::getConversionTime() const {
+  uint8_t t = oversampling((ctrlMeas >> 5) & 0x07);
+  uint8_t p = oversampling((ctrlMeas >> 2) & 0x07);
+  uint8_t h = hasHumidity?oversampling(ctrlHum & 0x07):0;
+  uint32_t us = 1250 + 2300*t + (p?2300*p+575:0) + (h?2300*h+575:0);
+  return us*conversionScale;
+}
+
+void BoschModel::latch() {
+  conversions++;
+  adcT = (ctrlMeas >> 5) & 0x07?boschEncodeTemperature(temperature):0x80000;
+  adcP = (ctrlMeas >> 2) & 0x07?boschEncodePressure(pressure):0x80000;
+  adcH = hasHumidity && (ctrlHum & 0x07)?boschEncodeHumidity(humidity):0x8000;
+}
+
+void BoschModel::update() {
+  if(converting && sim::now() >= conversionEnd) {
+    converting = false;
+    latch();
+    // forced mode returns to sleep
+    ctrlMeas &= ~0x03;
+  }
+  if((ctrlMeas & 0x03) == 0x03 && sim::now() >= normalStart + getConversionTime()) {
+    latch();
+  }
+}
+
+uint8_t BoschModel::readRegister(uint8_t reg) {
+  update();
+  switch(reg) {
+    case 0xD0:
+      return chipId;
+    case 0xF2:
+      return ctrlHum;
+    case 0xF3:
+      return converting?0x08:0;
+    case 0xF4:
+      return ctrlMeas;
+    case 0xF5:
+      return config;
+    case 0xF7:
+      return adcP >> 12;
+    case 0xF8:
+      return adcP >> 4;
+    case 0xF9:
+      return (adcP & 0x0F) << 4;
+    case 0xFA:
+      return adcT >> 12;
+    case 0xFB:
+      return adcT >> 4;
+    case 0xFC:
+      return (adcT & 0x0F) << 4;
+    case 0xFD:
+      return hasHumidity?adcH >> 8:0;
+    case 0xFE:
+      return hasHumidity?adcH:0;
+    default:
+      return 0;
+  }
+}
+
+void BoschModel::writeRegister(uint8_t reg, uint8_t value) {
+  update();
+  switch(reg) {
+    case 0xE0:
+      if(value == 0xB6) {
+        ctrlHum = ctrlMeas = config = 0;
+        converting = false;
+        adcT = adcP = 0x80000;
+        adcH = 0x8000;
+      }
+      break;
+    case 0xF2:
+      ctrlHum = value;
+      break;
+    case 0xF4:
+      ctrlMeas = value;
+      if((value & 0x03) == 0x01 || (value & 0x03) == 0x02) {
+        converting = true;
+        conversionEnd = sim::now() + getConversionTime();
+      } else if((value & 0x03) == 0x03) {
+        normalStart = sim::now();
+      }
+      break;
+    case 0xF5:
+      config = value;
+      break;
+  }
+}
+
+// =================== SHT3x, SHTC3, SHT4x ===================
+
+bool SHT3xModel::execute(uint16_t command, const uint16_t *, uint8_t) {
+  switch(command) {
+    case 0x2400:
+    case 0x240B:
+    case 0x2416:
+    case 0x2C06:
+    case 0x2C0D:
+    case 0x2C10:
+      respond({ toTicks(temperature, -45, 175), toTicks(humidity, 0, 100) }, measureTime);
+      return true;
+    case 0x30A2:
+      busy(1500);
+      return true;
+    case 0xF32D:
+      respond({ 0x0000 }, commandTime);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool SHTC3Model::execute(uint16_t command, const uint16_t *, uint8_t) {
+  if(sleeping) {
+    if(command != 0x3517) {
+      return false;
+    }
+    sleeping = false;
+    busy(240);
+    return true;
+  }
+  switch(command) {
+    case 0x3517:
+      return true;
+    case 0xB098:
+      sleeping = true;
+      return true;
+    case 0x7866:
+    case 0x7CA2:
+      respond({ toTicks(temperature, -45, 175), toTicks(humidity, 0, 100) }, measureTime);
+      return true;
+    case 0x58E0:
+    case 0x5C24:
+      respond({ toTicks(humidity, 0, 100), toTicks(temperature, -45, 175) }, measureTime);
+      return true;
+    case 0xEFC8:
+      respond({ 0x0807 }, commandTime);
+      return true;
+    case 0x805D:
+      busy(240);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool SHT4xModel::execute(uint16_t command, const uint16_t *, uint8_t argc) {
+  if(argc) {
+    return false;
+  }
+  std::vector<uint16_t> values = { toTicks(temperature, -45, 175), toTicks(humidity, -6, 125) };
+  switch(command) {
+    case 0xFD:
+      respond(values, highPrecisionTime);
+      return true;
+    case 0xF6:
+      respond(values, mediumPrecisionTime);
+      return true;
+    case 0xE0:
+      respond(values, lowestPrecisionTime);
+      return true;
+    case 0x89:
+      respond({ (uint16_t)(serial >> 16), (uint16_t)serial }, commandTime);
+      return true;
+    case 0x94:
+      busy(1000);
+      return true;
+    default:
+      return false;
+  }
+}
+
+// =================== Si702x, HTU21D ===================
+
+static uint8_t crc8Init0(const uint8_t *data, uint8_t len) {
+  uint8_t crc = 0;
+  for(uint8_t i=0;i<len;i++) {
+    crc ^= data[i];
+    for(uint8_t b=0;b<8;b++) {
+      crc = crc & 0x80?(crc << 1) ^ 0x31:crc << 1;
+    }
+  }
+  return crc;
+}
+
+void SiHTUModel::result(uint16_t raw, uint32_t time) {
+  uint8_t bytes[2] = { (uint8_t)(raw >> 8), (uint8_t)raw };
+  response = { bytes[0], bytes[1], crc8Init0(bytes, 2) };
+  readyAt = sim::now() + time;
+}
+
+void SiHTUModel::bytesWithCrc(const uint8_t *bytes, uint8_t count, uint8_t crcEvery) {
+  response.clear();
+  for(uint8_t i=0;i<count;i+=crcEvery) {
+    for(uint8_t j=0;j<crcEvery;j++) {
+      response.push_back(bytes[i+j]);
+    }
+    response.push_back(crc8Init0(bytes+i, crcEvery));
+  }
+  readyAt = sim::now();
+}
+
+bool SiHTUModel::receive(const uint8_t *data, size_t len) {
+  response.clear();
+  lastCommand = data[0];
+  uint16_t two = len > 1?(data[0] << 8) | data[1]:0;
+  switch(data[0]) {
+    case 0xE3:
+    case 0xF3:
+      result(toTicks(temperature, -46.85, 175.72, 65536) & 0xFFFC, tempTime);
+      return true;
+    case 0xE5:
+    case 0xF5:
+      // status bit 1 marks humidity result
+      result((toTicks(humidity, -6, 125, 65536) & 0xFFFC) | 0x02, humTime);
+      return true;
+    case 0xFE:
+      readyAt = sim::now() + 15000;
+      return true;
+    case 0xE7:
+      response = { userRegister };
+      readyAt = sim::now();
+      return true;
+    case 0xE6:
+      if(len > 1) {
+        userRegister = data[1];
+      }
+      return true;
+  }
+  switch(two) {
+    case 0xFA0F: {
+      static const uint8_t id1[4] = { 0x12, 0x34, 0x56, 0x78 };
+      bytesWithCrc(id1, 4, 1);
+      return true;
+    }
+    case 0xFCC9:
+      bytesWithCrc(getId2(), 4, 2);
+      return true;
+    case 0x84B8:
+      response = { 0x20 };
+      readyAt = sim::now();
+      return true;
+  }
+  return false;
+}
+
+size_t SiHTUModel::transmit(uint8_t *data, size_t len) {
+  if(response.empty() || sim::now() < readyAt) {
+    return 0;
+  }
+  if(takeCorruptCrc()) {
+    response.back() ^= 0x5A;
+  }
+  size_t n = len < response.size()?len:response.size();
+  memcpy(data, response.data(), n);
+  response.clear();
+  return n;
+}
+
+const uint8_t *Si7021Model::getId2() const {
+  static uint8_t id2[4];
+  id2[0] = deviceId;
+  id2[1] = 0xFF;
+  id2[2] = 0x9A;
+  id2[3] = 0xBC;
+  return id2;
+}
+
+const uint8_t *HTU21DModel::getId2() const {
+  static const uint8_t id2[4] = { 0x32, 0x0C, 0x48, 0x54 };
+  return id2;
+}
+
+// =================== BH1750 ===================
+
+uint32_t BH1750Model::getConversionTime() const {
+  return mode == 0x13 || mode == 0x23?lowResTime:highResTime;
+}
+
+void BH1750Model::update() {
+  if(!mode || sim::now() < conversionStart + getConversionTime()) {
+    return;
+  }
+  float value = lux*1.2*(mode == 0x11 || mode == 0x21?2:1);
+  data = value > 65535?65535:(uint16_t)lroundf(value);
+  if(mode >= 0x20) {
+    // one time mode powers down after the measurement
+    mode = 0;
+    powered = false;
+  }
+}
+
+bool BH1750Model::receive(const uint8_t *bytes, size_t len) {
+  for(size_t i=0;i<len;i++) {
+    uint8_t v = bytes[i];
+    switch(v) {
+      case 0x00:
+        powered = false;
+        mode = 0;
+        break;
+      case 0x01:
+        powered = true;
+        break;
+      case 0x07:
+        data = 0;
+        break;
+      case 0x10:
+      case 0x11:
+      case 0x13:
+      case 0x20:
+      case 0x21:
+      case 0x23:
+        powered = true;
+        mode = v;
+        conversionStart = sim::now();
+        break;
+      default:
+        // measurement time register
+        if((v & 0xF8) != 0x40 && (v & 0xE0) != 0x60) {
+          return false;
+        }
+    }
+  }
+  return true;
+}
+
+size_t BH1750Model::transmit(uint8_t *bytes, size_t len) {
+  update();
+  uint8_t value[2] = { (uint8_t)(data >> 8), (uint8_t)data };
+  size_t n = len < 2?len:2;
+  memcpy(bytes, value, n);
+  return n;
+}
+
+// =================== CCS811 ===================
+
+uint32_t CCS811Model::getSamplePeriod() const {
+  switch(driveMode) {
+    case 1:
+      return 1000000;
+    case 2:
+      return 10000000;
+    case 3:
+      return 60000000;
+    case 4:
+      return 250000;
+    default:
+      return 0;
+  }
+}
+
+uint64_t CCS811Model::currentSample() const {
+  uint32_t period = getSamplePeriod();
+  return appMode && period?(sim::now() - modeStart) / period:0;
+}
+
+uint8_t CCS811Model::status() const {
+  return (appMode?0x80:0) | 0x10 | (currentSample() > consumedSample?0x08:0) | (errorId?0x01:0);
+}
+
+bool CCS811Model::receive(const uint8_t *data, size_t len) {
+  mailbox = data[0];
+  switch(mailbox) {
+    case 0xFF:
+      if(len == 5 && data[1] == 0x11 && data[2] == 0xE5 && data[3] == 0x72 && data[4] == 0x8A) {
+        appMode = false;
+        driveMode = 0;
+      }
+      break;
+    case 0xF4:
+      appMode = true;
+      break;
+    case 0x01:
+      if(len > 1) {
+        if(!appMode) {
+          return false;
+        }
+        driveMode = (data[1] >> 4) & 0x07;
+        modeStart = sim::now();
+        consumedSample = 0;
+      }
+      break;
+  }
+  return true;
+}
+
+size_t CCS811Model::transmit(uint8_t *data, size_t len) {
+  uint8_t buff[8] = { 0 };
+  switch(mailbox) {
+    case 0x00:
+      buff[0] = status();
+      break;
+    case 0x01:
+      buff[0] = driveMode << 4;
+      break;
+    case 0x02:
+      buff[0] = eco2 >> 8;
+      buff[1] = eco2;
+      buff[2] = etvoc >> 8;
+      buff[3] = etvoc;
+      buff[4] = status();
+      buff[5] = errorId;
+      buff[6] = raw >> 8;
+      buff[7] = raw;
+      consumedSample = currentSample();
+      break;
+    case 0x03:
+      buff[0] = raw >> 8;
+      buff[1] = raw;
+      break;
+    case 0x20:
+      buff[0] = 0x81;
+      break;
+    case 0x21:
+      buff[0] = 0x12;
+      break;
+    case 0x23:
+      buff[0] = 0x10;
+      break;
+    case 0x24:
+      buff[0] = 0x20;
+      break;
+    case 0xE0:
+      buff[0] = errorId;
+      break;
+  }
+  size_t n = len < sizeof(buff)?len:sizeof(buff);
+  memcpy(data, buff, n);
+  return n;
+}
+
+// =================== SCD30 ===================
+
+static void floatWords(float value, std::vector<uint16_t> &words) {
+  uint32_t bits;
+  memcpy(&bits, &value, 4);
+  words.push_back(bits >> 16);
+  words.push_back(bits);
+}
+
+uint64_t SCD30Model::currentSample() const {
+  return measuring && interval?(sim::now() - measureStart) / (interval*1000000ULL):0;
+}
+
+bool SCD30Model::execute(uint16_t command, const uint16_t *args, uint8_t argc) {
+  switch(command) {
+    case 0x0010:
+      measuring = true;
+      measureStart = sim::now();
+      consumedSample = 0;
+      return true;
+    case 0x0104:
+      measuring = false;
+      return true;
+    case 0x4600:
+      if(argc) {
+        interval = args[0];
+        measureStart = sim::now();
+        consumedSample = 0;
+      } else {
+        respond({ interval }, commandTime);
+      }
+      return true;
+    case 0x0202:
+      respond({ (uint16_t)(currentSample() > consumedSample?1:0) }, commandTime);
+      return true;
+    case 0x0300: {
+      std::vector<uint16_t> words;
+      floatWords(co2, words);
+      floatWords(temperature, words);
+      floatWords(humidity, words);
+      consumedSample = currentSample();
+      respond(words, commandTime);
+      return true;
+    }
+    case 0xD100:
+      respond({ 0x0342 }, commandTime);
+      return true;
+    case 0xD304:
+      measuring = false;
+      busy(2000);
+      return true;
+    case 0x5306:
+    case 0x5204:
+    case 0x5403:
+    case 0x5102:
+      if(!argc) {
+        respond({ 0 }, commandTime);
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+// =================== SCD41 ===================
+
+uint64_t SCD41Model::currentSample() const {
+  uint32_t interval = mode == LowPower?lowPowerInterval:periodicInterval;
+  return mode == Idle?0:(sim::now() - modeStart) / interval;
+}
+
+bool SCD41Model::dataReady() const {
+  return mode == Idle?singleShotData && !isBusy():currentSample() > consumedSample;
+}
+
+void SCD41Model::powerCycle() {
+  mode = Idle;
+  singleShotData = false;
+  busyUntil = 0;
+  response.clear();
+}
+
+bool SCD41Model::execute(uint16_t command, const uint16_t *, uint8_t argc) {
+  switch(command) {
+    case 0x3F86:
+      mode = Idle;
+      singleShotData = false;
+      busy(stopTime);
+      return true;
+    case 0xEC05:
+      if(dataReady()) {
+        respond({ co2, toTicks(temperature, -45, 175, 65536), toTicks(humidity, 0, 100, 65536) }, commandTime);
+        if(mode == Idle) {
+          singleShotData = false;
+        } else {
+          consumedSample = currentSample();
+        }
+      }
+      return true;
+    case 0xE4B8:
+      respond({ (uint16_t)(dataReady()?0x8006:0x8000) }, commandTime);
+      return true;
+    case 0xE000:
+      return argc == 1;
+  }
+  if(mode != Idle) {
+    return false;
+  }
+  switch(command) {
+    case 0x21B1:
+    case 0x21AC:
+      mode = command == 0x21B1?Periodic:LowPower;
+      modeStart = sim::now();
+      consumedSample = 0;
+      singleShotData = false;
+      return true;
+    case 0x219D:
+      singleShots++;
+      singleShotData = true;
+      busy(singleShotTime);
+      return true;
+    case 0x2196:
+      singleShotData = true;
+      busy(50000);
+      return true;
+    case 0x3682:
+      respond({ 0xBE7F, 0x3F8B, 0x3B07 }, commandTime);
+      return true;
+    case 0x36F6:
+    case 0x36E0:
+      return true;
+    case 0x3646:
+      busy(20000);
+      return true;
+    default:
+      return false;
+  }
+}
+
+// =================== SEN54 ===================
+
+uint64_t SEN54Model::currentSample() const {
+  return measuring?(sim::now() - measureStart) / samplePeriod:0;
+}
+
+bool SEN54Model::execute(uint16_t command, const uint16_t *args, uint8_t argc) {
+  switch(command) {
+    case 0xD304:
+      measuring = false;
+      busy(100000);
+      return true;
+    case 0x0021:
+    case 0x0037:
+      if(measuring) {
+        return false;
+      }
+      measuring = true;
+      measureStart = sim::now();
+      consumedSample = 0;
+      busy(50000);
+      return true;
+    case 0x0104:
+      measuring = false;
+      busy(160000);
+      return true;
+    case 0x0202:
+      respond({ (uint16_t)(currentSample() > consumedSample?1:0) }, 20000);
+      return true;
+    case 0x03C4:
+      respond({ (uint16_t)lroundf(pm1p0*10), (uint16_t)lroundf(pm2p5*10), (uint16_t)lroundf(pm4p0*10), (uint16_t)lroundf(pm10p0*10),
+        (uint16_t)(int16_t)lroundf(humidity*100), (uint16_t)(int16_t)lroundf(temperature*200), (uint16_t)(int16_t)lroundf(vocIndex*10), 0x7FFF }, 20000);
+      consumedSample = currentSample();
+      return true;
+    case 0x6181:
+      if(argc == 4) {
+        if(measuring) {
+          return false;
+        }
+        memcpy(vocState, args, sizeof(vocState));
+        busy(20000);
+      } else {
+        respond({ vocState[0], vocState[1], vocState[2], vocState[3] }, 20000);
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+// =================== SGP40, SGP41 ===================
+
+static const std::vector<uint16_t> SgpSerial = { 0x0000, 0x0123, 0x4567 };
+
+bool SGP40Model::execute(uint16_t command, const uint16_t *args, uint8_t argc) {
+  switch(command) {
+    case 0x260F:
+      if(argc != 2) {
+        return false;
+      }
+      lastHumTicks = args[0];
+      lastTempTicks = args[1];
+      respond({ vocRaw }, measureTime);
+      return true;
+    case 0x280E:
+      respond({ selfTestResult }, 320000);
+      return true;
+    case 0x3682:
+      respond(SgpSerial, commandTime);
+      return true;
+    case 0x3615:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool SGP41Model::execute(uint16_t command, const uint16_t *args, uint8_t argc) {
+  switch(command) {
+    case 0x2612:
+      if(argc != 2) {
+        return false;
+      }
+      conditionings++;
+      heaterOn = true;
+      respond({ vocRaw }, measureTime);
+      return true;
+    case 0x2619:
+      if(argc != 2) {
+        return false;
+      }
+      lastHumTicks = args[0];
+      lastTempTicks = args[1];
+      heaterOn = true;
+      respond({ vocRaw, noxRaw }, measureTime);
+      return true;
+    case 0x280E:
+      respond({ selfTestResult }, 320000);
+      return true;
+    case 0x3615:
+      heaterOn = false;
+      busy(1000);
+      return true;
+    case 0x3682:
+      respond(SgpSerial, commandTime);
+      return true;
+    default:
+      return false;
+  }
+}
+
+// =================== DS18B20 ===================
+
+DS18B20Model::DS18B20Model(uint64_t serial) {
+  rom[0] = 0x28;
+  for(uint8_t i=1;i<7;i++) {
+    rom[i] = serial >> ((i-1)*8);
+  }
+  rom[7] = OneWire::crc8(rom, 7);
+  // power on values: 85C, alarms, 12 bit resolution
+  static const uint8_t defaults[8] = { 0x50, 0x05, 0x4B, 0x46, 0x7F, 0xFF, 0x0C, 0x10 };
+  memcpy(scratchpad, defaults, 8);
+  sealScratchpad();
+}
+
+void DS18B20Model::sealScratchpad() {
+  scratchpad[8] = OneWire::crc8(scratchpad, 8);
+}
+
+void DS18B20Model::update() {
+  if(!converting || sim::now() < conversionEnd) {
+    return;
+  }
+  converting = false;
+  // undefined low bits of lower resolutions are zero
+  int16_t raw = (int16_t)lroundf(temperature*16) & ~((1 << (12 - getResolution())) - 1);
+  scratchpad[0] = raw;
+  scratchpad[1] = raw >> 8;
+  sealScratchpad();
+}
+
+void DS18B20Model::write(uint8_t data) {
+  update();
+  switch(function) {
+    case None:
+      switch(data) {
+        case 0x44:
+          conversions++;
+          converting = true;
+          conversionEnd = sim::now() + (conversionTime >> (12 - getResolution()));
+          break;
+        case 0xBE:
+          function = ReadScratchpad;
+          index = 0;
+          break;
+        case 0x4E:
+          function = WriteScratchpad;
+          index = 0;
+          break;
+      }
+      break;
+    case WriteScratchpad:
+      if(index < 2) {
+        scratchpad[2 + index] = data;
+      } else if(index == 2) {
+        scratchpad[4] = (data & 0x60) | 0x1F;
+        function = None;
+      }
+      index++;
+      sealScratchpad();
+      break;
+    case ReadScratchpad:
+      break;
+  }
+}
+
+uint8_t DS18B20Model::read() {
+  if(function != ReadScratchpad || index > 8) {
+    return 0xFF;
+  }
+  uint8_t v = scratchpad[index++];
+  if(index == 9 && corruptCrc) {
+    corruptCrc--;
+    v ^= 0x5A;
+  }
+  return v;
+}
+
+bool DS18B20Model::readBit() {
+  update();
+  return !converting;
+}
@@ -0,0 +1,316 @@
+#ifndef DEVICES_H
+#define DEVICES_H
+
+#include "I2CDevice.h"
+#include <OneWire.h>
+
+// Models of supported devices. Timings are in us and default to datasheet maximums,
+// tests change them to simulate slower or faster parts. Values are physical units
+
+// BME280 and BMP280 registers, forced and normal mode. Data registers use the simplified encoding of the fake Adafruit libraries,
+// calibration registers read as zero. Before the first conversion data read as skipped (0x80000), which the libraries return as NAN
+class BoschModel : public RegisterDevice {
+  protected:
+    uint8_t chipId;
+    bool hasHumidity;
+    uint8_t ctrlHum = 0;
+    uint8_t ctrlMeas = 0;
+    uint8_t config = 0;
+    uint64_t conversionEnd = 0;
+    bool converting = false;
+    uint64_t normalStart = 0;
+    uint32_t adcT = 0x80000;
+    uint32_t adcP = 0x80000;
+    uint16_t adcH = 0x8000;
+  public:
+    float temperature = 22.5;
+    float pressure = 101325;
+    float humidity = 45;
+    // Multiplies conversion time computed from oversampling by the datasheet formula
+    float conversionScale = 1;
+    uint32_t conversions = 0;
+  public:
+    BoschModel(uint8_t address, uint8_t chipId, bool hasHumidity):RegisterDevice(address),chipId(chipId),hasHumidity(hasHumidity) {}
+    uint32_t getConversionTime() const;
+  protected:
+    virtual uint8_t readRegister(uint8_t reg) override;
+    virtual void writeRegister(uint8_t reg, uint8_t value) override;
+    void update();
+    void latch();
+};
+
+class BME280Model : public BoschModel {
+  public:
+    BME280Model(uint8_t address = 0x76):BoschModel(address, 0x60, true) {}
+};
+
+class BMP280Model : public BoschModel {
+  public:
+    BMP280Model(uint8_t address = 0x76):BoschModel(address, 0x58, false) {}
+};
+
+// SHT3x single shot measurement without clock stretching
+class SHT3xModel : public SensirionDevice {
+  public:
+    float temperature = 22.5;
+    float humidity = 45;
+    uint32_t measureTime = 15000;
+  public:
+    SHT3xModel(uint8_t address = 0x44):SensirionDevice(address) {}
+  protected:
+    virtual bool execute(uint16_t command, const uint16_t *args, uint8_t argc) override;
+};
+
+// SHTC3 responds only to wake up command when sleeping
+class SHTC3Model : public SensirionDevice {
+  protected:
+    bool sleeping = false;
+  public:
+    float temperature = 22.5;
+    float humidity = 45;
+    uint32_t measureTime = 12100;
+  public:
+    SHTC3Model():SensirionDevice(0x70) {}
+  protected:
+    virtual bool execute(uint16_t command, const uint16_t *args, uint8_t argc) override;
+};
+
+// SHT4x with single byte commands
+class SHT4xModel : public SensirionDevice {
+  public:
+    float temperature = 22.5;
+    float humidity = 45;
+    uint32_t serial = 0x12345678;
+    uint32_t highPrecisionTime = 8300;
+    uint32_t mediumPrecisionTime = 4500;
+    uint32_t lowestPrecisionTime = 1600;
+  public:
+    SHT4xModel(uint8_t address = 0x44):SensirionDevice(address, 1) {}
+  protected:
+    virtual bool execute(uint16_t command, const uint16_t *args, uint8_t argc) override;
+};
+
+// Si702x and HTU21D: single byte commands, hold and no hold measurements, results with CRC-8 initialized by 0.
+// Device doesn't acknowledge read until the conversion is done
+class SiHTUModel : public I2CDevice {
+  protected:
+    std::vector<uint8_t> response;
+    uint64_t readyAt = 0;
+    uint8_t userRegister;
+    uint8_t lastCommand = 0;
+  public:
+    float temperature = 22.5;
+    float humidity = 45;
+    uint32_t tempTime;
+    uint32_t humTime;
+  public:
+    virtual bool receive(const uint8_t *data, size_t len) override;
+    virtual size_t transmit(uint8_t *data, size_t len) override;
+  protected:
+    SiHTUModel(uint8_t userRegister, uint32_t tempTime, uint32_t humTime):I2CDevice(0x40),userRegister(userRegister),tempTime(tempTime),humTime(humTime) {}
+    void result(uint16_t raw, uint32_t time);
+    void bytesWithCrc(const uint8_t *bytes, uint8_t count, uint8_t crcEvery);
+    // Second part of the electronic serial number, SNB_3 is the device ID
+    virtual const uint8_t *getId2() const = 0;
+};
+
+class Si7021Model : public SiHTUModel {
+  public:
+    // SNB_3 of the serial number: 0x15 Si7021, 0x14 Si7020, 0x0D Si7013
+    uint8_t deviceId = 0x15;
+  public:
+    Si7021Model():SiHTUModel(0x3A, 10800, 12000) {}
+  protected:
+    virtual const uint8_t *getId2() const override;
+};
+
+class HTU21DModel : public SiHTUModel {
+  public:
+    HTU21DModel():SiHTUModel(0x02, 50000, 16000) {}
+  protected:
+    virtual const uint8_t *getId2() const override;
+};
+
+// BH1750 continuous and one time modes, data register is updated after each conversion
+class BH1750Model : public I2CDevice {
+  protected:
+    uint8_t mode = 0;
+    bool powered = false;
+    uint64_t conversionStart = 0;
+    uint16_t data = 0;
+  public:
+    float lux = 250;
+    uint32_t highResTime = 180000;
+    uint32_t lowResTime = 24000;
+  public:
+    BH1750Model(uint8_t address = 0x23):I2CDevice(address) {}
+    virtual bool receive(const uint8_t *data, size_t len) override;
+    virtual size_t transmit(uint8_t *data, size_t len) override;
+  protected:
+    uint32_t getConversionTime() const;
+    void update();
+};
+
+// CCS811 mailboxes, boot and application mode, drive modes with periodic samples
+class CCS811Model : public I2CDevice {
+  protected:
+    uint8_t mailbox = 0;
+    bool appMode = false;
+    uint8_t driveMode = 0;
+    uint64_t modeStart = 0;
+    uint64_t consumedSample = 0;
+  public:
+    uint16_t eco2 = 600;
+    uint16_t etvoc = 30;
+    uint16_t raw = 0x1234;
+    // ERROR_ID register, non zero sets error bit of status
+    uint8_t errorId = 0;
+  public:
+    CCS811Model():I2CDevice(0x5A) {}
+    virtual bool receive(const uint8_t *data, size_t len) override;
+    virtual size_t transmit(uint8_t *data, size_t len) override;
+    uint32_t getSamplePeriod() const;
+  protected:
+    uint64_t currentSample() const;
+    uint8_t status() const;
+};
+
+// SCD30 continuous measurement with configurable interval, values as big endian floats
+class SCD30Model : public SensirionDevice {
+  protected:
+    bool measuring = false;
+    uint64_t measureStart = 0;
+    uint64_t consumedSample = 0;
+  public:
+    float co2 = 650;
+    float temperature = 22.5;
+    float humidity = 45;
+    uint16_t interval = 2;
+  public:
+    SCD30Model():SensirionDevice(0x61) {}
+  protected:
+    virtual bool execute(uint16_t command, const uint16_t *args, uint8_t argc) override;
+    uint64_t currentSample() const;
+};
+
+// SCD4x idle, periodic, low power periodic and single shot modes.
+// In periodic modes only reading, data ready and stop commands are accepted
+class SCD41Model : public SensirionDevice {
+  public:
+    enum Mode { Idle, Periodic, LowPower };
+  protected:
+    Mode mode = Idle;
+    uint64_t modeStart = 0;
+    uint64_t consumedSample = 0;
+    bool singleShotData = false;
+  public:
+    uint16_t co2 = 700;
+    float temperature = 22.5;
+    float humidity = 45;
+    uint32_t periodicInterval = 5000000;
+    uint32_t lowPowerInterval = 30000000;
+    uint32_t singleShotTime = 5000000;
+    uint32_t stopTime = 500000;
+    uint32_t singleShots = 0;
+  public:
+    SCD41Model():SensirionDevice(0x62) {}
+    Mode getMode() const { return mode; }
+    // Power loss, device returns to idle
+    void powerCycle();
+  protected:
+    virtual bool execute(uint16_t command, const uint16_t *args, uint8_t argc) override;
+    bool dataReady() const;
+    uint64_t currentSample() const;
+};
+
+// SEN54 measurement with 1s sampling, VOC algorithm state can be written only in idle mode
+class SEN54Model : public SensirionDevice {
+  protected:
+    bool measuring = false;
+    uint64_t measureStart = 0;
+    uint64_t consumedSample = 0;
+  public:
+    float pm1p0 = 3.1;
+    float pm2p5 = 5.2;
+    float pm4p0 = 6.3;
+    float pm10p0 = 7.4;
+    float humidity = 45;
+    float temperature = 22.5;
+    float vocIndex = 100;
+    uint16_t vocState[4] = { 0x0102, 0x0304, 0x0506, 0x0708 };
+    uint32_t samplePeriod = 1000000;
+  public:
+    SEN54Model():SensirionDevice(0x69) {}
+    bool isMeasuring() const { return measuring; }
+    void powerCycle() { measuring = false; }
+  protected:
+    virtual bool execute(uint16_t command, const uint16_t *args, uint8_t argc) override;
+    uint64_t currentSample() const;
+};
+
+// SGP40 raw VOC measurement, doesn't acknowledge SGP41 commands
+class SGP40Model : public SensirionDevice {
+  public:
+    uint16_t vocRaw = 30000;
+    uint16_t selfTestResult = 0xD400;
+    uint32_t measureTime = 30000;
+    // compensation received with the last measurement
+    uint16_t lastHumTicks = 0;
+    uint16_t lastTempTicks = 0;
+  public:
+    SGP40Model():SensirionDevice(0x59) {}
+  protected:
+    virtual bool execute(uint16_t command, const uint16_t *args, uint8_t argc) override;
+};
+
+// SGP41 conditioning and raw VOC and NOx measurement
+class SGP41Model : public SensirionDevice {
+  public:
+    uint16_t vocRaw = 30000;
+    uint16_t noxRaw = 16000;
+    uint16_t selfTestResult = 0xD400;
+    uint32_t measureTime = 50000;
+    bool heaterOn = false;
+    uint32_t conditionings = 0;
+    // compensation received with the last measurement
+    uint16_t lastHumTicks = 0;
+    uint16_t lastTempTicks = 0;
+  public:
+    SGP41Model():SensirionDevice(0x59) {}
+  protected:
+    virtual bool execute(uint16_t command, const uint16_t *args, uint8_t argc) override;
+};
+
+// DS18B20 probe: scratchpad, resolution and conversion time by resolution. Temperature reads 85C until the first conversion
+class DS18B20Model : public OneWireTarget {
+  protected:
+    uint8_t rom[8];
+    uint8_t scratchpad[9];
+    enum { None, ReadScratchpad, WriteScratchpad } function = None;
+    uint8_t index = 0;
+    uint64_t conversionEnd = 0;
+    bool converting = false;
+  public:
+    float temperature = 21.5;
+    bool connected = true;
+    // Number of following scratchpad reads with corrupted CRC
+    uint32_t corruptCrc = 0;
+    // Conversion time of 12 bit resolution, lower resolutions take half for each bit less
+    uint32_t conversionTime = 750000;
+    uint32_t conversions = 0;
+  public:
+    // Serial is the unique part of ROM code
+    DS18B20Model(uint64_t serial);
+    virtual const uint8_t *getRom() const override { return rom; }
+    virtual bool present() override { return connected; }
+    virtual void reset() override { function = None; }
+    virtual void write(uint8_t data) override;
+    virtual uint8_t read() override;
+    virtual bool readBit() override;
+    uint8_t getResolution() const { return 9 + ((scratchpad[4] >> 5) & 0x03); }
+  protected:
+    void update();
+    void sealScratchpad();
+};
+
+#endif //DEVICES_H
@@ -0,0 +1,100 @@
+#include "I2CDevice.h"
+
+bool I2CDevice::acknowledge() {
+  transactions++;
+  if(!connected) {
+    return false;
+  }
+  if(failTransactions) {
+    failTransactions--;
+    return false;
+  }
+  return true;
+}
+
+bool I2CDevice::takeCorruptCrc() {
+  if(corruptCrc) {
+    corruptCrc--;
+    return true;
+  }
+  return false;
+}
+
+bool RegisterDevice::receive(const uint8_t *data, size_t len) {
+  pointer = data[0];
+  for(size_t i=1;i<len;i++) {
+    writeRegister(pointer++, data[i]);
+  }
+  return true;
+}
+
+size_t RegisterDevice::transmit(uint8_t *data, size_t len) {
+  for(size_t i=0;i<len;i++) {
+    data[i] = readRegister(pointer++);
+  }
+  return len;
+}
+
+uint8_t SensirionDevice::crc(uint16_t word) {
+  uint8_t crc = 0xFF;
+  uint8_t bytes[2] = { (uint8_t)(word >> 8), (uint8_t)word };
+  for(uint8_t i=0;i<2;i++) {
+    crc ^= bytes[i];
+    for(uint8_t b=0;b<8;b++) {
+      crc = crc & 0x80?(crc << 1) ^ 0x31:crc << 1;
+    }
+  }
+  return crc;
+}
+
+bool SensirionDevice::acknowledge() {
+  if(!I2CDevice::acknowledge()) {
+    return false;
+  }
+  return !isBusy();
+}
+
+bool SensirionDevice::receive(const uint8_t *data, size_t len) {
+  if(len < commandBytes || (len - commandBytes) % 3) {
+    return false;
+  }
+  uint16_t command = commandBytes == 2?(data[0] << 8) | data[1]:data[0];
+  uint16_t args[16];
+  uint8_t argc = 0;
+  for(size_t i=commandBytes;i<len && argc<16;i+=3) {
+    uint16_t word = (data[i] << 8) | data[i+1];
+    if(crc(word) != data[i+2]) {
+      return false;
+    }
+    args[argc++] = word;
+  }
+  // a new command discards unread response
+  response.clear();
+  return execute(command, args, argc);
+}
+
+size_t SensirionDevice::transmit(uint8_t *data, size_t len) {
+  if(response.empty()) {
+    return 0;
+  }
+  bool corrupt = takeCorruptCrc();
+  size_t n = 0;
+  for(uint16_t word : response) {
+    uint8_t bytes[3] = { (uint8_t)(word >> 8), (uint8_t)word, (uint8_t)(crc(word) ^ (corrupt?0x5A:0)) };
+    for(uint8_t i=0;i<3 && n<len;i++) {
+      data[n++] = bytes[i];
+    }
+  }
+  response.clear();
+  return n;
+}
+
+void SensirionDevice::respond(const std::vector<uint16_t> &words, uint32_t executionTime) {
+  response = words;
+  busyUntil = sim::now() + executionTime;
+}
+
+uint16_t toTicks(float value, float offset, float scale, uint32_t fullScale) {
+  float ticks = roundf((value - offset) * fullScale / scale);
+  return ticks < 0?0:ticks > 65535?65535:(uint16_t)ticks;
+}
@@ -0,0 +1,72 @@
+#ifndef I2C_DEVICE_H
+#define I2C_DEVICE_H
+
+#include <Wire.h>
+#include <vector>
+#include "Sim.h"
+
+// Base of I2C device models with fault injection.
+// Models keep physical values in public fields, tests change them between reads
+class I2CDevice : public I2CTarget {
+  protected:
+    uint8_t address;
+  public:
+    // Device answers its address, false simulates unplugged device
+    bool connected = true;
+    // Number of following transactions not acknowledged, simulates bus errors
+    uint32_t failTransactions = 0;
+    // Number of following reads with corrupted CRC
+    uint32_t corruptCrc = 0;
+    // Transactions addressed to the device, including not acknowledged ones
+    uint32_t transactions = 0;
+  public:
+    I2CDevice(uint8_t address):address(address) {}
+    virtual uint8_t getAddress() const override { return address; }
+    virtual bool acknowledge() override;
+  protected:
+    // Returns true once per read when CRC should be corrupted
+    bool takeCorruptCrc();
+};
+
+// Device with registers accessed through a register pointer, which auto increments (Bosch sensors, BH1750 has none)
+class RegisterDevice : public I2CDevice {
+  protected:
+    uint8_t pointer = 0;
+  public:
+    RegisterDevice(uint8_t address):I2CDevice(address) {}
+    virtual bool receive(const uint8_t *data, size_t len) override;
+    virtual size_t transmit(uint8_t *data, size_t len) override;
+  protected:
+    virtual uint8_t readRegister(uint8_t reg) = 0;
+    virtual void writeRegister(uint8_t reg, uint8_t value) = 0;
+};
+
+// Sensirion command interface: 16 bit (or 8 bit) command, arguments and responses as words followed by CRC-8.
+// Device doesn't acknowledge anything while it executes a command, response can be read once it's done
+class SensirionDevice : public I2CDevice {
+  protected:
+    uint8_t commandBytes;
+    std::vector<uint16_t> response;
+    uint64_t busyUntil = 0;
+  public:
+    // Execution time of commands without own timing, us
+    uint32_t commandTime = 1000;
+  public:
+    SensirionDevice(uint8_t address, uint8_t commandBytes = 2):I2CDevice(address),commandBytes(commandBytes) {}
+    virtual bool acknowledge() override;
+    virtual bool receive(const uint8_t *data, size_t len) override;
+    virtual size_t transmit(uint8_t *data, size_t len) override;
+    static uint8_t crc(uint16_t word);
+  protected:
+    // Executes command, returns false if it's unknown or not allowed in the current state
+    virtual bool execute(uint16_t command, const uint16_t *args, uint8_t argc) = 0;
+    // Sets response readable after executionTime us
+    void respond(const std::vector<uint16_t> &words, uint32_t executionTime);
+    void busy(uint32_t executionTime) { respond({}, executionTime); }
+    bool isBusy() const { return sim::now() < busyUntil; }
+};
+
+// Encodes value as ticks of range [offset, offset+scale] in 16 bits, as Sensirion and Si702x chips do
+uint16_t toTicks(float value, float offset, float scale, uint32_t fullScale = 65535);
+
+#endif //I2C_DEVICE_H
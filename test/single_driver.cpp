@@ -0,0 +1,54 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+#include <SensorDiscovery.h>
+
+// Library built with SENSORS_SELECT_DRIVERS and a single driver. It links without the other drivers,
+// reads its device and discovery doesn't create sensors of the drivers left out
+
+#if defined(SENSORS_INCLUDE_SHT4X)
+typedef SHT4XSensor SelectedSensor;
+typedef SHT4xModel SelectedModel;
+static const SensorType SelectedType = SensorTypeSHT4X;
+static const SensorType OtherType = SensorTypeBME280;
+#elif defined(SENSORS_INCLUDE_BME280)
+struct SelectedSensor : BME280Sensor {
+  SelectedSensor():BME280Sensor(0) {}
+};
+typedef BME280Model SelectedModel;
+static const SensorType SelectedType = SensorTypeBME280;
+static const SensorType OtherType = SensorTypeSHT4X;
+#endif
+
+TEST(onlySelectedDriver) {
+  int drivers = 0;
+#ifdef SENSORS_INCLUDE_SHT4X
+  drivers++;
+#endif
+#ifdef SENSORS_INCLUDE_BME280
+  drivers++;
+#endif
+#ifdef SENSORS_INCLUDE_SCD41
+  drivers++;
+#endif
+#ifdef SENSORS_INCLUDE_ONEWIRE
+  drivers++;
+#endif
+  CHECK_EQ(drivers, 1);
+  Sensor *other = SensorDiscovery::createSensor(OtherType, 0x44);
+  CHECK(!other);
+}
+
+TEST(selectedDriverReads) {
+  SelectedModel model;
+  Wire.attach(model);
+  SelectedSensor s;
+  CHECK(s.init());
+  sim::advance(1000 - sim::now() % 1000);
+  Sensor *sensors[] = { &s };
+  CHECK_EQ(Sensor::readAll(sensors, 1), 1);
+  CHECK_NEAR(s.temp, 22.5, 0.01);
+  Sensor *created = SensorDiscovery::createSensor(SelectedType, 0x44);
+  CHECK(created);
+  delete created;
+}
@@ -0,0 +1,74 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+#include <FieldAggregator.h>
+#include <InfluxDbClient.h>
+
+// Window aggregates of sensor fields, kept per sensor so sensors with the same field keys don't mix
+
+TEST(statsPerSensor) {
+  BME280Model bme;
+  SHT4xModel sht;
+  Wire.attach(bme);
+  Wire.attach(sht);
+  BME280Sensor s1(0);
+  SHT4XSensor s2;
+  CHECK(s1.begin());
+  CHECK(s2.begin());
+  FieldAggregator aggregator(10000);
+  float bmeTemps[] = { 20, 21, 22 };
+  for(float t : bmeTemps) {
+    bme.temperature = t;
+    sht.temperature = t + 10;
+    CHECK(s1.read());
+    CHECK(s2.read());
+    aggregator.add(s1);
+    aggregator.add(s2);
+  }
+  const FieldStats *t1 = aggregator.getStats(&s1, "temp");
+  const FieldStats *t2 = aggregator.getStats(&s2, "temp");
+  CHECK(t1 && t2 && t1 != t2);
+  CHECK_EQ(t1->count, 3u);
+  CHECK_NEAR(t1->min, 20, 0.01);
+  CHECK_NEAR(t1->max, 22, 0.01);
+  CHECK_NEAR(t1->mean, 21, 0.01);
+  CHECK_EQ(t2->count, 3u);
+  CHECK_NEAR(t2->mean, 31, 0.01);
+  CHECK(aggregator.getStats(&s1, "press"));
+  CHECK(!aggregator.getStats(&s2, "press"));
+  CHECK(!aggregator.getStats(&s1, "co2"));
+  CHECK(!aggregator.isOverflow());
+
+  Point p1("env"), p2("env");
+  p1.addTag("sensor", s1.getName());
+  p2.addTag("sensor", s2.getName());
+  aggregator.storeValues(s1, p1);
+  aggregator.storeValues(s2, p2);
+  String line1 = p1.toLineProtocol();
+  String line2 = p2.toLineProtocol();
+  CHECK(strstr(line1.c_str(), "temp_count=3i,temp_min=20.00,temp_max=22.00,temp_mean=21.00,temp_stddev=1.00"));
+  CHECK(strstr(line1.c_str(), "press_mean="));
+  CHECK(strstr(line2.c_str(), "temp_count=3i,temp_min=30.00,temp_max=32.00,temp_mean=31.00,temp_stddev=1.00"));
+  CHECK(!strstr(line2.c_str(), "press"));
+}
+
+TEST(windowAndFailedReads) {
+  SHT4xModel sht;
+  Wire.attach(sht);
+  SHT4XSensor s;
+  CHECK(s.begin());
+  FieldAggregator aggregator(1000);
+  CHECK(!aggregator.isWindowComplete());
+  CHECK(s.read());
+  aggregator.add(s);
+  sht.connected = false;
+  CHECK(!s.read());
+  aggregator.add(s);
+  CHECK_EQ(aggregator.getSamplesCount(), 1u);
+  CHECK(!aggregator.isWindowComplete());
+  sim::advance(1000000);
+  CHECK(aggregator.isWindowComplete());
+  aggregator.reset();
+  CHECK_EQ(aggregator.getSamplesCount(), 0u);
+  CHECK(!aggregator.getStats(&s, "temp"));
+}
@@ -0,0 +1,59 @@
+#include "TestUtil.h"
+#include <Sensors.h>
+
+// Oversampling of AnalogSensor in foreground reads and in background sampling by update()
+
+static const uint8_t Pin = 34;
+
+TEST(foregroundOversampling) {
+  uint16_t v = 1000;
+  sim::setAnalogSource(Pin, [&v](uint64_t) { return v += 10; });
+  AnalogSensor s("Analog", "light", Pin, CapLightIntensity);
+  s.setOversampling(4, 5);
+  CHECK(s.begin());
+  Sensor *sensors[] = { &s };
+  CHECK_EQ(Sensor::readAll(sensors, 1), 1);
+  CHECK_EQ(s.rawValue, 1025);
+  auto &reads = sim::getAnalogReads(Pin);
+  CHECK_EQ(reads.size(), 4u);
+  for(size_t i=1;i<reads.size();i++) {
+    CHECK(reads[i] - reads[i-1] >= 5000);
+  }
+}
+
+TEST(backgroundSamplesKeepInterval) {
+  sim::setAnalog(Pin, 2048);
+  AnalogSensor s("Analog", "light", Pin, CapLightIntensity);
+  s.setOversampling(3, 10);
+  s.setBackgroundSampling(true);
+  CHECK(s.begin());
+  CHECK(!s.read());
+  CHECK_EQ(s.getErrorCode(), ErrorNoData);
+  // loop() calling update() as fast as it can over several batches
+  for(int i=0;i<5000;i++) {
+    s.update();
+    sim::advance(100);
+  }
+  CHECK(s.read());
+  CHECK_EQ(s.rawValue, 2048);
+  auto &reads = sim::getAnalogReads(Pin);
+  CHECK(reads.size() >= 40);
+  // including the first sample of each following batch
+  for(size_t i=1;i<reads.size();i++) {
+    CHECK(reads[i] - reads[i-1] >= 10000);
+  }
+}
+
+TEST(setFieldByKeyContent) {
+  AnalogSensor s("Analog", "light", Pin, CapLightIntensity);
+  // keys decoded from a buffer aren't the pointers written by the sensor
+  char key[16];
+  strcpy(key, "light");
+  CHECK(s.setField(key, 1.5));
+  CHECK_NEAR(s.value, 1.5, 0.001);
+  strcpy(key, "light_raw");
+  CHECK(s.setField(key, 512));
+  CHECK_EQ(s.rawValue, 512);
+  strcpy(key, "lights");
+  CHECK(!s.setField(key, 1));
+}
@@ -0,0 +1,121 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+#include <SensorDiscovery.h>
+#include <BusAcquisition.h>
+#include <thread>
+
+// Sensors on the second bus, parallel reads of buses and health callbacks of bus threads
+
+static std::thread::id callbackThread;
+static uint8_t callbacks = 0;
+static SensorHealth lastPrevious, lastHealth;
+
+static void onHealth(Sensor &sensor, SensorHealth previous) {
+  callbackThread = std::this_thread::get_id();
+  callbacks++;
+  lastPrevious = previous;
+  lastHealth = sensor.getHealth();
+}
+
+TEST(sensorsOnSecondBus) {
+  SHT4xModel sht1, sht2;
+  BME280Model bme;
+  Wire.attach(sht1);
+  Wire1.attach(sht2);
+  Wire1.attach(bme);
+  sht2.temperature = 30;
+  SHT4XSensor s1, s2(Wire1);
+  BME280Sensor s3(0, BME280_ADDRESS_ALTERNATE, Wire1);
+  CHECK(s1.getBus() == &Wire);
+  CHECK(s2.getBus() == &Wire1);
+  CHECK(s1.begin());
+  CHECK(s2.begin());
+  CHECK(s3.begin());
+  CHECK(s1.read());
+  CHECK(s2.read());
+  CHECK(s3.read());
+  CHECK_NEAR(s1.temp, 22.5, 0.01);
+  CHECK_NEAR(s2.temp, 30, 0.01);
+  // a device missing on the second bus isn't found on the first one
+  sht2.connected = false;
+  CHECK(!s2.read());
+  CHECK(s1.read());
+}
+
+TEST(discoveryOnSecondBus) {
+  SHT4xModel sht;
+  SCD41Model scd;
+  Wire1.attach(sht);
+  Wire1.attach(scd);
+  SensorDiscovery first, second(Wire1);
+  CHECK_EQ(first.scan(), 0);
+  CHECK_EQ(second.scan(), 2);
+  Sensor *sensors[2];
+  CHECK_EQ(second.createSensors(sensors, 2), 2);
+  for(Sensor *s : sensors) {
+    CHECK(s->getBus() == &Wire1);
+    CHECK(s->begin());
+    delete s;
+  }
+}
+
+TEST(benchmarkSpeedup) {
+  // SGP40 measurement blocks the reading task for 30 ms
+  SGP40Model sgp1, sgp2;
+  SHT4xModel sht1, sht2;
+  Wire.attach(sgp1);
+  Wire.attach(sht1);
+  Wire1.attach(sgp2);
+  Wire1.attach(sht2);
+  SGP40Sensor s1(1, Wire), s2(1, Wire1);
+  SHT4XSensor s3(Wire), s4(Wire1);
+  Sensor *sensors[] = { &s1, &s2, &s3, &s4 };
+  // models keep their timing in the current clock, which restarts in real time mode. Every test starts in simulated time
+  sim::setRealTime(true);
+  for(Sensor *s : sensors) {
+    CHECK(s->begin());
+  }
+  const uint8_t cycles = 5;
+  uint8_t ok = 0, okByBus = 0;
+  double sequential = measureUs([&]() {
+    for(uint8_t i=0;i<cycles;i++) {
+      ok += Sensor::readAll(sensors, 4);
+    }
+  });
+  double parallel = measureUs([&]() {
+    for(uint8_t i=0;i<cycles;i++) {
+      okByBus += readAllByBus(sensors, 4);
+    }
+  });
+  CHECK_EQ(ok, 4*cycles);
+  CHECK_EQ(okByBus, 4*cycles);
+  // wall clock times depend on the load of the host, so the speedup is only reported
+  printf("  readAll %.1f ms, readAllByBus %.1f ms per cycle, speedup %.2fx\n", sequential/cycles/1000, parallel/cycles/1000, sequential/parallel);
+}
+
+TEST(healthCallbackOnCallingThread) {
+  SHT4xModel sht1, sht2;
+  Wire.attach(sht1);
+  Wire1.attach(sht2);
+  SHT4XSensor s1(Wire), s2(Wire1);
+  sim::setRealTime(true);
+  CHECK(s1.begin());
+  CHECK(s2.begin());
+  Sensor *sensors[] = { &s1, &s2 };
+  setSensorHealthCallback(onHealth);
+  sht2.connected = false;
+  CHECK_EQ(readAllByBus(sensors, 2), 1);
+  CHECK_EQ(callbacks, 1);
+  CHECK(callbackThread == std::this_thread::get_id());
+  CHECK_EQ(lastPrevious, HealthOk);
+  CHECK_EQ(lastHealth, HealthDegraded);
+  for(uint8_t i=1;i<SENSOR_QUARANTINE_FAILURES;i++) {
+    CHECK_EQ(readAllByBus(sensors, 2), 1);
+  }
+  CHECK_EQ(callbacks, 2);
+  CHECK(callbackThread == std::this_thread::get_id());
+  CHECK_EQ(lastPrevious, HealthDegraded);
+  CHECK_EQ(lastHealth, HealthQuarantined);
+  setSensorHealthCallback(nullptr);
+}
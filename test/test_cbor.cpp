@@ -0,0 +1,301 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+#include <SensorsCbor.h>
+#include <vector>
+
+// CBOR cycles decode into the same line protocol as written directly, overflow, long keys and invalid data handling
+
+static const char *const Names[] = { "BME280", "SHT4X", "SEN54", "probe" };
+
+TEST(roundTrip) {
+  BME280Model bme;
+  SHT4xModel sht;
+  Wire.attach(bme);
+  Wire.attach(sht);
+  BME280Sensor s1(0);
+  SHT4XSensor s2;
+  CHECK(s1.init());
+  CHECK(s2.init());
+  Sensor *sensors[] = { &s1, &s2 };
+  uint8_t buff[256];
+  CborWriter cbor(buff, sizeof(buff));
+  char expected[512], decoded[512];
+  LineProtocolWriter direct(expected, sizeof(expected));
+  float temps[] = { 21.37, -3.5, 0.004 };
+  for(uint8_t c=0;c<3;c++) {
+    bme.temperature = temps[c];
+    sht.temperature = temps[c] + 1.111;
+    CHECK(s1.readValues());
+    CHECK(s2.readValues());
+    uint64_t timestamp = 1700000000000ULL + c*1000;
+    cbor.beginCycle(timestamp);
+    for(uint8_t i=0;i<2;i++) {
+      cbor.writeSensor(i, *sensors[i]);
+      direct.beginLine("env");
+      direct.addTag("sensor", Names[i]);
+      sensors[i]->writeFields(direct);
+      direct.endLine(timestamp);
+    }
+    cbor.endCycle();
+  }
+  CHECK(!cbor.isOverflow());
+  LineProtocolWriter lp(decoded, sizeof(decoded));
+  CHECK_EQ(cborToLineProtocol(buff, cbor.length(), "env", Names, 2, lp), 3);
+  CHECK_EQ(String(decoded), String(expected));
+}
+
+TEST(integersAndTextKeys) {
+  uint8_t buff[128];
+  CborWriter cbor(buff, sizeof(buff));
+  cbor.beginCycle();
+  cbor.beginSensor(7);
+  cbor.addField(Co2, (int32_t)1234);
+  cbor.addField("count", (int32_t)-5);
+  cbor.addField("max", (int32_t)INT32_MAX);
+  cbor.addField("min", (int32_t)INT32_MIN);
+  cbor.endSensor();
+  cbor.endCycle();
+  char decoded[128];
+  LineProtocolWriter lp(decoded, sizeof(decoded));
+  CHECK_EQ(cborToLineProtocol(buff, cbor.length(), "m", Names, 2, lp), 1);
+  CHECK_EQ(String(decoded), String("m,sensor=7 co2=1234i,count=-5i,max=2147483647i,min=-2147483648i"));
+}
+
+static float randomValue(float min, float max) {
+  return min + (max - min) * (rand() / (float)RAND_MAX);
+}
+
+// Writes the same random fields to both writers
+static void writeRandomSensor(uint8_t sensor, FieldSink &a, FieldSink &b) {
+  switch(sensor) {
+    case 0: {
+      float values[] = { randomValue(-40, 85), randomValue(0, 100), randomValue(300, 1100) };
+      const char *keys[] = { Temp, Hum, Press };
+      for(uint8_t i=0;i<3;i++) {
+        a.addField(keys[i], values[i]);
+        b.addField(keys[i], values[i]);
+      }
+      break;
+    }
+    case 1: {
+      int32_t co2 = rand() % 40000;
+      a.addField(Co2, co2);
+      b.addField(Co2, co2);
+      break;
+    }
+    case 2: {
+      const char *keys[] = { Voc, "pm1.0", "pm2.5", "pm4.0", "pm10.0" };
+      for(const char *key : keys) {
+        float value = randomValue(0, 1000);
+        a.addField(key, value);
+        b.addField(key, value);
+      }
+      break;
+    }
+    default: {
+      // keys outside the schema are written as text
+      float value = randomValue(-1000, 1000);
+      a.addField("temp_1", value);
+      b.addField("temp_1", value);
+    }
+  }
+}
+
+TEST(randomCyclesDecodeIdentically) {
+  static uint8_t buff[4096];
+  static char expected[16384], decoded[16384];
+  srand(1);
+  size_t cborBytes = 0, lineBytes = 0;
+  int cycles = 0;
+  for(int batch=0;batch<100;batch++) {
+    CborWriter cbor(buff, sizeof(buff));
+    LineProtocolWriter direct(expected, sizeof(expected));
+    for(int c=0;c<20;c++) {
+      uint64_t timestamp = 1700000000000ULL + cycles++*1000;
+      cbor.beginCycle(timestamp);
+      for(uint8_t s=0;s<4;s++) {
+        cbor.beginSensor(s);
+        direct.beginLine("env");
+        direct.addTag("sensor", Names[s]);
+        writeRandomSensor(s, cbor, direct);
+        cbor.endSensor();
+        direct.endLine(timestamp);
+      }
+      cbor.endCycle();
+    }
+    CHECK(!cbor.isOverflow());
+    CHECK(!direct.isOverflow());
+    LineProtocolWriter lp(decoded, sizeof(decoded));
+    CHECK_EQ(cborToLineProtocol(buff, cbor.length(), "env", Names, 4, lp), 20);
+    CHECK_EQ(String(decoded), String(expected));
+    cborBytes += cbor.length();
+    lineBytes += direct.length();
+  }
+  CHECK(cborBytes * 2 < lineBytes);
+  printf("  %d cycles, line protocol %u B, CBOR %u B\n", cycles, (unsigned)lineBytes, (unsigned)cborBytes);
+}
+
+TEST(halfFloats) {
+  const float exact[] = { 0, 1, -2.5, 20.5, 65504, 0.00006103515625f };
+  for(float v : exact) {
+    CHECK_EQ(halfToFloat(floatToHalf(v)), v);
+  }
+  CHECK_EQ(floatToHalf(1), 0x3C00);
+  CHECK_EQ(floatToHalf(-2), 0xC000);
+  CHECK_EQ(floatToHalf(100000), 0x7C00);
+  CHECK(isnan(halfToFloat(floatToHalf(NAN))));
+  // rounds to nearest even
+  CHECK_EQ(floatToHalf(2049), floatToHalf(2048));
+  CHECK_EQ(floatToHalf(2051), floatToHalf(2052));
+}
+
+TEST(overflowIsPerCycle) {
+  uint8_t buff[24];
+  CborWriter cbor(buff, sizeof(buff));
+  cbor.beginCycle(1);
+  cbor.beginSensor(0);
+  cbor.addField(Temp, 20.5f);
+  cbor.endSensor();
+  cbor.endCycle();
+  size_t first = cbor.length();
+  CHECK(first > 0);
+  cbor.beginCycle(2);
+  cbor.beginSensor(0);
+  cbor.addField("a_long_text_key", 1.234f);
+  cbor.endSensor();
+  cbor.endCycle();
+  CHECK(cbor.isOverflow());
+  CHECK_EQ(cbor.getDroppedCycles(), 1u);
+  CHECK_EQ(cbor.length(), first);
+  // the next cycle fits again
+  cbor.beginCycle(3);
+  CHECK(!cbor.isOverflow());
+  cbor.beginSensor(0);
+  cbor.addField(Temp, 21.5f);
+  cbor.endSensor();
+  cbor.endCycle();
+  CHECK(!cbor.isOverflow());
+  CHECK(cbor.length() > first);
+  char decoded[128];
+  LineProtocolWriter lp(decoded, sizeof(decoded));
+  CHECK_EQ(cborToLineProtocol(buff, cbor.length(), "m", Names, 2, lp), 2);
+  CHECK_EQ(String(decoded), String("m,sensor=BME280 temp=20.50 1\nm,sensor=BME280 temp=21.50 3"));
+  cbor.clear();
+  CHECK_EQ(cbor.length(), 0u);
+  CHECK_EQ(cbor.getDroppedCycles(), 1u);
+}
+
+TEST(sensorsWithoutValuesSkipped) {
+  uint8_t buff[64], reference[64];
+  CborWriter cbor(buff, sizeof(buff));
+  cbor.beginCycle(5);
+  cbor.beginSensor(0);
+  cbor.addField(Temp, NAN);
+  cbor.addField(Hum, NAN);
+  cbor.endSensor();
+  cbor.beginSensor(1);
+  cbor.addField(Temp, 20.5f);
+  cbor.endSensor();
+  cbor.endCycle();
+  CborWriter only(reference, sizeof(reference));
+  only.beginCycle(5);
+  only.beginSensor(1);
+  only.addField(Temp, 20.5f);
+  only.endSensor();
+  only.endCycle();
+  CHECK_EQ(cbor.length(), only.length());
+  CHECK(!memcmp(buff, reference, only.length()));
+  // map with only NAN values from another encoder doesn't produce a line
+  const uint8_t data[] = { 0x82, 0x05, 0xBF, 0x00, 0xBF, 0x01, 0xF9, 0x7E, 0x00, 0xFF, 0x01, 0xBF, 0x01, 0xF9, 0x4D, 0x20, 0xFF, 0xFF };
+  char decoded[128];
+  LineProtocolWriter lp(decoded, sizeof(decoded));
+  CHECK_EQ(cborToLineProtocol(data, sizeof(data), "m", Names, 2, lp), 1);
+  CHECK_EQ(String(decoded), String("m,sensor=SHT4X temp=20.50 5"));
+}
+
+TEST(malformedData) {
+  char decoded[128];
+  LineProtocolWriter lp(decoded, sizeof(decoded));
+  // not an array of timestamp and sensors
+  const uint8_t notCycle[] = { 0xA1, 0x00, 0x00 };
+  CHECK_EQ(cborToLineProtocol(notCycle, sizeof(notCycle), "m", Names, 2, lp), -1);
+  // indefinite map without break
+  const uint8_t unterminated[] = { 0x82, 0x00, 0xBF, 0x00, 0xBF, 0x01, 0xF9, 0x4D, 0x20 };
+  CHECK_EQ(cborToLineProtocol(unterminated, sizeof(unterminated), "m", Names, 2, lp), -1);
+  // unknown sensor id is written as number
+  const uint8_t unknown[] = { 0x82, 0x05, 0xA1, 0x09, 0xA1, 0x01, 0xF9, 0x4D, 0x20 };
+  lp.clear();
+  CHECK_EQ(cborToLineProtocol(unknown, sizeof(unknown), "m", Names, 2, lp), 1);
+  CHECK_EQ(String(decoded), String("m,sensor=9 temp=20.50 5"));
+}
+
+TEST(invalidData) {
+  char decoded[128];
+  // unsigned value above INT32_MAX
+  const uint8_t big[] = { 0x82, 0x00, 0xBF, 0x00, 0xBF, 0x05, 0x1A, 0x80, 0x00, 0x00, 0x00, 0xFF, 0xFF };
+  LineProtocolWriter lp(decoded, sizeof(decoded));
+  CHECK_EQ(cborToLineProtocol(big, sizeof(big), "m", Names, 2, lp), -1);
+  CHECK_EQ(lp.length(), 0u);
+  // negative value below INT32_MIN
+  const uint8_t small[] = { 0x82, 0x00, 0xBF, 0x00, 0xBF, 0x05, 0x3A, 0x80, 0x00, 0x00, 0x00, 0xFF, 0xFF };
+  CHECK_EQ(cborToLineProtocol(small, sizeof(small), "m", Names, 2, lp), -1);
+  CHECK_EQ(lp.length(), 0u);
+  // field id beyond 8 bits isn't truncated to a valid id
+  const uint8_t id[] = { 0x82, 0x00, 0xBF, 0x00, 0xBF, 0x19, 0x01, 0x01, 0x05, 0xFF, 0xFF };
+  CHECK_EQ(cborToLineProtocol(id, sizeof(id), "m", Names, 2, lp), -1);
+  CHECK_EQ(lp.length(), 0u);
+  // truncated map after a valid field leaves no partial line
+  const uint8_t truncated[] = { 0x82, 0x00, 0xBF, 0x00, 0xBF, 0x05, 0x18, 0x64, 0x01 };
+  CHECK_EQ(cborToLineProtocol(truncated, sizeof(truncated), "m", Names, 2, lp), -1);
+  CHECK_EQ(lp.length(), 0u);
+  // map head isn't a map
+  const uint8_t notMap[] = { 0x82, 0x00, 0xBF, 0x00, 0x05, 0xFF };
+  CHECK_EQ(cborToLineProtocol(notMap, sizeof(notMap), "m", Names, 2, lp), -1);
+  CHECK_EQ(lp.length(), 0u);
+}
+
+TEST(longKeysSkipped) {
+  uint8_t buff[128];
+  CborWriter cbor(buff, sizeof(buff));
+  char longKey[CBOR_MAX_KEY_LEN + 1];
+  memset(longKey, 'k', CBOR_MAX_KEY_LEN);
+  longKey[CBOR_MAX_KEY_LEN] = 0;
+  // longest key the decoder accepts
+  char maxKey[CBOR_MAX_KEY_LEN];
+  memset(maxKey, 'm', CBOR_MAX_KEY_LEN - 1);
+  maxKey[CBOR_MAX_KEY_LEN - 1] = 0;
+  cbor.beginCycle(7);
+  cbor.beginSensor(0);
+  cbor.addField(Temp, 20.5f);
+  cbor.addField(longKey, 1.0f);
+  cbor.addField(longKey, (int32_t)2);
+  cbor.addField(maxKey, (int32_t)3);
+  cbor.endSensor();
+  // sensor with only a skipped field is dropped
+  cbor.beginSensor(1);
+  cbor.addField(longKey, 4.0f);
+  cbor.endSensor();
+  cbor.endCycle();
+  CHECK(!cbor.isOverflow());
+  CHECK_EQ(cbor.getSkippedFields(), 3u);
+  char decoded[128];
+  LineProtocolWriter lp(decoded, sizeof(decoded));
+  CHECK_EQ(cborToLineProtocol(buff, cbor.length(), "m", Names, 2, lp), 1);
+  CHECK_EQ(String(decoded), String("m,sensor=BME280 temp=20.50,") + maxKey + "=3i 7");
+  cbor.clear();
+  CHECK_EQ(cbor.getSkippedFields(), 3u);
+}
+
+TEST(manyCyclesCounted) {
+  // more cycles than fit int16_t, each without sensors
+  const int32_t cycles = 40000;
+  std::vector<uint8_t> data;
+  for(int32_t i=0;i<cycles;i++) {
+    data.insert(data.end(), { 0x82, 0x00, 0xA0 });
+  }
+  char decoded[8];
+  LineProtocolWriter lp(decoded, sizeof(decoded));
+  CHECK_EQ(cborToLineProtocol(data.data(), data.size(), "m", Names, 2, lp), cycles);
+  CHECK_EQ(lp.length(), 0u);
+}
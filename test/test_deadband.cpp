@@ -0,0 +1,125 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+#include <DeadbandFilter.h>
+
+// Deadband suppression, heartbeat and percent deadbands
+
+// Writes temp and co2 fields set by the test
+class ValueSensor : public Sensor {
+  public:
+    float temp = 20;
+    int32_t co2 = 400;
+    bool ok = true;
+    ValueSensor():Sensor("value") {}
+    virtual bool init() override { status = true; return true; }
+    virtual bool readValues() override { status = ok; return status; }
+    virtual uint16_t getCapabilities() override { return 0; }
+    virtual void printValues(Print &) override {}
+    virtual void writeFields(FieldSink &sink) override {
+      sink.addField("temp", temp);
+      sink.addField("co2", co2);
+    }
+};
+
+// Collects passed field keys as "temp co2 "
+class KeysSink : public FieldSink {
+  public:
+    std::string keys;
+    virtual void addField(const char *key, float) override { keys += key; keys += ' '; }
+    virtual void addField(const char *key, int32_t) override { keys += key; keys += ' '; }
+};
+
+static std::string passed(DeadbandFilter &filter, Sensor &sensor) {
+  KeysSink sink;
+  filter.writeFields(sensor, sink);
+  return sink.keys;
+}
+
+TEST(firstReportAndSuppression) {
+  ValueSensor s;
+  CHECK(s.init());
+  DeadbandFilter filter(0, 0.5);
+  CHECK_EQ(passed(filter, s), std::string("temp co2 "));
+  CHECK_EQ(passed(filter, s), std::string(""));
+  s.temp = 20.4;
+  CHECK_EQ(passed(filter, s), std::string(""));
+  // compared to the last reported value, so a slow drift is reported
+  s.temp = 20.6;
+  CHECK_EQ(passed(filter, s), std::string("temp "));
+  s.co2 = 401;
+  CHECK_EQ(passed(filter, s), std::string("co2 "));
+  CHECK_EQ(filter.getEmittedCount(), 4u);
+  CHECK_EQ(filter.getSuppressedCount(), 6u);
+  filter.reset();
+  CHECK_EQ(passed(filter, s), std::string("temp co2 "));
+}
+
+TEST(rulesAndSensors) {
+  ValueSensor s1, s2;
+  CHECK(s1.init());
+  CHECK(s2.init());
+  DeadbandFilter filter(0);
+  CHECK(filter.setDeadband("co2", 50));
+  CHECK_EQ(passed(filter, s1), std::string("temp co2 "));
+  // fields of another sensor have their own last values
+  CHECK_EQ(passed(filter, s2), std::string("temp co2 "));
+  s1.co2 = 440;
+  s1.temp = 20.01;
+  CHECK_EQ(passed(filter, s1), std::string("temp "));
+  s1.co2 = 451;
+  CHECK_EQ(passed(filter, s1), std::string("co2 "));
+  CHECK_EQ(passed(filter, s2), std::string(""));
+  // failed sensor passes nothing
+  s2.temp = 30;
+  s2.ok = false;
+  CHECK(!s2.readValues());
+  CHECK_EQ(passed(filter, s2), std::string(""));
+}
+
+TEST(heartbeat) {
+  ValueSensor s;
+  CHECK(s.init());
+  DeadbandFilter filter(60000, 1);
+  CHECK_EQ(passed(filter, s), std::string("temp co2 "));
+  sim::advance(59000000);
+  CHECK_EQ(passed(filter, s), std::string(""));
+  s.temp = 25;
+  CHECK_EQ(passed(filter, s), std::string("temp "));
+  sim::advance(1000000);
+  CHECK_EQ(passed(filter, s), std::string("co2 "));
+  sim::advance(59000000);
+  CHECK_EQ(passed(filter, s), std::string("temp "));
+}
+
+TEST(percentDeadband) {
+  ValueSensor s;
+  CHECK(s.init());
+  DeadbandFilter filter(0, 5, true);
+  CHECK_EQ(passed(filter, s), std::string("temp co2 "));
+  s.co2 = 419;
+  s.temp = 21.1;
+  CHECK_EQ(passed(filter, s), std::string("temp "));
+  s.co2 = 421;
+  CHECK_EQ(passed(filter, s), std::string("co2 "));
+  // percent of zero is zero, so any change near zero is reported
+  s.temp = 0;
+  CHECK_EQ(passed(filter, s), std::string("temp "));
+  CHECK_EQ(passed(filter, s), std::string(""));
+  s.temp = 0.01;
+  CHECK_EQ(passed(filter, s), std::string("temp "));
+  s.temp = -0.01;
+  CHECK_EQ(passed(filter, s), std::string("temp "));
+}
+
+TEST(passesNanChange) {
+  ValueSensor s;
+  CHECK(s.init());
+  DeadbandFilter filter(0, 1);
+  CHECK_EQ(passed(filter, s), std::string("temp co2 "));
+  s.temp = NAN;
+  CHECK_EQ(passed(filter, s), std::string("temp "));
+  CHECK_EQ(passed(filter, s), std::string(""));
+  s.temp = 20;
+  CHECK_EQ(passed(filter, s), std::string("temp "));
+}
@@ -0,0 +1,244 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+
+// Every driver against its device model: init, values, two phase reading and injected faults
+
+TEST(bme280ForcedMeasurement) {
+  BME280Model model;
+  Wire.attach(model);
+  BME280Sensor s(0);
+  CHECK(s.init());
+  CHECK(s.readValues());
+  CHECK_NEAR(s.temp, 22.5, 0.01);
+  CHECK_NEAR(s.hum, 45, 0.01);
+  CHECK_NEAR(s.pressRaw, 1013.25, 0.01);
+  CHECK_NEAR(s.pressSeaLevel, 1013.25, 0.01);
+  model.temperature = -5.25;
+  Sensor *sensors[] = { &s };
+  CHECK_EQ(Sensor::readAll(sensors, 1), 1);
+  CHECK_NEAR(s.temp, -5.25, 0.01);
+  CHECK_EQ(model.conversions, 2u);
+}
+
+TEST(bme280SlowConversion) {
+  BME280Model model;
+  model.conversionScale = 4;
+  Wire.attach(model);
+  BME280Sensor s(0);
+  CHECK(s.init());
+  Sensor *sensors[] = { &s };
+  uint64_t start = sim::now();
+  CHECK_EQ(Sensor::readAll(sensors, 1), 1);
+  CHECK(sim::now() - start >= model.getConversionTime());
+  CHECK_NEAR(s.hum, 45, 0.01);
+}
+
+TEST(bme280Missing) {
+  BME280Sensor s(0);
+  CHECK(!s.init());
+  CHECK_EQ(s.getErrorCode(), ErrorInit);
+}
+
+TEST(bmp280NormalMode) {
+  BMP280Model model;
+  Wire.attach(model);
+  BMP280Sensor s(0);
+  CHECK(s.init());
+  CHECK(s.readValues());
+  CHECK_NEAR(s.temp, 22.5, 0.01);
+  CHECK_NEAR(s.pressRaw, 1013.25, 0.01);
+}
+
+TEST(sht31) {
+  SHT3xModel model;
+  Wire.attach(model);
+  SHT31Sensor s;
+  CHECK(s.init());
+  model.temperature = 30.1;
+  model.humidity = 61;
+  CHECK(s.readValues());
+  CHECK_NEAR(s.temp, 30.1, 0.01);
+  CHECK_NEAR(s.hum, 61, 0.01);
+  model.corruptCrc = 1;
+  CHECK(!s.readValues());
+  CHECK_EQ(s.getErrorCode(), ErrorRead);
+  CHECK(s.readValues());
+}
+
+TEST(shtc3) {
+  SHTC3Model model;
+  Wire.attach(model);
+  SHTC3Sensor s;
+  CHECK(s.init());
+  CHECK(s.readValues());
+  CHECK_NEAR(s.temp, 22.5, 0.01);
+  CHECK_NEAR(s.hum, 45, 0.01);
+}
+
+TEST(sht4x) {
+  SHT4xModel model;
+  Wire.attach(model);
+  SHT4XSensor s;
+  CHECK(s.init());
+  CHECK(s.readValues());
+  CHECK_NEAR(s.temp, 22.5, 0.01);
+  CHECK_NEAR(s.hum, 45, 0.01);
+  model.failTransactions = 1;
+  CHECK(!s.readValues());
+  CHECK(s.readValues());
+}
+
+TEST(si7021) {
+  Si7021Model model;
+  Wire.attach(model);
+  SI702xSensor s;
+  CHECK(s.init());
+  CHECK_EQ(s.getType(), String("Si7021"));
+  CHECK(s.readValues());
+  CHECK_NEAR(s.temp, 22.5, 0.01);
+  CHECK_NEAR(s.hum, 45, 0.01);
+}
+
+TEST(htu21d) {
+  HTU21DModel model;
+  Wire.attach(model);
+  HTU21DSensor s;
+  CHECK(s.init());
+  CHECK(s.readValues());
+  CHECK_NEAR(s.temp, 22.5, 0.01);
+  CHECK_NEAR(s.hum, 45, 0.01);
+}
+
+TEST(bh1750) {
+  BH1750Model model;
+  Wire.attach(model);
+  BH1750Sensor s;
+  CHECK(s.init());
+  sim::advance(model.highResTime);
+  CHECK(s.readValues());
+  CHECK_NEAR(s.lightIntensity, 250, 0.5);
+}
+
+TEST(ccs811) {
+  CCS811Model model;
+  Wire.attach(model);
+  CCS811Sensor s;
+  CHECK(s.init());
+  CHECK(!s.readValues());
+  CHECK_EQ(s.getErrorCode(), ErrorNoData);
+  sim::advance(model.getSamplePeriod());
+  CHECK(s.readValues());
+  CHECK_EQ(s.co2, 600);
+  CHECK_EQ(s.vocIndex, 30);
+  CHECK_EQ(s.vocRaw, 0x1234);
+  sim::advance(model.getSamplePeriod());
+  model.errorId = 0x04;
+  CHECK(!s.readValues());
+  CHECK_EQ(s.getErrorCode(), ErrorRead);
+}
+
+TEST(scd30) {
+  SCD30Model model;
+  Wire.attach(model);
+  SCD30Sensor s;
+  CHECK(s.init());
+  CHECK(!s.readValues());
+  sim::advance(model.interval*1000000ULL);
+  CHECK(s.readValues());
+  CHECK_EQ(s.co2, 650);
+  CHECK_NEAR(s.temp, 22.5, 0.01);
+  CHECK_NEAR(s.hum, 45, 0.01);
+}
+
+TEST(scd41Periodic) {
+  SCD41Model model;
+  Wire.attach(model);
+  SCD41Sensor s;
+  CHECK(s.init());
+  CHECK(model.getMode() == SCD41Model::Periodic);
+  sim::advance(model.periodicInterval);
+  CHECK(s.readValues());
+  CHECK_EQ(s.co2, 700);
+  CHECK_NEAR(s.temp, 22.5, 0.01);
+  CHECK_NEAR(s.hum, 45, 0.01);
+}
+
+TEST(sen54) {
+  SEN54Model model;
+  Wire.attach(model);
+  SEN54Sensor s;
+  CHECK(s.init());
+  CHECK(model.isMeasuring());
+  sim::advance(model.samplePeriod);
+  CHECK(s.readValues());
+  CHECK_NEAR(s.pm2p5, 5.2, 0.01);
+  CHECK_NEAR(s.pm10p0, 7.4, 0.01);
+  CHECK_NEAR(s.temp, 22.5, 0.01);
+  CHECK_NEAR(s.vocIndex, 100, 0.01);
+}
+
+TEST(sgp40) {
+  SGP40Model model;
+  Wire.attach(model);
+  SGP40Sensor s;
+  CHECK(s.init());
+  CHECK(s.readValues());
+  CHECK_EQ(s.vocRaw, 30000);
+  model.selfTestResult = 0x4B00;
+  SGP40Sensor failing;
+  CHECK(!failing.init());
+}
+
+TEST(sgp41) {
+  SGP41Model model;
+  Wire.attach(model);
+  SGP41Sensor s;
+  CHECK(s.init());
+  CHECK(s.readValues());
+  CHECK_EQ(model.conditionings, 1u);
+  CHECK_EQ(s.vocRaw, 30000);
+  sim::advance(10000000);
+  CHECK(s.readValues());
+  CHECK_EQ(s.noxRaw, 16000);
+  model.selfTestResult = 0x4B00;
+  SGP41Sensor failing;
+  CHECK(!failing.init());
+  CHECK_EQ(failing.getErrorCode(), ErrorSelfTest);
+}
+
+TEST(ds18b20) {
+  DS18B20Model probe1(2), probe2(3);
+  probe2.temperature = -10.125;
+  OneWire::attach(4, probe1);
+  OneWire::attach(4, probe2);
+  DS18B20Sensor s(4, 2);
+  CHECK(s.init());
+  CHECK_EQ(s.getProbesCount(), 2);
+  CHECK(s.readValues());
+  CHECK_NEAR(s.getProbeTemp(0), 21.5, 0.001);
+  CHECK_NEAR(s.getProbeTemp(1), -10.125, 0.001);
+  CHECK_EQ(probe1.conversions, 1u);
+}
+
+TEST(dht) {
+  sim::setDHT(5, 21, 40);
+  DHTSensor s(5);
+  CHECK(s.init());
+  CHECK(s.readValues());
+  CHECK_NEAR(s.temp, 21, 0.001);
+  CHECK_NEAR(s.hum, 40, 0.001);
+  sim::setDHT(5, NAN, NAN);
+  CHECK(!s.readValues());
+}
+
+TEST(unpluggedDevice) {
+  SHT4xModel model;
+  Wire.attach(model);
+  SHT4XSensor s;
+  CHECK(s.init());
+  model.connected = false;
+  CHECK(!s.readValues());
+  model.connected = true;
+  CHECK(s.readValues());
+}
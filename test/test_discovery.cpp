@@ -0,0 +1,264 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <SensorDiscovery.h>
+
+// Identification of devices sharing addresses, verification of the others and the saved topology
+
+// Stream over a byte vector, for saving and loading topology
+class MemoryStream : public Stream {
+  public:
+    std::vector<uint8_t> data;
+    size_t pos = 0;
+    virtual size_t write(uint8_t c) override { data.push_back(c); return 1; }
+    virtual int available() override { return data.size() - pos; }
+    virtual int read() override { return pos < data.size()?data[pos++]:-1; }
+    virtual int peek() override { return pos < data.size()?data[pos]:-1; }
+};
+
+// Unrelated device (like INA219 at 0x40): 16 bit registers, ignores unknown commands
+class OtherDevice : public RegisterDevice {
+  public:
+    // write transactions received
+    uint32_t writes = 0;
+  public:
+    OtherDevice(uint8_t address = 0x40):RegisterDevice(address) {}
+    virtual bool receive(const uint8_t *data, size_t len) override { writes++; return RegisterDevice::receive(data, len); }
+  protected:
+    virtual uint8_t readRegister(uint8_t reg) override { return 0x39 + reg; }
+    virtual void writeRegister(uint8_t, uint8_t) override {}
+};
+
+// Sensirion-like device answering the SHTC3 ID command with a foreign ID
+class WrongIdDevice : public SensirionDevice {
+  public:
+    WrongIdDevice():SensirionDevice(0x70) {}
+  protected:
+    virtual bool execute(uint16_t command, const uint16_t *, uint8_t) override {
+      if(command == 0xEFC8) {
+        respond({ 0x1234 }, commandTime);
+      }
+      return true;
+    }
+};
+
+// Device at 0x59 acknowledging any command without answering
+class SilentDevice : public SensirionDevice {
+  public:
+    SilentDevice():SensirionDevice(0x59) {}
+  protected:
+    virtual bool execute(uint16_t command, const uint16_t *, uint8_t) override { return command != 0x2612; }
+};
+
+static SensorType scanSingle() {
+  SensorDiscovery discovery;
+  if(discovery.scan() != 1) {
+    return SensorTypeNone;
+  }
+  return discovery.get(0).type;
+}
+
+TEST(wholeBus) {
+  BMP280Model bmp(0x76);
+  BME280Model bme(0x77);
+  SHT4xModel sht;
+  SHTC3Model shtc;
+  BH1750Model bh;
+  CCS811Model ccs;
+  SCD30Model scd30;
+  SCD41Model scd41;
+  SEN54Model sen;
+  SGP41Model sgp;
+  I2CDevice *devices[] = { &bmp, &bme, &sht, &shtc, &bh, &ccs, &scd30, &scd41, &sen, &sgp };
+  for(I2CDevice *d : devices) {
+    Wire.attach(*d);
+  }
+  SensorDiscovery discovery;
+  CHECK_EQ(discovery.scan(), 10);
+  Sensor *sensors[SENSOR_DISCOVERY_MAX];
+  uint8_t count = discovery.createSensors(sensors, SENSOR_DISCOVERY_MAX);
+  CHECK_EQ(count, 10);
+  // in order of addresses
+  const char *names[] = { "BH1750", "SHT4X", "SGP41", "CCS811", "SCD30", "SCD41", "SEN54", "SHTC3", "BMP280", "BME280" };
+  for(uint8_t i=0;i<count;i++) {
+    CHECK_EQ(sensors[i]->getName(), String(names[i]));
+    CHECK(sensors[i]->init());
+    delete sensors[i];
+  }
+  CHECK_EQ(discovery.get(9).address, 0x77);
+}
+
+TEST(emptyBus) {
+  SensorDiscovery discovery;
+  CHECK_EQ(discovery.scan(), 0);
+  Sensor *sensors[1];
+  CHECK_EQ(discovery.createSensors(sensors, 1), 0);
+}
+
+TEST(si7021At0x40) {
+  Si7021Model si;
+  Wire.attach(si);
+  CHECK_EQ(scanSingle(), SensorTypeSI702x);
+  si.deviceId = 0x0D;
+  CHECK_EQ(scanSingle(), SensorTypeSI702x);
+}
+
+TEST(htu21dAt0x40) {
+  HTU21DModel htu;
+  Wire.attach(htu);
+  CHECK_EQ(scanSingle(), SensorTypeHTU21D);
+}
+
+TEST(htu21dCorruptedMeasurement) {
+  HTU21DModel htu;
+  Wire.attach(htu);
+  // ID read and measurement
+  htu.corruptCrc = 2;
+  SensorDiscovery discovery;
+  CHECK_EQ(discovery.scan(), 0);
+}
+
+TEST(unknownDeviceAt0x40) {
+  OtherDevice other;
+  Wire.attach(other);
+  SensorDiscovery discovery;
+  CHECK_EQ(discovery.scan(), 0);
+}
+
+TEST(sht4xAndSht31At0x44) {
+  SHT4xModel sht4;
+  Wire.attach(sht4);
+  CHECK_EQ(scanSingle(), SensorTypeSHT4X);
+  Wire.detach(sht4);
+  SHT3xModel sht3;
+  Wire.attach(sht3);
+  CHECK_EQ(scanSingle(), SensorTypeSHT31);
+  // status register with corrupted CRC
+  sht3.corruptCrc = 1;
+  CHECK_EQ(scanSingle(), SensorTypeNone);
+}
+
+TEST(unknownDeviceAt0x44) {
+  OtherDevice other(0x44);
+  Wire.attach(other);
+  SensorDiscovery discovery;
+  CHECK_EQ(discovery.scan(), 0);
+}
+
+TEST(sensirionDevicesVerified) {
+  SCD30Model scd30;
+  SCD41Model scd41;
+  SEN54Model sen;
+  Wire.attach(scd30);
+  Wire.attach(scd41);
+  Wire.attach(sen);
+  SensorDiscovery discovery;
+  CHECK_EQ(discovery.scan(), 3);
+  // SCD41 answers in periodic mode too
+  SCD41Sensor s;
+  CHECK(s.init());
+  CHECK_EQ(scd41.getMode(), SCD41Model::Periodic);
+  CHECK_EQ(discovery.scan(), 3);
+  // other devices acknowledging these addresses
+  Wire.detach(scd30);
+  Wire.detach(scd41);
+  Wire.detach(sen);
+  OtherDevice other1(0x61), other2(0x62), other3(0x69);
+  Wire.attach(other1);
+  Wire.attach(other2);
+  Wire.attach(other3);
+  CHECK_EQ(discovery.scan(), 0);
+}
+
+TEST(sgp40AndSgp41At0x59) {
+  SGP40Model sgp40;
+  Wire.attach(sgp40);
+  CHECK_EQ(scanSingle(), SensorTypeSGP40);
+  Wire.detach(sgp40);
+  SGP41Model sgp41;
+  Wire.attach(sgp41);
+  CHECK_EQ(scanSingle(), SensorTypeSGP41);
+  // probing left the heater off and the sensor initializes right away
+  SGP41Sensor s;
+  CHECK(s.init());
+}
+
+TEST(unknownDeviceAt0x59) {
+  SilentDevice silent;
+  Wire.attach(silent);
+  CHECK_EQ(scanSingle(), SensorTypeNone);
+  Wire.detach(silent);
+  SGP40Model sgp40;
+  Wire.attach(sgp40);
+  sgp40.corruptCrc = 1;
+  CHECK_EQ(scanSingle(), SensorTypeNone);
+  Wire.detach(sgp40);
+  // device acknowledging the SGP41 conditioning gets only the serial number command
+  OtherDevice other(0x59);
+  Wire.attach(other);
+  CHECK_EQ(scanSingle(), SensorTypeNone);
+  CHECK_EQ(other.writes, 1u);
+}
+
+TEST(shtc3At0x70) {
+  SHTC3Model shtc;
+  Wire.attach(shtc);
+  CHECK_EQ(scanSingle(), SensorTypeSHTC3);
+  // the driver leaves it sleeping
+  SHTC3Sensor s;
+  CHECK(s.begin());
+  CHECK(s.read());
+  CHECK_EQ(scanSingle(), SensorTypeSHTC3);
+  shtc.corruptCrc = 1;
+  CHECK_EQ(scanSingle(), SensorTypeNone);
+}
+
+TEST(unknownDeviceAt0x70) {
+  // multiplexer or LED driver returning data without a command isn't written to
+  OtherDevice other(0x70);
+  Wire.attach(other);
+  CHECK_EQ(scanSingle(), SensorTypeNone);
+  Wire.detach(other);
+  WrongIdDevice wrongId;
+  Wire.attach(wrongId);
+  CHECK_EQ(scanSingle(), SensorTypeNone);
+  CHECK(wrongId.transactions > 0);
+}
+
+TEST(saveAndLoad) {
+  SensorDiscovery saved;
+  CHECK(saved.add(SensorTypeBME280, 0x77));
+  CHECK(saved.add(SensorTypeSCD41, 0x62));
+  CHECK(saved.add(SensorTypeSHT4X, 0x44));
+  CHECK(!saved.add(SensorTypeNone, 0x10));
+  MemoryStream stream;
+  CHECK_EQ(saved.save(stream), 10u);
+  SensorDiscovery loaded;
+  CHECK(loaded.load(stream));
+  CHECK_EQ(loaded.getCount(), 3);
+  for(uint8_t i=0;i<3;i++) {
+    CHECK_EQ(loaded.get(i).type, saved.get(i).type);
+    CHECK_EQ(loaded.get(i).address, saved.get(i).address);
+  }
+  // loading needs no bus access
+  CHECK_EQ(Wire.getTransactions(), 0u);
+}
+
+TEST(corruptedTopology) {
+  SensorDiscovery saved;
+  saved.add(SensorTypeBME280, 0x77);
+  saved.add(SensorTypeSGP41, 0x59);
+  MemoryStream stream;
+  saved.save(stream);
+  SensorDiscovery loaded;
+  for(size_t i=0;i<stream.data.size();i++) {
+    MemoryStream corrupted;
+    corrupted.data = stream.data;
+    corrupted.data[i] ^= 0x04;
+    CHECK(!loaded.load(corrupted));
+  }
+  MemoryStream truncated;
+  truncated.data.assign(stream.data.begin(), stream.data.end() - 1);
+  CHECK(!loaded.load(truncated));
+  MemoryStream empty;
+  CHECK(!loaded.load(empty));
+}
@@ -0,0 +1,61 @@
+#include "TestUtil.h"
+#include <Sensors.h>
+
+// toString() formats of sensors, sensors printing their own format keep it
+
+template<typename S> struct Display : public S {
+  using S::S;
+  using S::formatValues;
+};
+
+TEST(co2Sensors) {
+  Display<SCD30Sensor> scd30;
+  scd30.co2 = 800;
+  scd30.temp = 22.5;
+  scd30.hum = 45;
+  CHECK_EQ(scd30.formatValues(), String("   800ppm 22.5°C  45%"));
+  Display<SCD41Sensor> scd41;
+  scd41.co2 = 1200;
+  scd41.temp = -5.25;
+  scd41.hum = 80;
+  CHECK_EQ(scd41.formatValues(), String("  1200ppm -5.2°C  80%"));
+  Display<CCS811Sensor> ccs811;
+  ccs811.co2 = 400;
+  ccs811.vocRaw = 12;
+  ccs811.vocIndex = 3;
+  CHECK_EQ(ccs811.formatValues(), String("   400ppm     12r   3v"));
+}
+
+TEST(gasSensors) {
+  Display<SGP40Sensor> sgp40;
+  sgp40.vocRaw = 30000;
+  sgp40.vocIndex = 100;
+  CHECK_EQ(sgp40.formatValues(), String("  30000r 100v"));
+  Display<SGP41Sensor> sgp41;
+  sgp41.vocRaw = 30000;
+  sgp41.vocIndex = 100;
+  sgp41.noxRaw = 20000;
+  sgp41.noxIndex = 1;
+  CHECK_EQ(sgp41.formatValues(), String("  30000r 100v nox:  20000r   1v"));
+  Display<SEN54Sensor> sen54;
+  sen54.vocIndex = 100;
+  sen54.pm1p0 = 1.5;
+  sen54.pm2p5 = 2.5;
+  sen54.pm4p0 = 3.5;
+  sen54.pm10p0 = 12;
+  sen54.temp = 22.5;
+  sen54.hum = 45;
+  CHECK_EQ(sen54.formatValues(), String(" 100voc, pm1 1.5, pm2.5 2.5,pm4 3.5,pm10 12.0 22.5°C  45%"));
+}
+
+TEST(tableDrivenSensors) {
+  Display<BME280Sensor> bme280(0);
+  bme280.temp = 22.5;
+  bme280.hum = 45;
+  bme280.pressSeaLevel = 1013;
+  bme280.pressRaw = 990;
+  CHECK_EQ(bme280.formatValues(), String("22.5°C  45%  1013hPa"));
+  Display<BH1750Sensor> bh1750;
+  bh1750.lightIntensity = 123.4;
+  CHECK_EQ(bh1750.formatValues(), String(" 123.4lux"));
+}
@@ -0,0 +1,136 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+#include <InfluxDbClient.h>
+#include <memory>
+
+// DS18B20 probes on one bus: a single conversion for all probes, resolutions, field names of many probes and partial failures
+
+static String fields(Sensor &s) {
+  Point p("m");
+  s.storeValues(p);
+  return p.toLineProtocol();
+}
+
+TEST(probesOfBus) {
+  DS18B20Model probe1(2), probe2(3), probe3(4);
+  probe2.temperature = 30.5;
+  probe3.temperature = -2.25;
+  OneWire::attach(4, probe1);
+  OneWire::attach(4, probe2);
+  OneWire::attach(4, probe3);
+  DS18B20Sensor s(4, 3);
+  CHECK(s.init());
+  CHECK_EQ(s.getProbesCount(), 3);
+  Sensor *sensors[] = { &s };
+  CHECK_EQ(Sensor::readAll(sensors, 1), 1);
+  // one broadcast conversion
+  CHECK_EQ(probe1.conversions, 1u);
+  CHECK_EQ(probe2.conversions, 1u);
+  CHECK_EQ(probe3.conversions, 1u);
+  // in search order of the ROM codes, which start by the lowest bit
+  CHECK_EQ(fields(s), String("m temp=-2.25,temp_1=21.50,temp_2=30.50"));
+  // addresses are cached, a probe added later isn't read
+  DS18B20Model probe4(5);
+  OneWire::attach(4, probe4);
+  CHECK(s.readValues());
+  CHECK_EQ(s.getProbesCount(), 3);
+  CHECK_EQ(probe4.conversions, 1u);
+  CHECK_EQ(fields(s), String("m temp=-2.25,temp_1=21.50,temp_2=30.50"));
+}
+
+TEST(resolutions) {
+  DS18B20Model probe1(2), probe2(3);
+  OneWire::attach(4, probe1);
+  OneWire::attach(4, probe2);
+  DS18B20Sensor s(4, 2);
+  s.setResolution(9);
+  CHECK(s.init());
+  CHECK_EQ(probe1.getResolution(), 9);
+  CHECK_EQ(probe2.getResolution(), 9);
+  Sensor *sensors[] = { &s };
+  uint64_t start = sim::now();
+  CHECK_EQ(Sensor::readAll(sensors, 1), 1);
+  uint64_t fast = sim::now() - start;
+  CHECK(fast >= probe1.conversionTime/8 && fast < probe1.conversionTime/4);
+  // the wait is the conversion time of the highest resolution
+  s.setResolution(1, 11);
+  CHECK(s.init());
+  CHECK_EQ(probe1.getResolution(), 9);
+  CHECK_EQ(probe2.getResolution(), 11);
+  start = sim::now();
+  CHECK_EQ(Sensor::readAll(sensors, 1), 1);
+  CHECK(sim::now() - start >= probe2.conversionTime/2);
+  CHECK_NEAR(s.getProbeTemp(1), 21.5, 0.001);
+}
+
+TEST(failedProbeLeftOut) {
+  DS18B20Model probe1(2), probe2(3);
+  probe2.temperature = 30.5;
+  OneWire::attach(4, probe1);
+  OneWire::attach(4, probe2);
+  DS18B20Sensor s(4, 2);
+  CHECK(s.init());
+  probe1.connected = false;
+  CHECK(s.readValues());
+  CHECK(isnan(s.getProbeTemp(0)));
+  CHECK_EQ(fields(s), String("m temp_1=30.50"));
+  probe2.corruptCrc = 1;
+  CHECK(!s.readValues());
+  CHECK(!s.getStatus());
+  probe1.connected = true;
+  CHECK(s.readValues());
+  CHECK_EQ(fields(s), String("m temp=21.50,temp_1=30.50"));
+}
+
+TEST(partialFailureKeepsStatus) {
+  DS18B20Model probe1(2), probe2(3);
+  probe2.temperature = 30.5;
+  OneWire::attach(4, probe1);
+  OneWire::attach(4, probe2);
+  DS18B20Sensor s(4, 2);
+  CHECK(s.begin());
+  probe2.connected = false;
+  CHECK(s.read());
+  CHECK(s.getStatus());
+  CHECK_EQ(s.getErrorCode(), ErrorRead);
+  CHECK_EQ(s.getErrorDetail(), 1);
+  CHECK(isnan(s.getProbeTemp(1)));
+  CHECK_EQ(fields(s), String("m temp=21.50"));
+  CHECK_EQ(s.getStats().readOk, 1u);
+  probe2.connected = true;
+  CHECK(s.read());
+  CHECK_EQ(s.getErrorCode(), ErrorNone);
+  CHECK_EQ(fields(s), String("m temp=21.50,temp_1=30.50"));
+}
+
+TEST(allProbesFailed) {
+  DS18B20Model probe1(2), probe2(3);
+  OneWire::attach(4, probe1);
+  OneWire::attach(4, probe2);
+  DS18B20Sensor s(4, 2);
+  CHECK(s.begin());
+  probe1.connected = false;
+  probe2.connected = false;
+  CHECK(!s.read());
+  CHECK(!s.getStatus());
+  CHECK_EQ(s.getErrorCode(), ErrorRead);
+  CHECK_EQ(s.getErrorDetail(), 2);
+}
+
+TEST(fieldNamesOfManyProbes) {
+  const uint8_t count = 120;
+  std::vector<std::unique_ptr<DS18B20Model>> probes;
+  for(uint8_t i=0;i<count;i++) {
+    probes.emplace_back(new DS18B20Model(i + 2));
+    OneWire::attach(4, *probes.back());
+  }
+  DS18B20Sensor s(4, count);
+  s.setResolution(9);
+  CHECK(s.begin());
+  CHECK_EQ(s.getProbesCount(), count);
+  CHECK(s.read());
+  String line = fields(s);
+  CHECK(strstr(line.c_str(), ",temp_99=21.50,temp_100=21.50,"));
+  CHECK(strstr(line.c_str(), ",temp_119=21.50"));
+}
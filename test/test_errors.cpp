@@ -0,0 +1,96 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+
+// Error codes and messages formatted from the message table only when asked for
+
+class FailingSensor : public TemperatureSensor {
+  public:
+    FailingSensor():TemperatureSensor("Test") {}
+    virtual bool init() override { status = true; return true; }
+    virtual bool readValues() override { return status; }
+    void fail(SensorError code, uint16_t detail = 0) {
+      status = code == ErrorNone;
+      setError(code, detail);
+    }
+};
+
+TEST(messagesFromTable) {
+  FailingSensor s;
+  CHECK(s.init());
+  CHECK_EQ(s.getError(), String(""));
+  const char *messages[] = { "", "init err", "start err", "reset err", "read err", "temp error", "hum error", "press error",
+    "read err: invalid sample detected", "waiting for (new) data", "read err: crc", "no device found", "self test err",
+    "I2C error", "measurement timeout" };
+  for(uint8_t code=ErrorInit;code<ErrorCount;code++) {
+    s.fail((SensorError)code);
+    CHECK_EQ(s.getErrorCode(), (SensorError)code);
+    CHECK_EQ(s.getError(), String("Test ") + messages[code]);
+  }
+  // unknown code is reported as a read error
+  s.fail((SensorError)ErrorCount);
+  CHECK_EQ(s.getError(), String("Test read err"));
+}
+
+TEST(detailAndToString) {
+  FailingSensor s;
+  CHECK(s.init());
+  s.fail(ErrorRead, 5);
+  CHECK_EQ(s.getErrorDetail(), 5);
+  CHECK_EQ(s.getError(), String("Test read err: 5"));
+  CHECK_EQ(s.toString(), String("Test: ERR: Test read err: 5"));
+  s.fail(ErrorNone);
+  CHECK_EQ(s.getError(), String(""));
+  CHECK(s.toString().indexOf("ERR") < 0);
+}
+
+TEST(driverDetails) {
+  // Sensirion drivers describe their error code by errorToString()
+  SCD41Model scd;
+  Wire.attach(scd);
+  SCD41Sensor s1;
+  CHECK(s1.init());
+  scd.connected = false;
+  CHECK(!s1.readValues());
+  CHECK(s1.getErrorDetail() != 0);
+  CHECK(s1.getError().startsWith("SCD41 "));
+  CHECK(s1.getError().indexOf("I2C") > 0);
+
+  // SGP41 self test result in hex
+  SGP41Model sgp;
+  sgp.selfTestResult = 0x4B00;
+  Wire.attach(sgp);
+  SGP41Sensor s2;
+  CHECK(!s2.init());
+  CHECK_EQ(s2.getError(), String("SGP41 self test err: 4b00"));
+
+  // CCS811 error register bits
+  CCS811Model ccs;
+  Wire.attach(ccs);
+  CCS811Sensor s3;
+  CHECK(s3.init());
+  sim::advance(ccs.getSamplePeriod());
+  ccs.errorId = 0x04;
+  CHECK(!s3.readValues());
+  CHECK(s3.getError().startsWith("CCS811 read err: "));
+
+  // SHTx init error with the configured type
+  SHT31Sensor s4;
+  CHECK(!s4.init());
+  CHECK_EQ(s4.getErrorCode(), ErrorInit);
+  CHECK_EQ(s4.getError(), String("SHT31 init err: type: ") + String((int)SHTSensor::SHT3X));
+}
+
+TEST(successClearsError) {
+  SHT4xModel model;
+  Wire.attach(model);
+  SHT4XSensor s;
+  CHECK(s.init());
+  model.connected = false;
+  CHECK(!s.readValues());
+  CHECK(s.getErrorCode() != ErrorNone);
+  model.connected = true;
+  CHECK(s.readValues());
+  CHECK_EQ(s.getErrorCode(), ErrorNone);
+  CHECK_EQ(s.getError(), String(""));
+}
@@ -0,0 +1,127 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+#include <InfluxDbClient.h>
+
+// Field tables drive writeFields(), getCapabilities() and getValue() of sensors
+
+// Collects written fields as "key=value,"
+class FieldsSink : public FieldSink {
+  public:
+    std::string text;
+    uint8_t count = 0;
+    virtual void addField(const char *key, float value) override { add(key, value, 'f'); }
+    virtual void addField(const char *key, int32_t value) override { add(key, value, 'i'); }
+  protected:
+    void add(const char *key, float value, char type) {
+      char buff[40];
+      snprintf(buff, sizeof(buff), "%s=%.2f%c,", key, value, type);
+      text += buff;
+      count++;
+    }
+};
+
+// Checks that sensor writes exactly the fields of its table and takes capabilities and values from it
+static void checkTable(Sensor &s) {
+  uint8_t count;
+  const FieldDescriptor *fields = s.getFields(count);
+  CHECK(fields);
+  CHECK(count > 0);
+  FieldsSink sink, expected;
+  s.writeFields(sink);
+  uint16_t capabilities = 0;
+  for(uint8_t i=0;i<count;i++) {
+    FieldDescriptor field;
+    readFieldDescriptor(fields, i, field);
+    float value = field.access(s, nullptr);
+    if(field.type == FieldInt) {
+      expected.addField(field.key, (int32_t)value);
+    } else {
+      expected.addField(field.key, value);
+    }
+    if(field.capability && !(capabilities & field.capability)) {
+      float capValue;
+      CHECK(s.getValue((SensorCapability)field.capability, capValue));
+      CHECK_EQ(capValue, value);
+    }
+    capabilities |= field.capability;
+  }
+  CHECK_EQ(sink.text, expected.text);
+  CHECK_EQ(sink.count, count);
+  CHECK_EQ(s.getCapabilities(), capabilities);
+}
+
+TEST(tablesOfSensors) {
+  BME280Model bme;
+  SCD41Model scd41;
+  SEN54Model sen;
+  CCS811Model ccs;
+  Wire.attach(bme);
+  Wire.attach(scd41);
+  Wire.attach(sen);
+  Wire.attach(ccs);
+  BME280Sensor s1(0);
+  SCD41Sensor s2;
+  SEN54Sensor s3;
+  CCS811Sensor s4;
+  Sensor *sensors[] = { &s1, &s2, &s3, &s4 };
+  for(Sensor *s : sensors) {
+    CHECK(s->init());
+  }
+  sim::advance(10000000);
+  CHECK_EQ(Sensor::readAll(sensors, 4), 4);
+  for(Sensor *s : sensors) {
+    checkTable(*s);
+  }
+  CHECK_EQ(s1.getCapabilities(), CapTemperature|CapHumidity|CapPressure);
+  CHECK_EQ(s3.getCapabilities(), CapTemperature|CapHumidity|CapVoc|CapDustPPM);
+  float value;
+  CHECK(!s1.getValue(CapCo2, value));
+  CHECK(s3.getValue(CapDustPPM, value));
+  CHECK_EQ(value, s3.pm2p5);
+}
+
+// Lines are the same as written by the hand-written writeFields() before the tables
+TEST(lineProtocolUnchanged) {
+  SHT4xModel sht;
+  SCD30Model scd;
+  BME280Model bme;
+  SEN54Model sen;
+  Wire.attach(sht);
+  Wire.attach(scd);
+  Wire.attach(bme);
+  Wire.attach(sen);
+  SHT4XSensor s1;
+  SCD30Sensor s2;
+  BME280Sensor s3(0);
+  SEN54Sensor s4;
+  Sensor *sensors[] = { &s1, &s2, &s3, &s4 };
+  for(Sensor *s : sensors) {
+    CHECK(s->init());
+  }
+  sim::advance(scd.interval*1000000ULL);
+  CHECK_EQ(Sensor::readAll(sensors, 4), 4);
+  const char *expected[] = {
+    "env temp=22.50,hum=45.00",
+    "env temp=22.50,hum=45.00,co2=650.00",
+    "env temp=22.50,hum=45.00,press=1013.25,press_raw=1013.25",
+    "env temp=22.50,hum=45.00,voc=100.00,pm1.0=3.10,pm2.5=5.20,pm4.0=6.30,pm10.0=7.40"
+  };
+  for(uint8_t i=0;i<4;i++) {
+    Point p("env");
+    sensors[i]->storeValues(p);
+    CHECK_EQ(p.toLineProtocol(), String(expected[i]));
+  }
+}
+
+TEST(hiddenFieldsNotPrinted) {
+  BME280Model bme;
+  Wire.attach(bme);
+  BME280Sensor s(0);
+  CHECK(s.init());
+  CHECK(s.readValues());
+  FieldsSink sink;
+  s.writeFields(sink);
+  CHECK(strstr(sink.text.c_str(), "press_raw="));
+  CHECK(!strstr(s.toString().c_str(), "press_raw"));
+}
@@ -0,0 +1,218 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+#include <SensorFilters.h>
+#include <StaticSensorSet.h>
+#include <InfluxDbClient.h>
+#include <algorithm>
+
+// Median, Hampel and EMA filters, NAN in the median window and the pipeline storing filtered values into the sensor once per read
+
+class CountingFilter : public ValueFilter {
+  public:
+    uint32_t calls = 0;
+  protected:
+    virtual bool process(float &) override { calls++; return true; }
+    virtual void clear() override {}
+};
+
+static float filtered(ValueFilter &filter, float value) {
+  return filter.filter(value) ? value : NAN;
+}
+
+TEST(medianRemovesSpikes) {
+  MedianFilter median(3);
+  float values[] = { 10, 11, 50, 12, 13, 11 };
+  float expected[] = { 10, 10.5, 11, 12, 13, 12 };
+  for(uint8_t i=0;i<6;i++) {
+    CHECK_NEAR(filtered(median, values[i]), expected[i], 0.001);
+  }
+  median.reset();
+  CHECK_NEAR(filtered(median, 30), 30, 0.001);
+}
+
+TEST(hampelRejectsOutliers) {
+  HampelFilter replacing(5), dropping(5, 3, false);
+  float values[] = { 20, 21, 19, 22, 20 };
+  for(float v : values) {
+    CHECK_NEAR(filtered(replacing, v), v, 0.001);
+    CHECK_NEAR(filtered(dropping, v), v, 0.001);
+  }
+  CHECK(!replacing.isLastRejected());
+  CHECK_NEAR(filtered(replacing, 80), 20, 0.001);
+  CHECK(replacing.isLastRejected());
+  CHECK(isnan(filtered(dropping, 80)));
+  CHECK(dropping.isLastRejected());
+  CHECK_EQ(replacing.getRejectedCount(), 1u);
+  CHECK_EQ(dropping.getRejectedCount(), 1u);
+  CHECK_NEAR(filtered(dropping, 20.5), 20.5, 0.001);
+  CHECK(!dropping.isLastRejected());
+  // constant signal has zero MAD, min deviation accepts small steps
+  HampelFilter coarse(5, 3, false, 0.1);
+  for(int i=0;i<5;i++) {
+    filtered(coarse, 20);
+  }
+  CHECK_NEAR(filtered(coarse, 20.05), 20.05, 0.001);
+  CHECK(isnan(filtered(coarse, 20.5)));
+}
+
+TEST(madMatchesSortedDeviations) {
+  // random windows of all sizes with repeated values, against sorted absolute deviations
+  uint32_t seed = 1;
+  for(uint8_t size=1;size<=12;size++) {
+    SortedWindow window(size);
+    std::vector<float> last;
+    for(int i=0;i<200;i++) {
+      seed = seed*1664525 + 1013904223;
+      float v = (seed >> 24) % 16;
+      window.add(v);
+      last.push_back(v);
+      if(last.size() > size) {
+        last.erase(last.begin());
+      }
+      std::vector<float> sorted(last);
+      std::sort(sorted.begin(), sorted.end());
+      size_t n = sorted.size();
+      float median = n & 1?sorted[n/2]:(sorted[n/2 - 1] + sorted[n/2]) / 2;
+      CHECK_NEAR(window.median(), median, 0.0001);
+      std::vector<float> devs;
+      for(float x : sorted) {
+        devs.push_back(fabsf(x - median));
+      }
+      std::sort(devs.begin(), devs.end());
+      float mad = n & 1?devs[n/2]:(devs[n/2 - 1] + devs[n/2]) / 2;
+      CHECK_NEAR(window.mad(median), mad, 0.0001);
+    }
+  }
+}
+
+TEST(emaAndChain) {
+  EmaFilter ema(0.5);
+  CHECK_NEAR(filtered(ema, 10), 10, 0.001);
+  CHECK_NEAR(filtered(ema, 20), 15, 0.001);
+  CHECK_NEAR(filtered(ema, 20), 17.5, 0.001);
+  // spike rejected by Hampel doesn't reach EMA
+  HampelFilter hampel(5, 3, false);
+  EmaFilter smooth(0.5);
+  hampel.then(smooth);
+  float values[] = { 20, 21, 19, 22, 20 };
+  float value = 0;
+  for(float v : values) {
+    value = filtered(hampel, v);
+  }
+  CHECK(isnan(filtered(hampel, 80)));
+  CHECK_NEAR(filtered(hampel, 20), (value + 20) / 2, 0.001);
+  hampel.reset();
+  CHECK_NEAR(filtered(hampel, 30), 30, 0.001);
+}
+
+TEST(filteredValuesSeenByAllConsumers) {
+  SHT4xModel sht;
+  Wire.attach(sht);
+  StaticSensorSet<SHT4XSensor> set;
+  SHT4XSensor &s = set.get<0>();
+  CHECK_EQ(set.initAll(), 1);
+  HampelFilter hampel(5, 3, false, 0.1);
+  FilterPipeline pipeline;
+  CHECK(pipeline.attach(s, "temp", hampel));
+  float temps[] = { 20, 20.1, 19.9, 20, 20.1 };
+  for(float t : temps) {
+    sht.temperature = t;
+    CHECK_EQ(set.readAll(), 1);
+  }
+  CHECK(!pipeline.isRejected(s, "temp"));
+  sht.temperature = 80;
+  CHECK_EQ(set.readAll(), 1);
+  CHECK(pipeline.isRejected(s, "temp"));
+  CHECK_EQ(pipeline.getRejectedCount(), 1u);
+  // the spike is replaced by the last accepted value everywhere
+  float value;
+  CHECK(s.getValue(CapTemperature, value));
+  CHECK_NEAR(value, 20.1, 0.01);
+  CHECK_NEAR(s.temp, 20.1, 0.01);
+  SensorSnapshot snapshot;
+  CHECK(s.getSnapshot(snapshot));
+  CHECK(snapshot.getValue("temp", value));
+  CHECK_NEAR(value, 20.1, 0.01);
+  Point p1("env"), p2("env");
+  s.storeValues(p1);
+  set.storeValues(p2);
+  CHECK(strstr(p1.toLineProtocol().c_str(), "temp=20.10"));
+  CHECK(strstr(p2.toLineProtocol().c_str(), "temp=20.10"));
+  // unfiltered fields are kept
+  CHECK(s.getValue(CapHumidity, value));
+  CHECK_NEAR(value, sht.humidity, 0.01);
+  sht.temperature = 20;
+  CHECK_EQ(set.readAll(), 1);
+  CHECK(!pipeline.isRejected(s, "temp"));
+  CHECK_NEAR(s.temp, 20, 0.01);
+}
+
+TEST(spikeReplacedByMedian) {
+  SHT4xModel sht;
+  Wire.attach(sht);
+  SHT4XSensor s;
+  CHECK(s.begin());
+  HampelFilter hampel(5);
+  FilterPipeline pipeline;
+  CHECK(pipeline.attach(s, Temp, hampel));
+  float temps[] = { 20, 21, 20, 21, 20, 80 };
+  for(float t : temps) {
+    sht.temperature = t;
+    CHECK(s.read());
+  }
+  // replaced values are accepted
+  CHECK(!pipeline.isRejected(s, Temp));
+  CHECK(hampel.isLastRejected());
+  CHECK_NEAR(s.temp, 20, 0.01);
+}
+
+TEST(filtersRunOncePerRead) {
+  SHT4xModel sht;
+  Wire.attach(sht);
+  SHT4XSensor s;
+  CHECK(s.begin());
+  CountingFilter counter;
+  MedianFilter median(3);
+  counter.then(median);
+  FilterPipeline pipeline;
+  CHECK(pipeline.attach(s, "temp", counter));
+  float temps[] = { 20, 21, 22 };
+  for(float t : temps) {
+    sht.temperature = t;
+    CHECK(s.read());
+  }
+  CHECK_EQ(counter.calls, 3u);
+  for(int i=0;i<3;i++) {
+    Point p("env");
+    s.storeValues(p);
+    CHECK(strstr(p.toLineProtocol().c_str(), "temp=21.00"));
+  }
+  CHECK_EQ(counter.calls, 3u);
+  // failed reads aren't filtered
+  sht.connected = false;
+  CHECK(!s.read());
+  CHECK_EQ(counter.calls, 3u);
+}
+
+TEST(medianSkipsNan) {
+  MedianFilter median(3);
+  float values[] = { 10, NAN, 12, NAN, 11 };
+  float expected[] = { 10, NAN, 11, NAN, 11 };
+  for(uint8_t i=0;i<5;i++) {
+    float value = values[i];
+    CHECK(median.filter(value));
+    if(isnan(expected[i])) {
+      CHECK(isnan(value));
+    } else {
+      CHECK_NEAR(value, expected[i], 0.001);
+    }
+  }
+  SortedWindow window(4);
+  window.add(NAN);
+  window.add(3);
+  window.add(NAN);
+  window.add(1);
+  CHECK_EQ(window.getCount(), 2);
+  CHECK_NEAR(window.median(), 2, 0.001);
+}
@@ -0,0 +1,107 @@
+#include "TestUtil.h"
+#include <InfluxDbClient.h>
+#include <SensorsFormat.h>
+#include <Sensors.h>
+
+// formatFixed() must give the same text as Point::addField(float), which formats by dtostrf(),
+// LineProtocolWriter drops lines which don't fit
+
+static String fixed(float value, uint8_t decimals) {
+  char buff[SENSORS_NUMBER_MAX_LEN];
+  return String(std::string(buff, formatFixed(buff, value, decimals)));
+}
+
+static String pointField(float value, uint8_t decimals) {
+  Point p("m");
+  p.addField("f", value, decimals);
+  // String() pads to width decimals+2, which matters only for 0 decimals
+  String line = p.toLineProtocol();
+  const char *v = line.c_str() + 4;
+  while(*v == ' ') {
+    v++;
+  }
+  return String(v);
+}
+
+TEST(tiesAndNegativeZero) {
+  struct { float value; uint8_t decimals; const char *text; } table[] = {
+    { 0.125f, 2, "0.13" },
+    // 0.375 + 0.005 is just below 0.38 in double, dtostrf() prints 0.37
+    { 0.375f, 2, "0.37" },
+    { 2.5f, 0, "3" },
+    { 3.5f, 0, "4" },
+    { 1.25f, 1, "1.3" },
+    { 1.75f, 1, "1.8" },
+    { -0.125f, 2, "-0.13" },
+    { -2.5f, 0, "-3" },
+    { 1022.625f, 2, "1022.62" },
+    { 0.0f, 2, "0.00" },
+    { -0.0f, 2, "0.00" },
+    { -0.0f, 0, "0" },
+    { -0.001f, 2, "-0.00" },
+    { 21.456f, 1, "21.5" },
+    { 1.005f, 2, "1.00" },
+    { 65535, 0, "65535" },
+  };
+  for(auto &t : table) {
+    CHECK_EQ(fixed(t.value, t.decimals), String(t.text));
+    CHECK_EQ(fixed(t.value, t.decimals), pointField(t.value, t.decimals));
+  }
+}
+
+TEST(nanAndInf) {
+  CHECK_EQ(fixed(NAN, 2), String("nan"));
+  CHECK_EQ(fixed(-NAN, 2), String("nan"));
+  CHECK_EQ(fixed(INFINITY, 2), String(INFINITY, 2));
+  CHECK_EQ(fixed(-INFINITY, 2), String(-INFINITY, 2));
+}
+
+TEST(matchesPointOutput) {
+  // sensor ranges in fine steps, including every tie of 2 and 3 decimals representable in float
+  for(uint8_t decimals=0;decimals<=3;decimals++) {
+    for(int32_t i=-50000;i<=150000;i++) {
+      float v = i/128.0f;
+      CHECK_EQ(fixed(v, decimals), pointField(v, decimals));
+    }
+  }
+  for(int32_t i=-20000;i<=20000;i++) {
+    float v = i*0.37f + 0.001f*i;
+    CHECK_EQ(fixed(v, 2), pointField(v, 2));
+  }
+}
+
+TEST(lineDroppedAfterExactFit) {
+  // first line fills the buffer up to the terminating zero, separator of the second one doesn't fit
+  char buff[9];
+  LineProtocolWriter w(buff, sizeof(buff));
+  w.beginLine("m");
+  w.addField("f", (int32_t)1);
+  w.endLine(5);
+  CHECK(!w.isOverflow());
+  CHECK_EQ(std::string(buff), std::string("m f=1i 5"));
+  w.beginLine("m");
+  w.addField("f", (int32_t)2);
+  w.endLine(6);
+  CHECK(w.isOverflow());
+  CHECK_EQ(w.length(), 8u);
+  CHECK_EQ(std::string(buff), std::string("m f=1i 5"));
+  // second line which fits partially is dropped with its separator
+  char buff2[12];
+  LineProtocolWriter w2(buff2, sizeof(buff2));
+  w2.beginLine("m");
+  w2.addField("f", (int32_t)1);
+  w2.endLine(5);
+  w2.beginLine("m");
+  w2.addField("f", (int32_t)2);
+  w2.endLine(6);
+  CHECK_EQ(std::string(buff2), std::string("m f=1i 5"));
+  // line without fields is dropped as well
+  char buff3[32];
+  LineProtocolWriter w3(buff3, sizeof(buff3));
+  w3.beginLine("m");
+  w3.addField("f", (int32_t)1);
+  w3.endLine(5);
+  w3.beginLine("empty");
+  w3.endLine(6);
+  CHECK_EQ(std::string(buff3), std::string("m f=1i 5"));
+}
@@ -0,0 +1,155 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+#include <GasIndex.h>
+
+// Gas index algorithm output, learned state, extreme signals, SGP40 read failures, SGP41 indexes and speed
+
+TEST(steadySignalIsAverage) {
+  GasIndexAlgorithm voc(GasIndexVoc), nox(GasIndexNox);
+  // initial blackout
+  CHECK_EQ(voc.process(30000), 0);
+  CHECK_EQ(nox.process(16000), 0);
+  int32_t vocIndex = 0, noxIndex = 0;
+  for(int i=0;i<3600;i++) {
+    vocIndex = voc.process(30000);
+    noxIndex = nox.process(16000);
+  }
+  CHECK(vocIndex >= 95 && vocIndex <= 105);
+  CHECK_EQ(noxIndex, 1);
+}
+
+TEST(gasRaisesIndex) {
+  GasIndexAlgorithm voc(GasIndexVoc), nox(GasIndexNox);
+  for(int i=0;i<3600;i++) {
+    voc.process(30000);
+    nox.process(16000);
+  }
+  // VOC lowers the raw signal, NOx raises it
+  int32_t vocIndex = 0, noxIndex = 0;
+  for(int i=0;i<60;i++) {
+    vocIndex = voc.process(27000);
+    noxIndex = nox.process(19000);
+  }
+  CHECK(vocIndex > 150 && vocIndex <= 500);
+  CHECK(noxIndex > 1 && noxIndex <= 500);
+}
+
+TEST(restoredStateSkipsLearning) {
+  GasIndexAlgorithm learned(GasIndexVoc);
+  for(int i=0;i<3600;i++) {
+    learned.process(30000);
+  }
+  int32_t mean, std;
+  learned.getState(mean, std);
+  GasIndexAlgorithm restored(GasIndexVoc);
+  restored.setState(mean, std);
+  // no blackout after restore
+  int32_t index = restored.process(30000);
+  CHECK(index >= 90 && index <= 110);
+  for(int i=0;i<60;i++) {
+    index = restored.process(30000);
+  }
+  CHECK(index >= 95 && index <= 105);
+  // the same gas gives the same index as the learned instance
+  for(int i=0;i<30;i++) {
+    index = restored.process(27000);
+    CHECK_EQ(index, learned.process(27000));
+  }
+}
+
+TEST(sgp41Indexes) {
+  SGP41Model model;
+  Wire.attach(model);
+  SGP41Sensor s;
+  CHECK(s.init());
+  // conditioning gives no indexes
+  for(int i=0;i<10;i++) {
+    CHECK(s.readValues());
+    sim::advance(1000000);
+  }
+  CHECK_EQ(model.conditionings, 10u);
+  CHECK_EQ(s.vocIndex, 0);
+  CHECK_EQ(s.noxIndex, 0);
+  for(int i=0;i<3600;i++) {
+    CHECK(s.readValues(22.5, 40));
+    sim::advance(1000000);
+  }
+  CHECK(s.vocIndex >= 95 && s.vocIndex <= 105);
+  CHECK_EQ(s.noxIndex, 1);
+  CHECK_EQ(s.noxRaw, 16000);
+  // ticks of the compensation, converted again when it changes
+  CHECK_EQ(model.lastTempTicks, 25277);
+  CHECK_EQ(model.lastHumTicks, 26214);
+  CHECK(s.readValues(-45, 100));
+  CHECK_EQ(model.lastTempTicks, 0);
+  CHECK_EQ(model.lastHumTicks, 0xFFFF);
+  // default compensation of readValues() isn't changed
+  CHECK(s.readValues());
+  CHECK_EQ(model.lastTempTicks, 0x6666);
+  CHECK_EQ(model.lastHumTicks, 0x8000);
+  // missing compensation gives default ticks, also when it repeats
+  for(int i=0;i<2;i++) {
+    CHECK(s.readValues(NAN, NAN));
+    CHECK_EQ(model.lastTempTicks, 0x6666);
+    CHECK_EQ(model.lastHumTicks, 0x8000);
+  }
+  CHECK(s.readValues(22.5, NAN));
+  CHECK_EQ(model.lastTempTicks, 25277);
+  CHECK_EQ(model.lastHumTicks, 0x8000);
+}
+
+TEST(sgp40FailedReadSkipsAlgorithm) {
+  SGP40Model model;
+  Wire.attach(model);
+  SGP40Sensor s;
+  GasIndexAlgorithm reference(GasIndexVoc);
+  CHECK(s.begin());
+  for(int i=0;i<60;i++) {
+    CHECK(s.read());
+    reference.process(s.vocRaw);
+    sim::advance(1000000);
+  }
+  uint16_t index = s.vocIndex;
+  model.failTransactions = 1;
+  CHECK(!s.read());
+  CHECK_EQ(s.getErrorCode(), ErrorRead);
+  CHECK(!s.getStatus());
+  CHECK_EQ(s.vocRaw, 30000);
+  CHECK_EQ(s.vocIndex, index);
+  // the failed sample didn't enter the algorithm
+  CHECK(s.read());
+  CHECK_EQ(s.vocIndex, reference.process(s.vocRaw));
+}
+
+TEST(extremeSignalsStayInRange) {
+  for(uint8_t t=0;t<2;t++) {
+    GasIndexAlgorithm algorithm(t?GasIndexNox:GasIndexVoc);
+    for(int i=0;i<3600;i++) {
+      algorithm.process(30000);
+    }
+    // sudden drops and jumps of the signal push sigmoid arguments far beyond exp range
+    int32_t raws[] = { 0, 1, 65535, 0, 20000, 65535, 65535, 0 };
+    for(int32_t raw : raws) {
+      for(int i=0;i<30;i++) {
+        int32_t index = algorithm.process(raw);
+        CHECK(index >= 0 && index <= 500);
+      }
+    }
+  }
+}
+
+TEST(benchmark) {
+  GasIndexAlgorithm voc(GasIndexVoc), nox(GasIndexNox);
+  const uint32_t samples = 200000;
+  int32_t sum = 0;
+  double us = measureUs([&]() {
+    for(uint32_t i=0;i<samples;i++) {
+      int32_t raw = 30000 + (int32_t)(i*7919 % 2000) - 1000;
+      sum += voc.process(raw);
+      sum += nox.process(raw/2);
+    }
+  });
+  CHECK(sum > 0);
+  printf("  process %.3f us/sample\n", us/(2*samples));
+}
@@ -0,0 +1,245 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+#include <vector>
+
+// Health of sensors, which failures count toward quarantine and the backoff of re-inits
+
+static void advanceTo(uint32_t ms) {
+  sim::advance((uint64_t)(ms - sensorsMillis())*1000);
+}
+
+static std::vector<SensorHealth> changes;
+
+static void onHealth(Sensor &sensor, SensorHealth) {
+  changes.push_back(sensor.getHealth());
+}
+
+TEST(degradedThenQuarantined) {
+  changes.clear();
+  setSensorHealthCallback(onHealth);
+  SHT4xModel sht;
+  Wire.attach(sht);
+  SHT4XSensor s;
+  CHECK(s.begin());
+  CHECK(s.read());
+  sht.connected = false;
+  CHECK(!s.read());
+  CHECK_EQ(s.getHealth(), HealthDegraded);
+  CHECK_EQ(s.getConsecutiveFailures(), 1);
+  // a successful read clears the failures
+  sht.connected = true;
+  CHECK(s.read());
+  CHECK_EQ(s.getHealth(), HealthOk);
+  CHECK_EQ(s.getConsecutiveFailures(), 0);
+  sht.connected = false;
+  for(uint8_t i=0;i<SENSOR_QUARANTINE_FAILURES;i++) {
+    CHECK(!s.read());
+  }
+  CHECK_EQ(s.getHealth(), HealthQuarantined);
+  CHECK_EQ(s.getRetryTime() - sensorsMillis(), (uint32_t)SENSOR_BACKOFF_MIN);
+  // quarantined sensor isn't touched until the backoff elapses
+  sht.connected = true;
+  uint32_t transactions = Wire.getTransactions();
+  CHECK(!s.read());
+  Sensor *sensors[] = { &s };
+  CHECK_EQ(Sensor::readAll(sensors, 1), 0);
+  CHECK_EQ(Wire.getTransactions(), transactions);
+  CHECK_EQ(s.getStats().readSkipped, 2u);
+  // then it is re-initialized and read
+  advanceTo(s.getRetryTime());
+  CHECK(s.read());
+  CHECK_EQ(s.getStats().reinits, 1);
+  CHECK_EQ(s.getHealth(), HealthOk);
+  setSensorHealthCallback(nullptr);
+  // successful re-init leaves the sensor degraded until a successful read
+  SensorHealth expected[] = { HealthDegraded, HealthOk, HealthDegraded, HealthQuarantined, HealthDegraded, HealthOk };
+  CHECK_EQ(changes.size(), 6u);
+  for(uint8_t i=0;i<6 && i<changes.size();i++) {
+    CHECK_EQ(changes[i], expected[i]);
+  }
+}
+
+TEST(failedInitQuarantines) {
+  SHT4xModel sht;
+  sht.connected = false;
+  Wire.attach(sht);
+  SHT4XSensor s;
+  CHECK(!s.begin());
+  CHECK_EQ(s.getHealth(), HealthQuarantined);
+  sht.connected = true;
+  CHECK(!s.read());
+  advanceTo(s.getRetryTime());
+  CHECK(s.read());
+  CHECK_EQ(s.getHealth(), HealthOk);
+}
+
+TEST(backoffSchedule) {
+  SHT4xModel sht;
+  Wire.attach(sht);
+  SHT4XSensor s;
+  CHECK(s.begin());
+  advanceTo(1000);
+  CHECK(s.read());
+  sht.connected = false;
+  // reads every second fail, the third one quarantines the sensor at 4 s
+  for(uint32_t t=2000;t<=4000;t+=1000) {
+    advanceTo(t);
+    CHECK(!s.read());
+  }
+  CHECK_EQ(s.getHealth(), HealthQuarantined);
+  // re-inits of the missing device fail and double the backoff, polls are 10ms apart and each failed init takes a few ms
+  std::vector<uint32_t> reinits;
+  uint16_t count = s.getStats().reinits;
+  while(sensorsMillis() < 40000) {
+    advanceTo(sensorsMillis() + 10);
+    CHECK(!s.read());
+    if(s.getStats().reinits != count) {
+      count = s.getStats().reinits;
+      reinits.push_back(sensorsMillis());
+    }
+  }
+  uint32_t expected[] = { 5000, 7000, 11000, 19000, 35000 };
+  CHECK_EQ(reinits.size(), 5u);
+  for(uint8_t i=0;i<5 && i<reinits.size();i++) {
+    CHECK(reinits[i] >= expected[i] && reinits[i] < expected[i] + 100);
+  }
+  CHECK_EQ(s.getHealth(), HealthQuarantined);
+  // device is back, the next re-init succeeds and a successful read resets the backoff
+  sht.connected = true;
+  while(s.getHealth() == HealthQuarantined && sensorsMillis() < 80000) {
+    advanceTo(sensorsMillis() + 10);
+    s.read();
+  }
+  CHECK(sensorsMillis() >= 67000);
+  CHECK_EQ(s.getHealth(), HealthOk);
+  sht.connected = false;
+  for(uint8_t i=0;i<SENSOR_QUARANTINE_FAILURES;i++) {
+    CHECK(!s.read());
+  }
+  CHECK_EQ(s.getRetryTime() - sensorsMillis(), (uint32_t)SENSOR_BACKOFF_MIN);
+}
+
+TEST(backoffLimit) {
+  SHT4xModel sht;
+  sht.connected = false;
+  Wire.attach(sht);
+  SHT4XSensor s;
+  CHECK(!s.begin());
+  uint32_t previous = 0;
+  for(int i=0;i<20;i++) {
+    uint32_t backoff = s.getRetryTime() - sensorsMillis();
+    CHECK(backoff >= previous || backoff == (uint32_t)SENSOR_BACKOFF_MAX);
+    CHECK(backoff <= (uint32_t)SENSOR_BACKOFF_MAX);
+    previous = backoff;
+    advanceTo(s.getRetryTime());
+    CHECK(!s.read());
+  }
+  CHECK_EQ(previous, (uint32_t)SENSOR_BACKOFF_MAX);
+}
+
+TEST(missingDeviceDuringConversion) {
+  SHT4xModel sht;
+  Wire.attach(sht);
+  SHT4XSensor s1;
+  CHECK(s1.begin());
+  CHECK(s1.startMeasurement());
+  sht.connected = false;
+  sim::advance(20000);
+  CHECK(!s1.finishMeasurement());
+  CHECK_EQ(s1.getErrorCode(), ErrorBus);
+
+  HTU21DModel htu;
+  Wire.attach(htu);
+  HTU21DSensor s2;
+  CHECK(s2.begin());
+  CHECK(s2.startMeasurement());
+  htu.connected = false;
+  sim::advance(100000);
+  CHECK(s2.measurementReady());
+  CHECK(!s2.finishMeasurement());
+  CHECK_EQ(s2.getErrorCode(), ErrorBus);
+}
+
+TEST(scd30NotReadyIsNoData) {
+  SCD30Model scd;
+  Wire.attach(scd);
+  SCD30Sensor s;
+  CHECK(s.begin());
+  sim::advance(2000000);
+  CHECK(s.read());
+  for(uint8_t i=0;i<5;i++) {
+    CHECK(!s.read());
+    CHECK_EQ(s.getErrorCode(), ErrorNoData);
+  }
+  CHECK_EQ(s.getHealth(), HealthOk);
+}
+
+TEST(scd30DisconnectedQuarantines) {
+  SCD30Model scd;
+  Wire.attach(scd);
+  SCD30Sensor s;
+  CHECK(s.begin());
+  sim::advance(2000000);
+  CHECK(s.read());
+  // missing device is a bus error, not a sample not ready yet
+  scd.connected = false;
+  for(uint8_t i=0;i<20 && s.getHealth() != HealthQuarantined;i++) {
+    sim::advance(2000000);
+    CHECK(!s.read());
+    CHECK_EQ(s.getErrorCode(), ErrorBus);
+  }
+  CHECK_EQ(s.getHealth(), HealthQuarantined);
+  CHECK_EQ(s.getStats().errors[ErrorBus], (uint16_t)SENSOR_QUARANTINE_FAILURES);
+  // and it isn't touched until the backoff elapses
+  uint32_t transactions = Wire.getTransactions();
+  CHECK(!s.read());
+  CHECK_EQ(Wire.getTransactions(), transactions);
+}
+
+TEST(scd30NoDataBeyondGrace) {
+  SCD30Model scd;
+  Wire.attach(scd);
+  SCD30Sensor s;
+  CHECK(s.begin());
+  sim::advance(2000000);
+  CHECK(s.read());
+  // device responds, but doesn't measure anymore
+  scd.interval = 1800;
+  uint32_t last = sensorsMillis();
+  while(s.getHealth() != HealthQuarantined && sensorsMillis() - last < 300000) {
+    advanceTo(sensorsMillis() + 10000);
+    CHECK(!s.read());
+    CHECK_EQ(s.getErrorCode(), ErrorNoData);
+    if(sensorsMillis() - last < SENSOR_PERIODIC_GRACE) {
+      CHECK_EQ(s.getHealth(), HealthOk);
+    }
+  }
+  CHECK_EQ(s.getHealth(), HealthQuarantined);
+}
+
+TEST(periodicTimeouts) {
+  SCD30Model scd;
+  Wire.attach(scd);
+  SCD30Sensor s;
+  CHECK(s.begin());
+  // device measures less often than it is read
+  scd.interval = 60;
+  Sensor *sensors[] = { &s };
+  uint8_t ok = 0;
+  for(uint32_t t=10000;t<=300000;t+=10000) {
+    advanceTo(t);
+    ok += Sensor::readAll(sensors, 1);
+    CHECK(s.getHealth() != HealthQuarantined);
+  }
+  CHECK(ok >= 4);
+  // without samples for the grace period timeouts count
+  scd.connected = false;
+  uint32_t lost = sensorsMillis();
+  while(s.getHealth() != HealthQuarantined && sensorsMillis() - lost < 300000) {
+    advanceTo(sensorsMillis() + 10000);
+    Sensor::readAll(sensors, 1);
+  }
+  CHECK_EQ(s.getHealth(), HealthQuarantined);
+  CHECK(sensorsMillis() - lost >= SENSOR_PERIODIC_GRACE - 60000);
+}
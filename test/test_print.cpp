@@ -0,0 +1,138 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+#include <SensorsFormat.h>
+
+// Text output streamed through Print is the same as formatted by printf before
+
+// Print collecting text and counting writes
+class CollectingPrint : public Print {
+  public:
+    std::string text;
+    uint16_t writes = 0;
+    virtual size_t write(uint8_t c) override { text += (char)c; writes++; return 1; }
+};
+
+static std::string printed(float value, uint8_t width, uint8_t decimals) {
+  CollectingPrint out;
+  printFixed(out, value, width, decimals);
+  return out.text;
+}
+
+static std::string printfed(float value, uint8_t width, uint8_t decimals) {
+  char buff[64];
+  snprintf(buff, sizeof(buff), "%*.*f", width, decimals, value);
+  return buff;
+}
+
+TEST(numbersMatchPrintf) {
+  const float values[] = { 0, 1.04, -1.06, 9.96, 21.37, -40.123, 999.96, 1013.27, 12345.678, 0.0004 };
+  for(float v : values) {
+    for(uint8_t decimals=0;decimals<=3;decimals++) {
+      CHECK_EQ(printed(v, 4, decimals), printfed(v, 4, decimals));
+      CHECK_EQ(printed(v, 0, decimals), printfed(v, 0, decimals));
+    }
+  }
+  // exact binary ties round half to even, negative zero keeps its sign
+  CHECK_EQ(printed(0.125, 0, 2), std::string("0.12"));
+  CHECK_EQ(printed(0.375, 0, 2), std::string("0.38"));
+  CHECK_EQ(printed(21.0625, 0, 3), std::string("21.062"));
+  CHECK_EQ(printed(2.5, 0, 0), std::string("2"));
+  CHECK_EQ(printed(-0.0, 0, 1), std::string("-0.0"));
+  CHECK_EQ(printed(-0.01, 0, 1), std::string("-0.0"));
+  const float ties[] = { 0.125, 0.375, -0.625, 21.0625, -21.0625, 0.5, 1.5, 2.5, 1013.25, 0.0009765625, -0.0, 3e38, 1.8e19, 1e-40 };
+  for(float v : ties) {
+    for(uint8_t decimals=0;decimals<=6;decimals++) {
+      CHECK_EQ(printed(v, 6, decimals), printfed(v, 6, decimals));
+    }
+  }
+  // any float
+  uint32_t bits = 12345;
+  for(int i=0;i<20000;i++) {
+    bits = bits*1664525 + 1013904223;
+    float v;
+    memcpy(&v, &bits, sizeof(v));
+    if(isnan(v)) {
+      continue;
+    }
+    uint8_t decimals = i % 7;
+    CHECK_EQ(printed(v, 0, decimals), printfed(v, 0, decimals));
+  }
+  CHECK_EQ(printed(NAN, 5, 1), std::string("  nan"));
+  CHECK_EQ(printed(INFINITY, 2, 1), std::string("inf"));
+  CHECK_EQ(printed(-INFINITY, 5, 1), std::string(" -inf"));
+  const int32_t ints[] = { 0, 7, -7, 650, 65535, -100000, INT32_MAX, INT32_MIN };
+  for(int32_t v : ints) {
+    CollectingPrint out;
+    printInt(out, v, 5);
+    char buff[20];
+    snprintf(buff, sizeof(buff), "%5d", (int)v);
+    CHECK_EQ(out.text, std::string(buff));
+  }
+}
+
+TEST(printToMatchesOldFormat) {
+  BME280Model bme;
+  SEN54Model sen;
+  SCD30Model scd;
+  bme.temperature = 21.37;
+  Wire.attach(bme);
+  Wire.attach(sen);
+  Wire.attach(scd);
+  BME280Sensor s1(0);
+  SEN54Sensor s2;
+  SCD30Sensor s3;
+  CHECK(s1.init());
+  CHECK(s2.init());
+  CHECK(s3.init());
+  sim::advance(scd.interval*1000000ULL);
+  CHECK(s1.readValues());
+  CHECK(s2.readValues());
+  CHECK(s3.readValues());
+  char expected[120];
+  CollectingPrint out;
+  s1.printTo(out);
+  snprintf(expected, sizeof(expected), "BME280: %3.1f°C  %2.0f%%  %4.0fhPa", s1.temp, s1.hum, s1.pressSeaLevel);
+  CHECK_EQ(out.text, std::string(expected));
+  CHECK_EQ(s1.toString(), String(expected));
+
+  out.text.clear();
+  s2.printTo(out);
+  snprintf(expected, sizeof(expected), "SEN54:  %3.0fvoc, pm1 %2.1f, pm2.5 %2.1f,pm4 %2.1f,pm10 %2.1f %3.1f°C  %2.0f%%",
+    (float)s2.vocIndex, s2.pm1p0, s2.pm2p5, s2.pm4p0, s2.pm10p0, s2.temp, s2.hum);
+  CHECK_EQ(out.text, std::string(expected));
+
+  out.text.clear();
+  s3.printTo(out);
+  snprintf(expected, sizeof(expected), "SCD30:  %5dppm %3.1f°C  %2.0f%%", s3.co2, s3.temp, s3.hum);
+  CHECK_EQ(out.text, std::string(expected));
+}
+
+TEST(printToError) {
+  SHT4xModel model;
+  Wire.attach(model);
+  SHT4XSensor s;
+  CHECK(s.init());
+  model.connected = false;
+  CHECK(!s.readValues());
+  CollectingPrint out;
+  s.printTo(out);
+  CHECK_EQ(out.text, std::string("SHT4X: ERR: ") + s.getError().c_str());
+  CHECK_EQ(String(out.text.c_str()), s.toString());
+}
+
+TEST(toBuffer) {
+  SHT4xModel model;
+  Wire.attach(model);
+  SHT4XSensor s;
+  CHECK(s.init());
+  CHECK(s.readValues());
+  char buff[40];
+  size_t len = s.toString(buff, sizeof(buff));
+  CHECK_EQ(String(buff), s.toString());
+  CHECK_EQ(len, strlen(buff));
+  // text not fitting is cut, the buffer stays terminated
+  char small[8];
+  CHECK_EQ(s.toString(small, sizeof(small)), 7u);
+  CHECK_EQ(String(small), String("SHT4X: "));
+}
@@ -0,0 +1,97 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+
+// Measurement profiles mapped to native settings of the devices and their expected conversion times
+
+TEST(supportedProfiles) {
+  BME280Sensor bme(0);
+  SHT4XSensor sht4x;
+  CCS811Sensor ccs;
+  SCD41Sensor scd41;
+  SHT31Sensor sht31;
+  CHECK(bme.setProfile(ProfilePrecise));
+  CHECK_EQ(bme.getConversionTime(), 47u);
+  CHECK(bme.setProfile(ProfileDefault));
+  CHECK_EQ(bme.getConversionTime(), 10u);
+  CHECK_EQ(sht4x.getProfileConversionTime(ProfileDefault), 9u);
+  CHECK_EQ(sht4x.getProfileConversionTime(ProfileFastest), 2u);
+  CHECK(!ccs.setProfile(ProfilePrecise));
+  CHECK_EQ(ccs.getProfile(), ProfileDefault);
+  CHECK_EQ(ccs.getProfileConversionTime(ProfileFastest), 1000u);
+  CHECK_EQ(ccs.getProfileConversionTime(ProfileDefault), 10000u);
+  CHECK_EQ(ccs.getProfileConversionTime(ProfileLowPower), 60000u);
+  CHECK(!scd41.setProfile(ProfilePrecise));
+  CHECK_EQ(scd41.getProfileConversionTime(ProfileLowPower), 30000u);
+  CHECK_EQ(scd41.getProfileConversionTime(ProfileSingleShot), 5000u);
+  // sensors without profiles
+  CHECK(!sht31.setProfile(ProfileFastest));
+  CHECK(sht31.setProfile(ProfileDefault));
+}
+
+TEST(bme280Precise) {
+  BME280Model model;
+  Wire.attach(model);
+  BME280Sensor s(0);
+  CHECK(s.setProfile(ProfilePrecise));
+  CHECK(s.init());
+  uint32_t precise = model.getConversionTime();
+  CHECK(precise > 10000 && precise <= s.getConversionTime()*1000);
+  Sensor *sensors[] = { &s };
+  uint64_t start = sim::now();
+  CHECK_EQ(Sensor::readAll(sensors, 1, s.getConversionTime() + 10), 1);
+  CHECK(sim::now() - start >= precise);
+  CHECK_NEAR(s.temp, 22.5, 0.01);
+  CHECK_NEAR(s.hum, 45, 0.01);
+}
+
+TEST(sht4xFastest) {
+  SHT4xModel model;
+  Wire.attach(model);
+  SHT4XSensor s;
+  CHECK(s.setProfile(ProfileFastest));
+  CHECK(s.init());
+  // start at a millisecond tick, the 2 ms wait is then at least 2 ms long
+  sim::advance(1000 - sim::now() % 1000);
+  Sensor *sensors[] = { &s };
+  uint64_t start = sim::now();
+  CHECK_EQ(Sensor::readAll(sensors, 1), 1);
+  CHECK(sim::now() - start < model.mediumPrecisionTime);
+  start = sim::now();
+  CHECK(s.readValues());
+  CHECK(sim::now() - start < model.mediumPrecisionTime);
+  CHECK_NEAR(s.temp, 22.5, 0.01);
+}
+
+TEST(ccs811DriveModes) {
+  CCS811Model model;
+  Wire.attach(model);
+  CCS811Sensor s1;
+  CHECK(s1.setProfile(ProfileFastest));
+  CHECK(s1.init());
+  CHECK_EQ(model.getSamplePeriod(), 1000000u);
+  CCS811Sensor s2;
+  CHECK(s2.setProfile(ProfileLowPower));
+  CHECK(s2.init());
+  CHECK_EQ(model.getSamplePeriod(), 60000000u);
+  sim::advance(model.getSamplePeriod());
+  CHECK(s2.readValues());
+  CHECK_EQ(s2.co2, 600);
+}
+
+TEST(scd41LowPowerAndSingleShot) {
+  SCD41Model model;
+  Wire.attach(model);
+  SCD41Sensor s1;
+  CHECK(s1.setProfile(ProfileLowPower));
+  CHECK(s1.init());
+  CHECK(model.getMode() == SCD41Model::LowPower);
+  SCD41Sensor s2;
+  CHECK(s2.setProfile(ProfileSingleShot));
+  CHECK(s2.init());
+  CHECK(model.getMode() == SCD41Model::Idle);
+  CHECK(s2.readValues());
+  CHECK_EQ(model.singleShots, 1u);
+  CHECK_EQ(s2.co2, 700);
+  CHECK(model.getMode() == SCD41Model::Idle);
+}
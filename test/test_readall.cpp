@@ -0,0 +1,133 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+#include <StaticSensorSet.h>
+
+// Overlapped readAll() on the simulated clock: cycle takes as long as the slowest sensor and sensors are polled at bounded interval
+
+TEST(overlappedCycle) {
+  BME280Model bme;
+  Si7021Model si;
+  Wire.attach(bme);
+  Wire.attach(si);
+  SHT4xModel sht4;
+  Wire.attach(sht4);
+  BME280Sensor s1(0);
+  SHT4XSensor s2;
+  SI702xSensor s3;
+  CHECK(s1.begin());
+  CHECK(s2.begin());
+  CHECK(s3.begin());
+  bme.temperature = 20;
+  sht4.temperature = 21;
+  si.temperature = 22;
+  Sensor *sensors[] = { &s1, &s2, &s3 };
+  uint32_t finishTimes[3];
+  uint32_t start = sensorsMillis();
+  CHECK_EQ(Sensor::readAll(sensors, 3, 2000, finishTimes), 3);
+  CHECK_NEAR(s1.temp, 20, 0.01);
+  CHECK_NEAR(s2.temp, 21, 0.01);
+  CHECK_NEAR(s3.temp, 22, 0.01);
+  // fastest sensors finish within a poll interval after their conversion
+  CHECK(finishTimes[0] - start <= s1.getConversionTime() + SENSOR_POLL_INTERVAL);
+  CHECK(finishTimes[1] - start <= s2.getConversionTime() + SENSOR_POLL_INTERVAL);
+  // the cycle is as long as the slowest sensor, not the sum
+  uint32_t cycle = sensorsMillis() - start;
+  CHECK(cycle <= s3.getConversionTime() + 2*SENSOR_POLL_INTERVAL);
+}
+
+TEST(splitConversionsWaitFullTime) {
+  SHT4xModel sht;
+  HTU21DModel htu;
+  Wire.attach(sht);
+  Wire.attach(htu);
+  SHT4XSensor s1;
+  HTU21DSensor s2;
+  CHECK(s1.begin());
+  CHECK(s2.begin());
+  Sensor *sensors[] = { &s1, &s2 };
+  // start at every microsecond offset within a millisecond tick, conversions must not be cut short
+  for(uint32_t offset=0;offset<1000;offset+=100) {
+    sim::advance(offset);
+    sht.humidity = 30 + offset/100;
+    htu.humidity = 40 + offset/100;
+    CHECK_EQ(Sensor::readAll(sensors, 2), 2);
+    CHECK_NEAR(s1.hum, 30 + offset/100, 0.01);
+    CHECK_NEAR(s2.hum, 40 + offset/100, 0.01);
+  }
+}
+
+TEST(boundedPolling) {
+  SCD30Model scd;
+  Wire.attach(scd);
+  SCD30Sensor s;
+  CHECK(s.begin());
+  Sensor *sensors[] = { &s };
+  // consume the first sample, the next one comes after the whole interval
+  sim::advance(2000000);
+  CHECK(s.read());
+  uint32_t before = scd.transactions;
+  CHECK_EQ(Sensor::readAll(sensors, 1, 3000), 1);
+  // data ready is a write and a read transaction, polled every SENSOR_POLL_INTERVAL
+  uint32_t polls = (scd.transactions - before)/2;
+  CHECK(polls <= 2000/SENSOR_POLL_INTERVAL + 5);
+}
+
+TEST(timeoutWithoutSpinning) {
+  SCD30Model scd;
+  Wire.attach(scd);
+  SCD30Sensor s;
+  CHECK(s.begin());
+  scd.interval = 60;
+  Sensor *sensors[] = { &s };
+  // timeout is extended to the sampling period
+  uint32_t timeout = s.getConversionTime() + SENSOR_TIMEOUT_MARGIN;
+  uint32_t start = sensorsMillis();
+  CHECK_EQ(Sensor::readAll(sensors, 1, 500), 0);
+  CHECK_EQ(s.getErrorCode(), ErrorTimeout);
+  uint32_t elapsed = sensorsMillis() - start;
+  CHECK(elapsed >= timeout);
+  CHECK(elapsed <= timeout + SENSOR_POLL_INTERVAL);
+  CHECK(scd.transactions < 2*(timeout/SENSOR_POLL_INTERVAL + 5) + 20);
+  // longer timeout is kept
+  start = sensorsMillis();
+  CHECK_EQ(Sensor::readAll(sensors, 1, 5000), 0);
+  CHECK(sensorsMillis() - start >= 5000);
+}
+
+static uint32_t wrapOffset = 0;
+
+static uint32_t wrappingClock() {
+  return millis() + wrapOffset;
+}
+
+TEST(clockWrapAround) {
+  BME280Model bme;
+  Wire.attach(bme);
+  BME280Sensor s(0);
+  CHECK(s.begin());
+  // sensors clock wraps during the cycle
+  wrapOffset = 0xFFFFFFFF - millis() - 3;
+  setSensorsClock(wrappingClock);
+  Sensor *sensors[] = { &s };
+  uint64_t start = sim::now();
+  CHECK_EQ(Sensor::readAll(sensors, 1), 1);
+  CHECK(sim::now() - start < 30000);
+  setSensorsClock(nullptr);
+}
+
+TEST(staticSetPolling) {
+  SCD30Model scd;
+  SHT4xModel sht;
+  Wire.attach(scd);
+  Wire.attach(sht);
+  StaticSensorSet<SCD30Sensor, SHT4XSensor> set;
+  CHECK_EQ(set.initAll(), 2);
+  sim::advance(2000000);
+  CHECK_EQ(set.readAll(3000), 2);
+  uint32_t before = scd.transactions;
+  uint64_t start = sim::now();
+  CHECK_EQ(set.readAll(3000), 2);
+  CHECK(sim::now() - start >= 1900000);
+  CHECK((scd.transactions - before)/2 <= 2000/SENSOR_POLL_INTERVAL + 5);
+}
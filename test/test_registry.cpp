@@ -0,0 +1,123 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+#include <SensorRegistry.h>
+
+// Providers of a capability in priority order, failover to the next provider with a valid reading and invalid capability masks
+
+TEST(priorityOrder) {
+  BME280Model bme;
+  SHT4xModel sht;
+  SCD30Model scd;
+  Wire.attach(bme);
+  Wire.attach(sht);
+  Wire.attach(scd);
+  BME280Sensor s1(0);
+  SHT4XSensor s2;
+  SCD30Sensor s3;
+  SensorRegistry registry;
+  CHECK(registry.add(&s1));
+  CHECK(registry.add(&s2, 10));
+  CHECK(registry.add(&s3));
+  CHECK_EQ(registry.getProvidersCount(CapTemperature), 3);
+  CHECK_EQ(registry.getProvidersCount(CapPressure), 1);
+  CHECK_EQ(registry.getProvidersCount(CapCo2), 1);
+  // higher priority first, equal priorities in order of adding
+  CHECK(registry.getProvider(CapTemperature, 0) == &s2);
+  CHECK(registry.getProvider(CapTemperature, 1) == &s1);
+  CHECK(registry.getProvider(CapTemperature, 2) == &s3);
+  CHECK(registry.getProvider(CapTemperature, 3) == nullptr);
+  CHECK(registry.getProvider(CapLightIntensity) == nullptr);
+  // priority changed for humidity only
+  CHECK(registry.setPriority(&s3, CapHumidity, 20));
+  CHECK(registry.getProvider(CapHumidity) == &s3);
+  CHECK(registry.getProvider(CapTemperature) == &s2);
+  CHECK(!registry.setPriority(&s3, CapPressure, 1));
+  // adding again doesn't duplicate
+  CHECK(registry.add(&s1));
+  CHECK_EQ(registry.getProvidersCount(CapTemperature), 3);
+}
+
+TEST(bestWithValidReading) {
+  BME280Model bme;
+  SHT4xModel sht;
+  bme.temperature = 20;
+  sht.temperature = 25;
+  Wire.attach(bme);
+  Wire.attach(sht);
+  BME280Sensor s1(0);
+  SHT4XSensor s2;
+  CHECK(s1.init());
+  CHECK(s2.init());
+  CHECK(s1.readValues());
+  CHECK(s2.readValues());
+  SensorRegistry registry;
+  registry.add(&s1);
+  registry.add(&s2, 5);
+  float value = 0;
+  CHECK(registry.getBest(CapTemperature) == &s2);
+  CHECK(registry.getValue(CapTemperature, value));
+  CHECK_NEAR(value, 25, 0.01);
+  // failed provider is skipped until it reads again
+  sht.connected = false;
+  CHECK(!s2.readValues());
+  CHECK(registry.getBest(CapTemperature) == &s1);
+  CHECK(registry.getValue(CapTemperature, value));
+  CHECK_NEAR(value, 20, 0.01);
+  CHECK(registry.getValue(CapPressure, value));
+  CHECK_NEAR(value, s1.pressSeaLevel, 0.01);
+  bme.connected = false;
+  CHECK(!s1.readValues());
+  CHECK(registry.getBest(CapTemperature) == nullptr);
+  CHECK(!registry.getValue(CapTemperature, value));
+  sht.connected = true;
+  CHECK(s2.readValues());
+  CHECK(registry.getBest(CapHumidity) == &s2);
+}
+
+TEST(removeAndLimit) {
+  SHT4XSensor sensors[SENSOR_REGISTRY_MAX_PROVIDERS + 1];
+  SensorRegistry registry;
+  for(uint8_t i=0;i<SENSOR_REGISTRY_MAX_PROVIDERS;i++) {
+    CHECK(registry.add(&sensors[i], i));
+  }
+  CHECK(!registry.add(&sensors[SENSOR_REGISTRY_MAX_PROVIDERS]));
+  CHECK(registry.getProvider(CapHumidity) == &sensors[SENSOR_REGISTRY_MAX_PROVIDERS - 1]);
+  registry.remove(&sensors[SENSOR_REGISTRY_MAX_PROVIDERS - 1]);
+  CHECK_EQ(registry.getProvidersCount(CapTemperature), SENSOR_REGISTRY_MAX_PROVIDERS - 1);
+  CHECK_EQ(registry.getProvidersCount(CapHumidity), SENSOR_REGISTRY_MAX_PROVIDERS - 1);
+  CHECK(registry.getProvider(CapHumidity) == &sensors[SENSOR_REGISTRY_MAX_PROVIDERS - 2]);
+  CHECK(registry.getProvider(CapHumidity, SENSOR_REGISTRY_MAX_PROVIDERS - 2) == &sensors[0]);
+  // removing an unknown sensor changes nothing
+  registry.remove(&sensors[SENSOR_REGISTRY_MAX_PROVIDERS]);
+  CHECK_EQ(registry.getProvidersCount(CapTemperature), SENSOR_REGISTRY_MAX_PROVIDERS - 1);
+  CHECK(registry.add(&sensors[SENSOR_REGISTRY_MAX_PROVIDERS]));
+  registry.clear();
+  CHECK_EQ(registry.getProvidersCount(CapTemperature), 0);
+  CHECK(registry.getBest(CapTemperature) == nullptr);
+}
+
+TEST(invalidMasks) {
+  SHT4xModel sht;
+  Wire.attach(sht);
+  SHT4XSensor s;
+  CHECK(s.init());
+  CHECK(s.readValues());
+  SensorRegistry registry;
+  CHECK(registry.add(&s));
+  CHECK_EQ(SensorRegistry::capabilityIndex(CapTemperature), 0);
+  CHECK_EQ(SensorRegistry::capabilityIndex(CapDustPPM), 7);
+  // no bit and several bits
+  const SensorCapability masks[] = { (SensorCapability)0, (SensorCapability)(CapTemperature | CapHumidity),
+    (SensorCapability)(CapCo2 | CapDustPPM) };
+  for(SensorCapability mask : masks) {
+    float value = 0;
+    CHECK_EQ(SensorRegistry::capabilityIndex(mask), SENSOR_CAPABILITIES_COUNT);
+    CHECK_EQ(registry.getProvidersCount(mask), 0);
+    CHECK(!registry.setPriority(&s, mask, 5));
+    CHECK(registry.getProvider(mask) == nullptr);
+    CHECK(registry.getBest(mask) == nullptr);
+    CHECK(!registry.getValue(mask, value));
+  }
+  CHECK(registry.getBest(CapHumidity) == &s);
+}
@@ -0,0 +1,154 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+
+// Resume after deep sleep: running devices are taken over without re-init, devices which lost state are restarted
+
+TEST(scd41KeptMeasuring) {
+  SCD41Model model;
+  Wire.attach(model);
+  SensorState state;
+  {
+    SCD41Sensor s;
+    CHECK(s.init());
+    CHECK(s.saveState(state));
+  }
+  sim::advance(60000000);
+  SCD41Sensor s;
+  uint64_t start = sim::now();
+  CHECK(s.resume(state));
+  // without the stop command and its 500 ms wait
+  CHECK(sim::now() - start < model.stopTime);
+  CHECK(model.getMode() == SCD41Model::Periodic);
+  CHECK(s.readValues());
+  CHECK_EQ(s.co2, 700);
+}
+
+TEST(scd41LostState) {
+  SCD41Model model;
+  Wire.attach(model);
+  SensorState state;
+  SCD41Sensor s1;
+  CHECK(s1.init());
+  CHECK(s1.saveState(state));
+  model.powerCycle();
+  SCD41Sensor s2;
+  CHECK(s2.resume(state));
+  CHECK(s2.getStatus());
+  CHECK(model.getMode() == SCD41Model::Periodic);
+  sim::advance(model.periodicInterval);
+  CHECK(s2.readValues());
+  // device which doesn't respond falls back to init, which fails
+  model.connected = false;
+  SCD41Sensor s3;
+  CHECK(!s3.resume(state));
+  CHECK(!s3.getStatus());
+}
+
+TEST(invalidStateDoesInit) {
+  SCD41Model model;
+  Wire.attach(model);
+  SensorState state;
+  SCD41Sensor s1;
+  CHECK(s1.init());
+  CHECK(s1.saveState(state));
+  state.crc ^= 0xFF;
+  SCD41Sensor s2;
+  uint64_t start = sim::now();
+  CHECK(s2.resume(state));
+  // full init stops measurement first
+  CHECK(sim::now() - start >= model.stopTime);
+  memset(&state, 0, sizeof(state));
+  CHECK(s2.resume(state));
+}
+
+TEST(sen54KeptMeasuring) {
+  SEN54Model model;
+  Wire.attach(model);
+  SensorState state;
+  {
+    SEN54Sensor s;
+    CHECK(s.init());
+    sim::advance(model.samplePeriod);
+    CHECK(s.readValues());
+    CHECK(s.saveState(state));
+    CHECK_EQ(state.length, 8);
+  }
+  model.vocState[0] = 0x1111;
+  SEN54Sensor s;
+  CHECK(s.resume(state));
+  CHECK(model.isMeasuring());
+  // algorithm state of the running device is kept
+  CHECK_EQ(model.vocState[0], 0x1111);
+  sim::advance(model.samplePeriod);
+  CHECK(s.readValues());
+}
+
+TEST(sen54LostState) {
+  SEN54Model model;
+  Wire.attach(model);
+  SensorState state;
+  SEN54Sensor s1;
+  CHECK(s1.init());
+  CHECK(s1.saveState(state));
+  uint16_t saved = model.vocState[0];
+  model.powerCycle();
+  model.vocState[0] = 0;
+  SEN54Sensor s2;
+  CHECK(s2.resume(state));
+  // measurement is restarted with the saved algorithm state
+  CHECK(model.isMeasuring());
+  CHECK_EQ(model.vocState[0], saved);
+  sim::advance(model.samplePeriod);
+  CHECK(s2.readValues());
+}
+
+TEST(sgp41SkipsConditioning) {
+  SGP41Model model;
+  Wire.attach(model);
+  SensorState state;
+  {
+    SGP41Sensor s;
+    CHECK(s.init());
+    // conditioning and initial blackout of gas indexes
+    for(uint8_t i=0;i<70;i++) {
+      CHECK(s.readValues());
+      sim::advance(1000000);
+    }
+    CHECK(s.readValues());
+    CHECK(s.vocIndex > 0);
+    CHECK(s.saveState(state));
+  }
+  uint32_t conditionings = model.conditionings;
+  uint64_t start = sim::now();
+  SGP41Sensor s;
+  CHECK(s.resume(state));
+  // no self test
+  CHECK(sim::now() - start < 320000);
+  CHECK(s.readValues());
+  CHECK_EQ(model.conditionings, conditionings);
+  CHECK_EQ(s.noxRaw, 16000);
+  // indexes from the first read
+  CHECK(s.vocIndex >= 90 && s.vocIndex <= 110);
+  CHECK(s.noxIndex > 0);
+}
+
+TEST(sgp41LostState) {
+  SGP41Model model;
+  Wire.attach(model);
+  SensorState state;
+  SGP41Sensor s1;
+  CHECK(s1.init());
+  // not conditioned yet, resume does full init and conditions again
+  CHECK(s1.saveState(state));
+  SGP41Sensor s2;
+  CHECK(s2.resume(state));
+  uint32_t conditionings = model.conditionings;
+  CHECK(s2.readValues());
+  CHECK_EQ(model.conditionings, conditionings + 1);
+  // device which doesn't respond
+  model.connected = false;
+  SGP41Sensor s3;
+  CHECK(!s3.resume(state));
+  CHECK(!s3.getStatus());
+}
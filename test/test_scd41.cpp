@@ -0,0 +1,83 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+
+// SCD41 in single shot and periodic profiles read by readAll() with the default timeout
+
+TEST(singleShotReadAll) {
+  SCD41Model model;
+  Wire.attach(model);
+  SCD41Sensor s;
+  CHECK(s.setProfile(ProfileSingleShot));
+  CHECK(s.begin());
+  CHECK(model.getMode() == SCD41Model::Idle);
+  Sensor *sensors[] = { &s };
+  uint64_t start = sim::now();
+  CHECK_EQ(Sensor::readAll(sensors, 1), 1);
+  // a single conversion, not polled by commands while the device is busy
+  CHECK_EQ(model.singleShots, 1u);
+  CHECK(sim::now() - start >= model.singleShotTime);
+  CHECK(sim::now() - start < model.singleShotTime + 100000);
+  CHECK_EQ(s.co2, 700);
+  CHECK_NEAR(s.temp, 22.5, 0.01);
+  model.co2 = 900;
+  CHECK_EQ(Sensor::readAll(sensors, 1), 1);
+  CHECK_EQ(model.singleShots, 2u);
+  CHECK_EQ(s.co2, 900);
+}
+
+TEST(singleShotWithFastSensor) {
+  SCD41Model scd;
+  BME280Model bme;
+  Wire.attach(scd);
+  Wire.attach(bme);
+  SCD41Sensor s1;
+  BME280Sensor s2(0);
+  CHECK(s1.setProfile(ProfileSingleShot));
+  CHECK(s1.begin());
+  CHECK(s2.begin());
+  Sensor *sensors[] = { &s1, &s2 };
+  uint32_t finishTimes[2];
+  uint32_t start = sensorsMillis();
+  CHECK_EQ(Sensor::readAll(sensors, 2, 2000, finishTimes), 2);
+  CHECK(finishTimes[1] - start < 100);
+  CHECK(finishTimes[0] - start > 5000);
+  CHECK_EQ(scd.singleShots, 1u);
+}
+
+TEST(singleShotBlockingRead) {
+  SCD41Model model;
+  Wire.attach(model);
+  SCD41Sensor s;
+  CHECK(s.setProfile(ProfileSingleShot));
+  CHECK(s.begin());
+  CHECK(s.read());
+  CHECK_EQ(model.singleShots, 1u);
+  CHECK_EQ(s.co2, 700);
+}
+
+TEST(singleShotDeviceLost) {
+  SCD41Model model;
+  Wire.attach(model);
+  SCD41Sensor s;
+  CHECK(s.setProfile(ProfileSingleShot));
+  CHECK(s.begin());
+  model.connected = false;
+  Sensor *sensors[] = { &s };
+  CHECK_EQ(Sensor::readAll(sensors, 1), 0);
+  CHECK_EQ(s.getErrorCode(), ErrorStart);
+}
+
+TEST(periodicWaitsForSample) {
+  SCD41Model model;
+  Wire.attach(model);
+  SCD41Sensor s;
+  CHECK(s.begin());
+  Sensor *sensors[] = { &s };
+  // sampling period is longer than the default timeout
+  CHECK_EQ(Sensor::readAll(sensors, 1), 1);
+  CHECK_EQ(s.co2, 700);
+  uint64_t start = sim::now();
+  CHECK_EQ(Sensor::readAll(sensors, 1), 1);
+  CHECK(sim::now() - start >= model.periodicInterval - 20000);
+}
@@ -0,0 +1,96 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+#include <SensorSet.h>
+#include <InfluxDbClient.h>
+
+// Batches of line protocol written by SensorSet: tags, timestamps, overflow of the batch buffer and flush
+
+static std::string line(SensorSet &set, uint8_t index, const char *fields) {
+  char buff[200];
+  snprintf(buff, sizeof(buff), "env,room=lab,sensor=%s %s %llu", set.getSensor(index)->getName().c_str(), fields,
+    (unsigned long long)set.getTimestamp(index));
+  return buff;
+}
+
+TEST(batchingAndFlush) {
+  SHT4xModel sht;
+  BME280Model bme;
+  Wire.attach(sht);
+  Wire.attach(bme);
+  SHT4XSensor s1;
+  BME280Sensor s2(0);
+  SensorSet set(2, "env", 512, 2);
+  CHECK(set.add(&s1));
+  CHECK(set.add(&s2));
+  CHECK(!set.add(&s1));
+  CHECK(set.addTag("room", "lab"));
+  CHECK_EQ(set.initAll(), 2);
+  CHECK_EQ(set.acquire(), 2);
+  CHECK_EQ(set.getCyclesCount(), 1);
+  CHECK(!set.isBatchFull());
+  // epoch time of the system clock
+  CHECK(set.getTimestamp(0) > 1577836800000ULL);
+  CHECK(set.getTimestamp(1) >= set.getTimestamp(0));
+  std::string first = line(set, 0, "temp=22.50,hum=45.00") + "\n" +
+    line(set, 1, "temp=22.50,hum=45.00,press=1013.25,press_raw=1013.25");
+  CHECK_EQ(std::string(set.getBatch()), first);
+  // failed sensor is left out
+  sht.connected = false;
+  CHECK_EQ(set.acquire(), 1);
+  CHECK_EQ(set.getCyclesCount(), 2);
+  CHECK(set.isBatchFull());
+  std::string batch = first + "\n" + line(set, 1, "temp=22.50,hum=45.00,press=1013.25,press_raw=1013.25");
+  CHECK_EQ(std::string(set.getBatch()), batch);
+  CHECK_EQ(set.getBatchLength(), batch.length());
+  // failed write keeps the batch
+  InfluxDBClient client;
+  client.fail = true;
+  CHECK(!set.flush(client));
+  CHECK_EQ(set.getCyclesCount(), 2);
+  client.fail = false;
+  CHECK(set.flush(client));
+  CHECK_EQ(client.records.size(), 1u);
+  CHECK_EQ(std::string(client.records[0].c_str()), batch);
+  CHECK_EQ(set.getBatchLength(), 0u);
+  CHECK_EQ(set.getCyclesCount(), 0);
+  // empty batch isn't written
+  CHECK(set.flush(client));
+  CHECK_EQ(client.records.size(), 1u);
+}
+
+TEST(overflowReported) {
+  SHT4xModel sht;
+  BME280Model bme;
+  Wire.attach(sht);
+  Wire.attach(bme);
+  SHT4XSensor s1;
+  BME280Sensor s2(0);
+  // fits a single cycle of both sensors
+  SensorSet set(2, "env", 200, 10);
+  set.add(&s1);
+  set.add(&s2);
+  set.addTag("room", "lab");
+  CHECK_EQ(set.initAll(), 2);
+  CHECK_EQ(set.acquire(), 2);
+  CHECK(!set.isOverflow());
+  std::string first(set.getBatch());
+  // lines of the next cycles are dropped and counted, cycles aren't
+  CHECK_EQ(set.acquire(), 2);
+  CHECK(set.isOverflow());
+  CHECK(set.isBatchFull());
+  CHECK_EQ(set.getDroppedLines(), 2u);
+  CHECK_EQ(set.acquire(), 2);
+  CHECK_EQ(set.getDroppedLines(), 4u);
+  CHECK_EQ(set.getCyclesCount(), 1);
+  CHECK_EQ(std::string(set.getBatch()), first);
+  InfluxDBClient client;
+  CHECK(set.flush(client));
+  CHECK_EQ(std::string(client.records[0].c_str()), first);
+  // cleared batch accepts lines again, dropped lines stay counted
+  CHECK(!set.isOverflow());
+  CHECK_EQ(set.acquire(), 2);
+  CHECK(!set.isOverflow());
+  CHECK_EQ(set.getCyclesCount(), 1);
+  CHECK_EQ(set.getDroppedLines(), 4u);
+}
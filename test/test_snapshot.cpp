@@ -0,0 +1,117 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+#include <atomic>
+#include <thread>
+
+// Snapshot of the last reading, its field limit and consistent copies while another thread reads the sensor
+
+static const char *const Keys[] = { "f0", "f1", "f2", "f3", "f4", "f5", "f6", "f7", "f8", "f9" };
+
+// Every field of a read has the same value, so a torn copy has different values
+class CounterSensor : public Sensor {
+  public:
+    uint8_t fields;
+    uint32_t value = 0;
+    CounterSensor(uint8_t fields):Sensor("counter"),fields(fields) {}
+    virtual bool init() override { status = true; return true; }
+    virtual bool readValues() override { value++; return true; }
+    virtual void writeFields(FieldSink &sink) override {
+      for(uint8_t i=0;i<fields;i++) {
+        sink.addField(Keys[i], (float)value);
+      }
+    }
+};
+
+TEST(lastSuccessfulRead) {
+  SHT4xModel sht;
+  Wire.attach(sht);
+  SHT4XSensor s;
+  SensorSnapshot snapshot;
+  CHECK(s.begin());
+  CHECK(!s.getSnapshot(snapshot));
+  sim::advance(5000000);
+  CHECK(s.read());
+  CHECK(s.getSnapshot(snapshot));
+  CHECK_EQ(snapshot.count, 2);
+  CHECK_EQ(snapshot.dropped, 0);
+  CHECK_EQ(snapshot.timestamp, sensorsMillis());
+  float value;
+  CHECK(snapshot.getValue(Temp, value));
+  CHECK_NEAR(value, 22.5, 0.01);
+  CHECK(snapshot.getValue("hum", value));
+  CHECK_NEAR(value, 45, 0.01);
+  CHECK(!snapshot.getValue(Co2, value));
+  // failed read keeps the last snapshot
+  uint32_t timestamp = snapshot.timestamp;
+  sim::advance(1000000);
+  sht.connected = false;
+  CHECK(!s.read());
+  CHECK(s.getSnapshot(snapshot));
+  CHECK_EQ(snapshot.timestamp, timestamp);
+  // direct readValues() doesn't publish
+  sht.connected = true;
+  sht.temperature = 30;
+  CHECK(s.readValues());
+  CHECK(s.getSnapshot(snapshot));
+  CHECK(snapshot.getValue(Temp, value));
+  CHECK_NEAR(value, 22.5, 0.01);
+}
+
+TEST(fieldsOverLimitCounted) {
+  CounterSensor s(SENSOR_SNAPSHOT_FIELDS + 2);
+  SensorSnapshot snapshot;
+  CHECK(s.begin());
+  CHECK(!s.getSnapshot(snapshot));
+  CHECK(s.read());
+  CHECK(s.getSnapshot(snapshot));
+  CHECK_EQ(snapshot.count, SENSOR_SNAPSHOT_FIELDS);
+  CHECK_EQ(snapshot.dropped, 2);
+  float value;
+  CHECK(snapshot.getValue("f0", value));
+  CHECK(!snapshot.getValue(Keys[SENSOR_SNAPSHOT_FIELDS], value));
+}
+
+TEST(concurrentReadersSeeNoTornCopies) {
+  CounterSensor s(SENSOR_SNAPSHOT_FIELDS);
+  CHECK(s.begin());
+  const uint32_t reads = 200000;
+  std::atomic<bool> done(false);
+  std::atomic<uint32_t> torn(0), copies(0), backwards(0);
+  auto reader = [&]() {
+    float last = 0;
+    SensorSnapshot snapshot;
+    while(!done.load()) {
+      if(!s.getSnapshot(snapshot)) {
+        continue;
+      }
+      copies++;
+      bool ok = snapshot.count == SENSOR_SNAPSHOT_FIELDS && !snapshot.dropped;
+      for(uint8_t i=0;ok && i<snapshot.count;i++) {
+        ok = snapshot.values[i] == snapshot.values[0] && snapshot.keys[i] == Keys[i];
+      }
+      if(!ok) {
+        torn++;
+      }
+      if(snapshot.values[0] < last) {
+        backwards++;
+      }
+      last = snapshot.values[0];
+    }
+  };
+  std::thread readers[] = { std::thread(reader), std::thread(reader) };
+  for(uint32_t i=0;i<reads;i++) {
+    s.read();
+  }
+  done = true;
+  for(std::thread &t : readers) {
+    t.join();
+  }
+  CHECK_EQ(torn.load(), 0u);
+  CHECK_EQ(backwards.load(), 0u);
+  CHECK(copies.load() > 0);
+  SensorSnapshot snapshot;
+  CHECK(s.getSnapshot(snapshot));
+  CHECK_EQ(snapshot.values[0], (float)reads);
+  printf("  %u consistent copies during %u reads\n", copies.load(), reads);
+}
@@ -0,0 +1,88 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+#include <StaticSensorSet.h>
+#include <InfluxDbClient.h>
+
+// Compile-time sensor set: overlapped reads, gas compensation and aggregated access
+
+struct TestBME280 : BME280Sensor {
+  TestBME280():BME280Sensor(0) {}
+};
+
+// Starts at a millisecond tick, so the SHT4X wait is at least its conversion time
+static void alignToMs() {
+  sim::advance(1000 - sim::now() % 1000);
+}
+
+TEST(readAllCompensatesGas) {
+  BME280Model bme;
+  SHT4xModel sht;
+  SGP40Model sgp;
+  Wire.attach(bme);
+  Wire.attach(sht);
+  Wire.attach(sgp);
+  sht.temperature = 30;
+  sht.humidity = 60;
+  StaticSensorSet<SGP40Sensor, SHT4XSensor, TestBME280> set;
+  CHECK_EQ(set.Count, 3);
+  CHECK_EQ(set.initAll(), 3);
+  alignToMs();
+  CHECK_EQ(set.readAll(), 3);
+  // SGP40 is compensated by SHT4X, the first temperature and humidity sensor
+  CHECK_NEAR(sgp.lastHumTicks, 60 * 65535 / 100.0, 2);
+  CHECK_NEAR(sgp.lastTempTicks, (30 + 45) * 65535 / 175.0, 2);
+  CHECK_NEAR(set.get<1>().temp, 30, 0.01);
+  CHECK_NEAR(set.get<2>().temp, 22.5, 0.01);
+  CHECK_EQ(set.get<0>().vocRaw, 30000);
+
+  CHECK_EQ(set.getCapabilities(), CapTemperature|CapHumidity|CapPressure|CapVoc);
+  float value;
+  CHECK(set.getValue(CapTemperature, value));
+  CHECK_NEAR(value, 30, 0.01);
+  CHECK(!set.getValue(CapCo2, value));
+
+  Point p("env");
+  set.storeValues(p);
+  String line = p.toLineProtocol();
+  CHECK(strstr(line.c_str(), "temp=30.00"));
+  CHECK(strstr(line.c_str(), "temp=22.50"));
+  CHECK(strstr(line.c_str(), "gas_resistance=30000.00"));
+}
+
+TEST(overlappedConversions) {
+  BME280Model bme;
+  SHT4xModel sht;
+  Wire.attach(bme);
+  Wire.attach(sht);
+  StaticSensorSet<SHT4XSensor, TestBME280> set;
+  CHECK_EQ(set.initAll(), 2);
+  alignToMs();
+  uint64_t start = sim::now();
+  CHECK_EQ(set.readAll(), 2);
+  uint64_t elapsed = sim::now() - start;
+  // conversions run in parallel, the cycle takes the longest of them
+  uint64_t longest = bme.getConversionTime() > sht.highPrecisionTime ? bme.getConversionTime() : sht.highPrecisionTime;
+  CHECK(elapsed >= longest);
+  CHECK(elapsed < longest + 5000);
+}
+
+TEST(failedSensorLeftOut) {
+  BME280Model bme;
+  SHT4xModel sht;
+  Wire.attach(bme);
+  Wire.attach(sht);
+  StaticSensorSet<SHT4XSensor, TestBME280> set;
+  CHECK_EQ(set.initAll(), 2);
+  alignToMs();
+  bme.connected = false;
+  CHECK_EQ(set.readAll(), 1);
+  CHECK(!set.get<1>().getStatus());
+  float value;
+  CHECK(set.getValue(CapTemperature, value));
+  CHECK_NEAR(value, 22.5, 0.01);
+  CHECK(!set.getValue(CapPressure, value));
+  Point p("env");
+  set.storeValues(p);
+  CHECK(!strstr(p.toLineProtocol().c_str(), "press="));
+}
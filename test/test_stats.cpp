@@ -0,0 +1,166 @@
+#include "TestUtil.h"
+#include "Devices.h"
+#include <Sensors.h>
+#include <InfluxDbClient.h>
+
+// Latency histograms, init and resume, read and error counters and bus traffic of sensors
+
+static String stats(Sensor &s) {
+  Point p("stats");
+  s.storeStats(p);
+  return p.toLineProtocol();
+}
+
+TEST(histogramBuckets) {
+  LatencyHistogram h;
+  memset(&h, 0, sizeof(h));
+  CHECK_EQ(h.quantile(0.5), 0u);
+  CHECK_EQ(h.mean(), 0u);
+  uint32_t latencies[] = { 0, 1, 3, 1000, 1023, 1024, 100000000 };
+  for(uint32_t us : latencies) {
+    h.add(us);
+  }
+  CHECK_EQ(h.count, 7u);
+  CHECK_EQ(h.max, 100000000u);
+  CHECK_EQ(h.buckets[0], 1);
+  CHECK_EQ(h.buckets[1], 1);
+  CHECK_EQ(h.buckets[2], 1);
+  CHECK_EQ(h.buckets[10], 2);
+  CHECK_EQ(h.buckets[11], 1);
+  // longer latencies fall into the last bucket
+  CHECK_EQ(h.buckets[SENSOR_STATS_BUCKETS - 1], 1);
+  // upper bound of the bucket of the median
+  CHECK_EQ(h.quantile(0.5), 1023u);
+}
+
+TEST(readCounters) {
+  SHT4xModel sht;
+  Wire.attach(sht);
+  SHT4XSensor s;
+  CHECK(s.begin());
+  CHECK_EQ(s.getStats().init.count, 1u);
+  CHECK(s.read());
+  CHECK(s.read());
+  sht.connected = false;
+  CHECK(!s.read());
+  const SensorStats &st = s.getStats();
+  CHECK_EQ(st.readOk, 2u);
+  CHECK_EQ(st.readFailed, 1u);
+  CHECK_EQ(st.read.count, 2u);
+  CHECK(st.read.max >= sht.highPrecisionTime);
+  CHECK_EQ(st.errors[s.getErrorCode()], 1);
+  String line = stats(s);
+  CHECK(strstr(line.c_str(), "read_ok=2i,read_failed=1i"));
+  CHECK(strstr(line.c_str(), "init_count=1i"));
+  CHECK(strstr(line.c_str(), "err_read=1i"));
+  s.resetStats();
+  CHECK_EQ(s.getStats().readFailed, 0u);
+}
+
+TEST(directCallsNotCounted) {
+  SHT4xModel sht;
+  Wire.attach(sht);
+  SHT4XSensor s;
+  CHECK(s.init());
+  CHECK(s.readValues());
+  CHECK_EQ(s.getStats().init.count, 0u);
+  CHECK_EQ(s.getStats().readOk, 0u);
+  CHECK_EQ(s.getStats().read.count, 0u);
+}
+
+TEST(resumeRecordedAsInit) {
+  SCD41Model model;
+  Wire.attach(model);
+  SensorState state;
+  {
+    SCD41Sensor s;
+    CHECK(s.begin());
+    CHECK(s.saveState(state));
+    CHECK_EQ(s.getStats().init.count, 1u);
+  }
+  // after deep sleep the device keeps measuring
+  sim::advance(60000000);
+  SCD41Sensor s;
+  CHECK(s.resume(state));
+  CHECK(s.getStatus());
+  CHECK_EQ(s.getStats().init.count, 1u);
+  CHECK(s.getStats().init.max > 0);
+  CHECK(strstr(stats(s).c_str(), "init_count=1i"));
+  CHECK(s.read());
+  CHECK_EQ(s.getStats().readOk, 1u);
+}
+
+TEST(failedResumeRecordedOnce) {
+  SCD41Model model;
+  Wire.attach(model);
+  SensorState state;
+  SCD41Sensor s1;
+  CHECK(s1.begin());
+  CHECK(s1.saveState(state));
+  state.crc ^= 0xFF;
+  SCD41Sensor s2;
+  // invalid state falls back to a full init
+  CHECK(s2.resume(state));
+  CHECK_EQ(s2.getStats().init.count, 1u);
+  // device which lost the state and doesn't respond
+  state.crc ^= 0xFF;
+  model.connected = false;
+  SCD41Sensor s3;
+  CHECK(!s3.resume(state));
+  CHECK_EQ(s3.getStats().init.count, 1u);
+  CHECK_EQ(s3.getHealth(), HealthQuarantined);
+}
+
+TEST(readAllLatencyAndTimeout) {
+  SHT4xModel sht;
+  BME280Model bme;
+  Wire.attach(sht);
+  Wire.attach(bme);
+  SHT4XSensor s1;
+  BME280Sensor s2(0);
+  CHECK(s1.begin());
+  CHECK(s2.begin());
+  Sensor *sensors[] = { &s1, &s2 };
+  // start at a millisecond tick, so the SHT4X wait is at least its conversion time
+  sim::advance(1000 - sim::now() % 1000);
+  CHECK_EQ(Sensor::readAll(sensors, 2), 2);
+  // latency is from the start of measurement until values are fetched
+  CHECK(s1.getStats().read.max >= sht.highPrecisionTime);
+  CHECK(s1.getStats().read.max < sht.highPrecisionTime + 3000);
+  CHECK(s2.getStats().read.max >= bme.getConversionTime());
+  // sensor without data until long after its sampling period
+  SCD30Model scd;
+  Wire.attach(scd);
+  SCD30Sensor s3;
+  CHECK(s3.begin());
+  scd.interval = 60;
+  Sensor *slow[] = { &s3 };
+  CHECK_EQ(Sensor::readAll(slow, 1, 5), 0);
+  CHECK_EQ(s3.getErrorCode(), ErrorTimeout);
+  CHECK_EQ(s3.getStats().errors[ErrorTimeout], 1);
+  CHECK_EQ(s3.getStats().readFailed, 1u);
+  CHECK(strstr(stats(s3).c_str(), "err_timeout=1i"));
+}
+
+TEST(busTraffic) {
+  SHT4xModel sht;
+  Wire.attach(sht);
+  SHT4XSensor s;
+  CHECK(s.begin());
+  Wire.resetCounters();
+  sim::advance(1000 - sim::now() % 1000);
+  Sensor *sensors[] = { &s };
+  CHECK_EQ(Sensor::readAll(sensors, 1), 1);
+  // two phase read of SHT4X does its I2C itself
+  CHECK_EQ(s.getStats().busTransactions, Wire.getTransactions());
+  CHECK(s.getStats().busBytes > 0);
+  CHECK(strstr(stats(s).c_str(), "bus_transactions="));
+  // traffic of third party libraries isn't counted
+  BME280Model bme;
+  Wire.attach(bme);
+  BME280Sensor b(0);
+  CHECK(b.begin());
+  CHECK(b.read());
+  CHECK_EQ(b.getStats().busTransactions, 0u);
+  CHECK(!strstr(stats(b).c_str(), "bus_transactions="));
+}
@@ -0,0 +1,68 @@
+#include "TestUtil.h"
+#include <TimeSeries.h>
+
+// Round trip of compressed series, blocks larger than 8kB and encoding/decoding speed
+
+static bool roundTrip(CompressedSeries &series, uint32_t firstTimestamp, uint32_t count, std::function<float(uint32_t)> value) {
+  auto it = series.iterator();
+  uint32_t t;
+  float v;
+  for(uint32_t i=0;i<count;i++) {
+    if(!it.next(t, v) || t != firstTimestamp + i*10 || v != value(i)) {
+      return false;
+    }
+  }
+  return !it.next(t, v);
+}
+
+TEST(roundTripAcrossBlocks) {
+  CompressedSeries series(256, 4);
+  auto value = [](uint32_t i) { return 20 + (i % 17)*0.25f; };
+  // fill more than all blocks, the oldest are dropped
+  for(uint32_t i=0;i<2000;i++) {
+    CHECK(series.append(1000 + i*10, value(i)));
+  }
+  uint32_t count = series.getCount();
+  CHECK(count < 2000);
+  uint32_t first = 2000 - count;
+  CHECK(roundTrip(series, 1000 + first*10, count, [&](uint32_t i) { return value(first + i); }));
+  CHECK(!series.append(5, 0));
+}
+
+TEST(largeBlock) {
+  // 64k bits and more in a single block must not wrap the bit position
+  CompressedSeries series(12000, 1);
+  auto value = [](uint32_t i) { return (float)(i*7919 % 1000) / 3; };
+  uint32_t n = 0;
+  while(series.getUsedBytes() < 9000 && n < 100000) {
+    CHECK(series.append(n*10, value(n)));
+    n++;
+  }
+  CHECK(series.getUsedBytes() > 8192);
+  CHECK_EQ(series.getCount(), n);
+  CHECK(roundTrip(series, 0, n, value));
+}
+
+TEST(benchmark) {
+  const uint32_t samples = 200000;
+  CompressedSeries series(4096, 64);
+  auto value = [](uint32_t i) { return 21.5f + (i % 50)*0.01f; };
+  double appendUs = measureUs([&]() {
+    for(uint32_t i=0;i<samples;i++) {
+      series.append(i*60, value(i));
+    }
+  });
+  uint32_t stored = series.getCount();
+  uint32_t decoded = 0;
+  double decodeUs = measureUs([&]() {
+    auto it = series.iterator();
+    uint32_t t;
+    float v;
+    while(it.next(t, v)) {
+      decoded++;
+    }
+  });
+  CHECK_EQ(decoded, stored);
+  printf("  append %.3f us/sample, decode %.3f us/sample, %u samples in %u bytes, ratio %.1f\n",
+    appendUs/samples, decodeUs/decoded, stored, series.getUsedBytes(), series.getCompressionRatio());
+}